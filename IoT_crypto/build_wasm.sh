@@ -0,0 +1,59 @@
+#!/bin/sh
+# wasm_matter_tunnel.cpp 빌드 (emcc 필요)
+#
+#   ./build_wasm.sh [출력 디렉터리]
+#
+# 아래 변형들을 만들며, js/loader.mjs가 실행 환경에 맞는 것을 고른다.
+#   matter_tunnel.mjs          기본 (스칼라, 단일 스레드)
+#   matter_tunnel.simd.mjs     -msimd128 (16진수 변환 SIMD 경로, 해시/JSON 자동 벡터화)
+#   matter_tunnel.simd-mt.mjs  -msimd128 + pthreads (verifyBatch/extractTXDataBatch를 워커 풀에서 병렬 처리)
+#                              SharedArrayBuffer가 필요하므로 페이지는 cross-origin isolated여야 함
+#                              (Cross-Origin-Opener-Policy: same-origin, Cross-Origin-Embedder-Policy: require-corp)
+#
+# 각 변형은 소형 백엔드(-DMATTER_TUNNEL_COMPACT_CRYPTO, crypto_backend.cpp)로도 빌드한다.
+#   matter_tunnel.compact{,.simd,.simd-mt}.mjs  OpenSSL 없이 -Oz, 모바일 콜드 스타트용
+# 크기/인스턴스화 시간 비교: node js/bench_instantiate.mjs dist
+#
+# OpenSSL은 emscripten으로 빌드한 것을 사용한다.
+#   OPENSSL_WASM_DIR     단일 스레드 빌드 (include/, lib/libcrypto.a)
+#   OPENSSL_WASM_MT_DIR  -pthread로 빌드한 것 (기본값: OPENSSL_WASM_DIR)
+set -e
+
+cd "$(dirname "$0")"
+OUT="${1:-dist}"
+OPENSSL_WASM_DIR="${OPENSSL_WASM_DIR:-/opt/openssl-wasm}"
+OPENSSL_WASM_MT_DIR="${OPENSSL_WASM_MT_DIR:-$OPENSSL_WASM_DIR}"
+
+mkdir -p "$OUT"
+
+COMMON="-std=c++17 -O3 -lembind -sMODULARIZE -sEXPORT_ES6 -sALLOW_MEMORY_GROWTH
+        -sEXPORTED_RUNTIME_METHODS=HEAPU8"
+
+# 1. 기본
+emcc wasm_matter_tunnel.cpp $COMMON \
+    -I"$OPENSSL_WASM_DIR/include" "$OPENSSL_WASM_DIR/lib/libcrypto.a" \
+    -o "$OUT/matter_tunnel.mjs"
+
+# 2. SIMD
+emcc wasm_matter_tunnel.cpp $COMMON -msimd128 \
+    -I"$OPENSSL_WASM_DIR/include" "$OPENSSL_WASM_DIR/lib/libcrypto.a" \
+    -o "$OUT/matter_tunnel.simd.mjs"
+
+# 3. SIMD + pthreads
+#    워커는 모듈 로드 시 미리 만들어 두어 배치 호출 중 생성 지연이 없도록 함
+emcc wasm_matter_tunnel.cpp $COMMON -msimd128 -pthread \
+    -sPTHREAD_POOL_SIZE=navigator.hardwareConcurrency \
+    -I"$OPENSSL_WASM_MT_DIR/include" "$OPENSSL_WASM_MT_DIR/lib/libcrypto.a" \
+    -o "$OUT/matter_tunnel.simd-mt.mjs"
+
+# 4. 소형 백엔드 (libcrypto 링크 없음)
+COMPACT="-DMATTER_TUNNEL_COMPACT_CRYPTO -Oz"
+emcc wasm_matter_tunnel.cpp $COMMON $COMPACT \
+    -o "$OUT/matter_tunnel.compact.mjs"
+emcc wasm_matter_tunnel.cpp $COMMON $COMPACT -msimd128 \
+    -o "$OUT/matter_tunnel.compact.simd.mjs"
+emcc wasm_matter_tunnel.cpp $COMMON $COMPACT -msimd128 -pthread \
+    -sPTHREAD_POOL_SIZE=navigator.hardwareConcurrency \
+    -o "$OUT/matter_tunnel.compact.simd-mt.mjs"
+
+echo "built: $OUT/matter_tunnel{,.compact}{,.simd,.simd-mt}.mjs"
@@ -0,0 +1,1358 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+// 소형 백엔드 (MATTER_TUNNEL_COMPACT_CRYPTO)
+// OpenSSL 없이 P-256(ECDSA/ECDH), SHA-256, AES-256(CBC/CTR/GCM)만 구현해
+// 브라우저/모바일용 WASM 모듈 크기와 컴파일/인스턴스화 시간을 줄인다.
+// - 스칼라 곱은 4비트 고정 윈도 + 상수 시간 테이블 선택, 점 연산은 완전(complete) 덧셈 공식
+// - 필드/스칼라 연산은 32비트 limb 몽고메리 곱 (WASM에서 i64 곱 하나로 처리)
+// - AES는 S-box 바이트 구현이므로 테이블 조회 타이밍에 민감한 환경에서는 OpenSSL 백엔드를 사용할 것
+// 인터페이스는 OpenSSLCrypto와 같다 (crypto_backend.cpp).
+class CompactCrypto
+{
+private:
+    // ---- SHA-256 ----
+    struct Sha256
+    {
+        uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        unsigned char block[64];
+        size_t used = 0;
+        uint64_t total = 0;
+
+        void update(const unsigned char *data, size_t len)
+        {
+            total += len;
+            while (len > 0)
+            {
+                size_t n = 64 - used < len ? 64 - used : len;
+                std::memcpy(block + used, data, n);
+                used += n;
+                data += n;
+                len -= n;
+                if (used == 64)
+                {
+                    compress(block);
+                    used = 0;
+                }
+            }
+        }
+
+        void finish(unsigned char out[32])
+        {
+            uint64_t bits = total * 8;
+            block[used++] = 0x80;
+            if (used > 56)
+            {
+                std::memset(block + used, 0, 64 - used);
+                compress(block);
+                used = 0;
+            }
+            std::memset(block + used, 0, 56 - used);
+            storeBE64(block + 56, bits);
+            compress(block);
+
+            for (int i = 0; i < 8; i++)
+            {
+                storeBE32(out + i * 4, h[i]);
+            }
+            cleanse(this, sizeof(*this));
+        }
+
+        void compress(const unsigned char *p)
+        {
+            static const uint32_t K[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+            uint32_t w[64];
+            for (int i = 0; i < 16; i++)
+            {
+                w[i] = loadBE32(p + i * 4);
+            }
+            for (int i = 16; i < 64; i++)
+            {
+                uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+            for (int i = 0; i < 64; i++)
+            {
+                uint32_t t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+                uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                hh = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            h[0] += a;
+            h[1] += b;
+            h[2] += c;
+            h[3] += d;
+            h[4] += e;
+            h[5] += f;
+            h[6] += g;
+            h[7] += hh;
+        }
+
+        static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+    };
+
+    // ---- AES-256 ----
+    struct Aes256
+    {
+        unsigned char rk[240];
+
+        Aes256() = default;
+        explicit Aes256(const unsigned char key[32]) { setKey(key); }
+        ~Aes256() { cleanse(rk, sizeof(rk)); }
+
+        void setKey(const unsigned char key[32])
+        {
+            const unsigned char *sbox = tables().sbox;
+            std::memcpy(rk, key, 32);
+            unsigned char rcon = 1;
+            for (int i = 8; i < 60; i++)
+            {
+                unsigned char t[4];
+                std::memcpy(t, rk + (i - 1) * 4, 4);
+                if (i % 8 == 0)
+                {
+                    unsigned char first = t[0];
+                    t[0] = sbox[t[1]] ^ rcon;
+                    t[1] = sbox[t[2]];
+                    t[2] = sbox[t[3]];
+                    t[3] = sbox[first];
+                    rcon = xtime(rcon);
+                }
+                else if (i % 8 == 4)
+                {
+                    for (int j = 0; j < 4; j++)
+                    {
+                        t[j] = sbox[t[j]];
+                    }
+                }
+                for (int j = 0; j < 4; j++)
+                {
+                    rk[i * 4 + j] = rk[(i - 8) * 4 + j] ^ t[j];
+                }
+            }
+        }
+
+        void encryptBlock(const unsigned char in[16], unsigned char out[16]) const
+        {
+            const unsigned char *sbox = tables().sbox;
+            unsigned char s[16];
+            for (int i = 0; i < 16; i++)
+            {
+                s[i] = in[i] ^ rk[i];
+            }
+
+            for (int round = 1; round <= 14; round++)
+            {
+                // SubBytes + ShiftRows
+                unsigned char t[16];
+                for (int c = 0; c < 4; c++)
+                {
+                    for (int r = 0; r < 4; r++)
+                    {
+                        t[c * 4 + r] = sbox[s[((c + r) % 4) * 4 + r]];
+                    }
+                }
+
+                // MixColumns (마지막 라운드 제외) + AddRoundKey
+                for (int c = 0; c < 4; c++)
+                {
+                    unsigned char *col = t + c * 4;
+                    if (round != 14)
+                    {
+                        unsigned char a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                        unsigned char all = a0 ^ a1 ^ a2 ^ a3;
+                        col[0] ^= all ^ xtime(a0 ^ a1);
+                        col[1] ^= all ^ xtime(a1 ^ a2);
+                        col[2] ^= all ^ xtime(a2 ^ a3);
+                        col[3] ^= all ^ xtime(a3 ^ a0);
+                    }
+                    for (int r = 0; r < 4; r++)
+                    {
+                        s[c * 4 + r] = col[r] ^ rk[round * 16 + c * 4 + r];
+                    }
+                }
+            }
+            std::memcpy(out, s, 16);
+        }
+
+        void decryptBlock(const unsigned char in[16], unsigned char out[16]) const
+        {
+            const unsigned char *inv = tables().invSbox;
+            unsigned char s[16];
+            for (int i = 0; i < 16; i++)
+            {
+                s[i] = in[i] ^ rk[14 * 16 + i];
+            }
+
+            for (int round = 13; round >= 0; round--)
+            {
+                // InvShiftRows + InvSubBytes + AddRoundKey
+                unsigned char t[16];
+                for (int c = 0; c < 4; c++)
+                {
+                    for (int r = 0; r < 4; r++)
+                    {
+                        t[((c + r) % 4) * 4 + r] = inv[s[c * 4 + r]];
+                    }
+                }
+                for (int i = 0; i < 16; i++)
+                {
+                    t[i] ^= rk[round * 16 + i];
+                }
+
+                // InvMixColumns (마지막 라운드 제외)
+                for (int c = 0; c < 4; c++)
+                {
+                    unsigned char *col = t + c * 4;
+                    if (round != 0)
+                    {
+                        unsigned char a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                        s[c * 4 + 0] = gmul(a0, 14) ^ gmul(a1, 11) ^ gmul(a2, 13) ^ gmul(a3, 9);
+                        s[c * 4 + 1] = gmul(a0, 9) ^ gmul(a1, 14) ^ gmul(a2, 11) ^ gmul(a3, 13);
+                        s[c * 4 + 2] = gmul(a0, 13) ^ gmul(a1, 9) ^ gmul(a2, 14) ^ gmul(a3, 11);
+                        s[c * 4 + 3] = gmul(a0, 11) ^ gmul(a1, 13) ^ gmul(a2, 9) ^ gmul(a3, 14);
+                    }
+                    else
+                    {
+                        std::memcpy(s + c * 4, col, 4);
+                    }
+                }
+            }
+            std::memcpy(out, s, 16);
+        }
+
+        struct Tables
+        {
+            unsigned char sbox[256];
+            unsigned char invSbox[256];
+        };
+
+        // S-box는 코드 크기를 줄이기 위해 GF(2^8) 역원으로부터 생성
+        static const Tables &tables()
+        {
+            static const Tables t = []() {
+                Tables result;
+                unsigned char p = 1, q = 1;
+                do
+                {
+                    // p *= 3, q /= 3
+                    p = static_cast<unsigned char>(p ^ (p << 1) ^ ((p & 0x80) ? 0x1B : 0));
+                    q ^= static_cast<unsigned char>(q << 1);
+                    q ^= static_cast<unsigned char>(q << 2);
+                    q ^= static_cast<unsigned char>(q << 4);
+                    if (q & 0x80)
+                    {
+                        q ^= 0x09;
+                    }
+                    unsigned char x = static_cast<unsigned char>(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^ rotl8(q, 3) ^ rotl8(q, 4));
+                    result.sbox[p] = x ^ 0x63;
+                } while (p != 1);
+                result.sbox[0] = 0x63;
+
+                for (int i = 0; i < 256; i++)
+                {
+                    result.invSbox[result.sbox[i]] = static_cast<unsigned char>(i);
+                }
+                return result;
+            }();
+            return t;
+        }
+
+        static unsigned char rotl8(unsigned char x, int n)
+        {
+            return static_cast<unsigned char>((x << n) | (x >> (8 - n)));
+        }
+
+        static unsigned char xtime(unsigned char x)
+        {
+            return static_cast<unsigned char>((x << 1) ^ (0x1B & -(x >> 7)));
+        }
+
+        static unsigned char gmul(unsigned char a, unsigned char b)
+        {
+            unsigned char r = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                r ^= a & -(b & 1);
+                a = xtime(a);
+                b >>= 1;
+            }
+            return r;
+        }
+    };
+
+    // ---- GHASH ----
+    struct Ghash
+    {
+        unsigned char state[16] = {0};
+        uint64_t hHi, hLo;
+        unsigned char partial[16];
+        size_t partialLen = 0;
+
+        explicit Ghash(const unsigned char h[16])
+            : hHi(loadBE64(h)), hLo(loadBE64(h + 8))
+        {
+        }
+
+        void update(const unsigned char *data, size_t len)
+        {
+            while (len > 0)
+            {
+                size_t n = 16 - partialLen < len ? 16 - partialLen : len;
+                std::memcpy(partial + partialLen, data, n);
+                partialLen += n;
+                data += n;
+                len -= n;
+                if (partialLen == 16)
+                {
+                    absorb();
+                }
+            }
+        }
+
+        // 남은 부분 블록을 0으로 채워 처리
+        void pad()
+        {
+            if (partialLen > 0)
+            {
+                std::memset(partial + partialLen, 0, 16 - partialLen);
+                absorb();
+            }
+        }
+
+        // state = (state ^ block) * H, GF(2^128) 비트 반전 표현
+        void absorb()
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                state[i] ^= partial[i];
+            }
+            partialLen = 0;
+
+            uint64_t xHi = loadBE64(state), xLo = loadBE64(state + 8);
+            uint64_t zHi = 0, zLo = 0, vHi = hHi, vLo = hLo;
+            for (int i = 0; i < 128; i++)
+            {
+                uint64_t bit = i < 64 ? (xHi >> (63 - i)) & 1 : (xLo >> (127 - i)) & 1;
+                uint64_t mask = 0 - bit;
+                zHi ^= vHi & mask;
+                zLo ^= vLo & mask;
+
+                uint64_t carry = 0 - (vLo & 1);
+                vLo = (vLo >> 1) | (vHi << 63);
+                vHi = (vHi >> 1) ^ (0xE100000000000000ULL & carry);
+            }
+            storeBE64(state, zHi);
+            storeBE64(state + 8, zLo);
+        }
+    };
+
+public:
+    static bool randomBytes(unsigned char *out, size_t len)
+    {
+        // emscripten에서는 crypto.getRandomValues로 연결됨
+        while (len > 0)
+        {
+            size_t n = len < 256 ? len : 256;
+            if (getentropy(out, n) != 0)
+            {
+                return false;
+            }
+            out += n;
+            len -= n;
+        }
+        return true;
+    }
+
+    static void cleanse(void *ptr, size_t len)
+    {
+        volatile unsigned char *p = static_cast<volatile unsigned char *>(ptr);
+        while (len--)
+        {
+            *p++ = 0;
+        }
+    }
+
+    static void sha256(const unsigned char *data, size_t len, unsigned char out[32])
+    {
+        Sha256 ctx;
+        ctx.update(data, len);
+        ctx.finish(out);
+    }
+
+    static bool generatePrivateKey(unsigned char priv[32])
+    {
+        const Curve &c = curve();
+        for (int attempt = 0; attempt < 64; attempt++)
+        {
+            if (!randomBytes(priv, 32))
+            {
+                return false;
+            }
+            U256 d = fromBytes(priv);
+            if (!isZero(d) && lessThan(d, c.n.m))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 개인키와 공개키를 한 번에 생성 (생성점 곱셈 1회)
+    static bool generateKeyPair(unsigned char priv[32], unsigned char pub[65])
+    {
+        return generatePrivateKey(priv) && derivePublicKey(priv, pub);
+    }
+
+    static bool derivePublicKey(const unsigned char priv[32], unsigned char pub[65])
+    {
+        const Curve &c = curve();
+        U256 d = fromBytes(priv);
+        if (isZero(d) || !lessThan(d, c.n.m))
+        {
+            return false;
+        }
+
+        Point r = baseMul(priv);
+        U256 x, y;
+        if (!toAffine(r, x, y))
+        {
+            return false;
+        }
+        pub[0] = 0x04;
+        toBytes(x, pub + 1);
+        toBytes(y, pub + 33);
+        return true;
+    }
+
+    // 압축(33) 또는 비압축(65) 공개키를 검증 후 비압축 형식으로 변환
+    static bool parsePublicKey(const unsigned char *in, size_t len, unsigned char pub[65])
+    {
+        const Curve &c = curve();
+        const Field &p = c.p;
+
+        if (len == 65 && in[0] == 0x04)
+        {
+            U256 x = fromBytes(in + 1);
+            U256 y = fromBytes(in + 33);
+            if (!lessThan(x, p.m) || !lessThan(y, p.m))
+            {
+                return false;
+            }
+            U256 ym = toMont(p, y);
+            if (!equal(mul(p, ym, ym), curveRHS(toMont(p, x))))
+            {
+                return false;
+            }
+            std::memcpy(pub, in, 65);
+            return true;
+        }
+
+        if (len == 33 && (in[0] == 0x02 || in[0] == 0x03))
+        {
+            U256 x = fromBytes(in + 1);
+            if (!lessThan(x, p.m))
+            {
+                return false;
+            }
+            // p = 3 (mod 4) 이므로 y = rhs^((p+1)/4)
+            U256 rhs = curveRHS(toMont(p, x));
+            U256 ym = pow(p, rhs, c.sqrtExp);
+            if (!equal(mul(p, ym, ym), rhs))
+            {
+                return false;
+            }
+            U256 y = fromMont(p, ym);
+            if ((y.v[0] & 1) != (in[0] & 1))
+            {
+                if (isZero(y))
+                {
+                    return false;
+                }
+                subRaw(y, p.m, y);
+            }
+            pub[0] = 0x04;
+            std::memcpy(pub + 1, in + 1, 32);
+            toBytes(y, pub + 33);
+            return true;
+        }
+
+        return false;
+    }
+
+    static bool sign(const unsigned char priv[32], const unsigned char hash[32], unsigned char sig[64])
+    {
+        const Curve &c = curve();
+        const Field &n = c.n;
+        U256 d = fromBytes(priv);
+        if (isZero(d) || !lessThan(d, n.m))
+        {
+            return false;
+        }
+        U256 e = reduceOnce(fromBytes(hash), n.m);
+
+        bool ok = false;
+        unsigned char k[32];
+        for (int attempt = 0; attempt < 64 && !ok; attempt++)
+        {
+            if (!generatePrivateKey(k))
+            {
+                break;
+            }
+
+            // r = (kG).x mod n
+            U256 x, y;
+            if (!toAffine(baseMul(k), x, y))
+            {
+                continue;
+            }
+            U256 r = reduceOnce(x, n.m);
+            if (isZero(r))
+            {
+                continue;
+            }
+
+            // s = k^-1 (e + r d) mod n
+            U256 kInv = pow(n, toMont(n, fromBytes(k)), c.nMinus2);
+            U256 rd = mul(n, toMont(n, r), toMont(n, d));
+            U256 s = fromMont(n, mul(n, kInv, add(n, toMont(n, e), rd)));
+            if (isZero(s))
+            {
+                continue;
+            }
+
+            toBytes(r, sig);
+            toBytes(s, sig + 32);
+            ok = true;
+        }
+
+        cleanse(k, sizeof(k));
+        cleanse(&d, sizeof(d));
+        return ok;
+    }
+
+    static bool verify(const unsigned char pub[65], const unsigned char hash[32], const unsigned char sig[64])
+    {
+        const Curve &c = curve();
+        const Field &n = c.n;
+
+        unsigned char checked[65];
+        if (!parsePublicKey(pub, 65, checked))
+        {
+            return false;
+        }
+
+        U256 r = fromBytes(sig);
+        U256 s = fromBytes(sig + 32);
+        if (isZero(r) || isZero(s) || !lessThan(r, n.m) || !lessThan(s, n.m))
+        {
+            return false;
+        }
+        U256 e = reduceOnce(fromBytes(hash), n.m);
+
+        // R = (e/s)G + (r/s)Q
+        U256 w = pow(n, toMont(n, s), c.nMinus2);
+        unsigned char u1[32], u2[32];
+        toBytes(fromMont(n, mul(n, toMont(n, e), w)), u1);
+        toBytes(fromMont(n, mul(n, toMont(n, r), w)), u2);
+
+        Point q = affinePoint(fromBytes(pub + 1), fromBytes(pub + 33));
+        Point sum = pointAdd(baseMul(u1), scalarMul(q, u2));
+
+        U256 x, y;
+        if (!toAffine(sum, x, y))
+        {
+            return false;
+        }
+        return equal(reduceOnce(x, n.m), r);
+    }
+
+    // ECDH: 공유 포인트의 x 좌표
+    static bool ecdh(const unsigned char priv[32], const unsigned char pub[65], unsigned char secret[32])
+    {
+        const Curve &c = curve();
+        U256 d = fromBytes(priv);
+        unsigned char checked[65];
+        if (isZero(d) || !lessThan(d, c.n.m) || !parsePublicKey(pub, 65, checked))
+        {
+            return false;
+        }
+
+        Point q = affinePoint(fromBytes(pub + 1), fromBytes(pub + 33));
+        U256 x, y;
+        if (!toAffine(scalarMul(q, priv), x, y))
+        {
+            return false;
+        }
+        toBytes(x, secret);
+        return true;
+    }
+
+    // AES-256-GCM (nonce 12바이트, tag 16바이트). 복호화는 tag 검증 실패 시 false
+    static bool gcm(bool encrypting, const unsigned char key[32], const unsigned char nonce[12],
+                    const unsigned char *aad, size_t aadLen,
+                    const unsigned char *in, size_t len,
+                    unsigned char *out, unsigned char tag[16])
+    {
+        Aes256 aes(key);
+
+        unsigned char h[16] = {0};
+        aes.encryptBlock(h, h);
+
+        unsigned char j0[16];
+        std::memcpy(j0, nonce, 12);
+        j0[12] = j0[13] = j0[14] = 0;
+        j0[15] = 1;
+
+        // 복호화는 암호문에 대해, 암호화는 출력에 대해 GHASH
+        Ghash ghash(h);
+        ghash.update(aad, aadLen);
+        ghash.pad();
+        if (!encrypting)
+        {
+            ghash.update(in, len);
+        }
+
+        unsigned char counter[16], stream[16];
+        std::memcpy(counter, j0, 16);
+        for (size_t i = 0; i < len; i += 16)
+        {
+            increment32(counter);
+            aes.encryptBlock(counter, stream);
+            size_t n = len - i < 16 ? len - i : 16;
+            for (size_t j = 0; j < n; j++)
+            {
+                out[i + j] = in[i + j] ^ stream[j];
+            }
+        }
+
+        if (encrypting)
+        {
+            ghash.update(out, len);
+        }
+        ghash.pad();
+
+        unsigned char lengths[16];
+        storeBE64(lengths, static_cast<uint64_t>(aadLen) * 8);
+        storeBE64(lengths + 8, static_cast<uint64_t>(len) * 8);
+        ghash.update(lengths, 16);
+
+        unsigned char expected[16];
+        aes.encryptBlock(j0, expected);
+        for (int i = 0; i < 16; i++)
+        {
+            expected[i] ^= ghash.state[i];
+        }
+
+        if (encrypting)
+        {
+            std::memcpy(tag, expected, 16);
+            return true;
+        }
+
+        unsigned char diff = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            diff |= expected[i] ^ tag[i];
+        }
+        if (diff != 0)
+        {
+            cleanse(out, len);
+            return false;
+        }
+        return true;
+    }
+
+    // AES-256 CBC(PKCS#7 패딩 선택)/CTR 스트리밍 컨텍스트
+    // update의 출력 버퍼는 len + 16, finish는 16바이트 이상이어야 함
+    class Cipher
+    {
+    public:
+        enum Mode
+        {
+            CBC,
+            CBC_NO_PADDING,
+            CTR,
+        };
+
+        Cipher() = default;
+        ~Cipher()
+        {
+            cleanse(this, sizeof(*this));
+        }
+
+        Cipher(const Cipher &) = delete;
+        Cipher &operator=(const Cipher &) = delete;
+
+        bool init(Mode mode, bool encrypting, const unsigned char key[32], const unsigned char iv[16])
+        {
+            aes_.setKey(key);
+            std::memcpy(iv_, iv, 16);
+            mode_ = mode;
+            encrypting_ = encrypting;
+            bufLen_ = 0;
+            streamPos_ = 16;
+            return true;
+        }
+
+        bool update(const unsigned char *in, size_t len, unsigned char *out, size_t &outLen)
+        {
+            outLen = 0;
+            if (mode_ == CTR)
+            {
+                for (size_t i = 0; i < len; i++)
+                {
+                    if (streamPos_ == 16)
+                    {
+                        aes_.encryptBlock(iv_, stream_);
+                        increment128(iv_);
+                        streamPos_ = 0;
+                    }
+                    out[i] = in[i] ^ stream_[streamPos_++];
+                }
+                outLen = len;
+                return true;
+            }
+
+            // 패딩이 있는 CBC 복호화는 마지막 블록을 finish까지 보류
+            size_t total = bufLen_ + len;
+            size_t blocks = (mode_ == CBC && !encrypting_) ? (total > 0 ? (total - 1) / 16 : 0) : total / 16;
+            for (size_t b = 0; b < blocks; b++)
+            {
+                unsigned char block[16];
+                size_t taken = bufLen_;
+                std::memcpy(block, buf_, taken);
+                std::memcpy(block + taken, in, 16 - taken);
+                in += 16 - taken;
+                len -= 16 - taken;
+                bufLen_ = 0;
+
+                processBlock(block, out + outLen);
+                outLen += 16;
+            }
+            std::memcpy(buf_ + bufLen_, in, len);
+            bufLen_ += len;
+            return true;
+        }
+
+        bool finish(unsigned char *out, size_t &outLen)
+        {
+            outLen = 0;
+            if (mode_ == CTR)
+            {
+                return true;
+            }
+            if (mode_ == CBC_NO_PADDING)
+            {
+                return bufLen_ == 0;
+            }
+
+            if (encrypting_)
+            {
+                unsigned char pad = static_cast<unsigned char>(16 - bufLen_);
+                std::memset(buf_ + bufLen_, pad, pad);
+                processBlock(buf_, out);
+                outLen = 16;
+                bufLen_ = 0;
+                return true;
+            }
+
+            if (bufLen_ != 16)
+            {
+                return false;
+            }
+            unsigned char block[16];
+            processBlock(buf_, block);
+            bufLen_ = 0;
+
+            unsigned char pad = block[15];
+            bool ok = pad >= 1 && pad <= 16;
+            for (size_t i = 0; ok && i < pad; i++)
+            {
+                ok = block[15 - i] == pad;
+            }
+            if (ok)
+            {
+                std::memcpy(out, block, 16 - pad);
+                outLen = 16 - pad;
+            }
+            cleanse(block, sizeof(block));
+            return ok;
+        }
+
+    private:
+        void processBlock(const unsigned char block[16], unsigned char *out)
+        {
+            if (encrypting_)
+            {
+                for (int i = 0; i < 16; i++)
+                {
+                    iv_[i] ^= block[i];
+                }
+                aes_.encryptBlock(iv_, iv_);
+                std::memcpy(out, iv_, 16);
+            }
+            else
+            {
+                unsigned char plain[16];
+                aes_.decryptBlock(block, plain);
+                for (int i = 0; i < 16; i++)
+                {
+                    out[i] = plain[i] ^ iv_[i];
+                }
+                std::memcpy(iv_, block, 16);
+            }
+        }
+
+        Aes256 aes_;
+        unsigned char iv_[16] = {0}; // CBC: 직전 암호문 블록, CTR: 카운터
+        unsigned char buf_[16] = {0};
+        unsigned char stream_[16] = {0};
+        size_t bufLen_ = 0;
+        size_t streamPos_ = 16;
+        Mode mode_ = CBC;
+        bool encrypting_ = true;
+    };
+
+private:
+    // ---- P-256 ----
+    struct U256
+    {
+        uint32_t v[8]; // little-endian limb
+    };
+
+    // 몽고메리 연산용 모듈러스 (R = 2^256)
+    struct Field
+    {
+        U256 m;
+        uint32_t n0; // -m^-1 mod 2^32
+        U256 one;    // R mod m
+        U256 r2;     // R^2 mod m
+    };
+
+    // 사영 좌표 (X:Y:Z), 좌표는 몽고메리 형식. 항등원은 (0:1:0)
+    struct Point
+    {
+        U256 x, y, z;
+    };
+
+    struct Curve
+    {
+        Field p, n;
+        U256 b;       // 몽고메리 형식
+        Point g;
+        U256 sqrtExp; // (p + 1) / 4
+        U256 nMinus2;
+    };
+
+    static const Curve &curve()
+    {
+        static const Curve c = []() {
+            static const unsigned char P[32] = {
+                0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+            static const unsigned char N[32] = {
+                0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+            static const unsigned char B[32] = {
+                0x5a, 0xc6, 0x35, 0xd8, 0xaa, 0x3a, 0x93, 0xe7, 0xb3, 0xeb, 0xbd, 0x55, 0x76, 0x98, 0x86, 0xbc,
+                0x65, 0x1d, 0x06, 0xb0, 0xcc, 0x53, 0xb0, 0xf6, 0x3b, 0xce, 0x3c, 0x3e, 0x27, 0xd2, 0x60, 0x4b};
+            static const unsigned char GX[32] = {
+                0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+                0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96};
+            static const unsigned char GY[32] = {
+                0x4f, 0xe3, 0x42, 0xe2, 0xfe, 0x1a, 0x7f, 0x9b, 0x8e, 0xe7, 0xeb, 0x4a, 0x7c, 0x0f, 0x9e, 0x16,
+                0x2b, 0xce, 0x33, 0x57, 0x6b, 0x31, 0x5e, 0xce, 0xcb, 0xb6, 0x40, 0x68, 0x37, 0xbf, 0x51, 0xf5};
+
+            Curve result;
+            result.p = makeField(fromBytes(P));
+            result.n = makeField(fromBytes(N));
+            result.b = toMont(result.p, fromBytes(B));
+            result.g = affinePoint(fromBytes(GX), fromBytes(GY), result.p);
+
+            U256 one = {{1}}, two = {{2}};
+            addRaw(result.sqrtExp, result.p.m, one);
+            for (int shift = 0; shift < 2; shift++)
+            {
+                for (int i = 0; i < 8; i++)
+                {
+                    uint32_t next = i < 7 ? result.sqrtExp.v[i + 1] : 0;
+                    result.sqrtExp.v[i] = (result.sqrtExp.v[i] >> 1) | (next << 31);
+                }
+            }
+            subRaw(result.nMinus2, result.n.m, two);
+            return result;
+        }();
+        return c;
+    }
+
+    static Field makeField(const U256 &m)
+    {
+        Field f;
+        f.m = m;
+
+        // 뉴턴 반복으로 m^-1 mod 2^32
+        uint32_t inv = 1;
+        for (int i = 0; i < 5; i++)
+        {
+            inv *= 2 - m.v[0] * inv;
+        }
+        f.n0 = 0 - inv;
+
+        // 2^256, 2^512 mod m (1을 반복해서 두 배)
+        U256 r = {{1}};
+        for (int i = 0; i < 256; i++)
+        {
+            r = add(f, r, r);
+        }
+        f.one = r;
+        for (int i = 0; i < 256; i++)
+        {
+            r = add(f, r, r);
+        }
+        f.r2 = r;
+        return f;
+    }
+
+    static uint32_t addRaw(U256 &r, const U256 &a, const U256 &b)
+    {
+        uint64_t carry = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            carry += static_cast<uint64_t>(a.v[i]) + b.v[i];
+            r.v[i] = static_cast<uint32_t>(carry);
+            carry >>= 32;
+        }
+        return static_cast<uint32_t>(carry);
+    }
+
+    static uint32_t subRaw(U256 &r, const U256 &a, const U256 &b)
+    {
+        uint64_t borrow = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            uint64_t diff = static_cast<uint64_t>(a.v[i]) - b.v[i] - borrow;
+            r.v[i] = static_cast<uint32_t>(diff);
+            borrow = (diff >> 63) & 1;
+        }
+        return static_cast<uint32_t>(borrow);
+    }
+
+    // mask가 모두 1이면 a, 0이면 b
+    static U256 select(uint32_t mask, const U256 &a, const U256 &b)
+    {
+        U256 r;
+        for (int i = 0; i < 8; i++)
+        {
+            r.v[i] = (a.v[i] & mask) | (b.v[i] & ~mask);
+        }
+        return r;
+    }
+
+    static U256 add(const Field &f, const U256 &a, const U256 &b)
+    {
+        U256 sum, reduced;
+        uint32_t carry = addRaw(sum, a, b);
+        uint32_t borrow = subRaw(reduced, sum, f.m);
+        return select(0 - (carry | (borrow ^ 1)), reduced, sum);
+    }
+
+    static U256 sub(const Field &f, const U256 &a, const U256 &b)
+    {
+        U256 diff, wrapped;
+        uint32_t borrow = subRaw(diff, a, b);
+        addRaw(wrapped, diff, f.m);
+        return select(0 - borrow, wrapped, diff);
+    }
+
+    // 몽고메리 곱 a * b * R^-1 mod m (CIOS)
+    static U256 mul(const Field &f, const U256 &a, const U256 &b)
+    {
+        uint32_t t[10] = {0};
+        for (int i = 0; i < 8; i++)
+        {
+            uint64_t c = 0;
+            for (int j = 0; j < 8; j++)
+            {
+                c += static_cast<uint64_t>(t[j]) + static_cast<uint64_t>(a.v[j]) * b.v[i];
+                t[j] = static_cast<uint32_t>(c);
+                c >>= 32;
+            }
+            c += t[8];
+            t[8] = static_cast<uint32_t>(c);
+            t[9] = static_cast<uint32_t>(c >> 32);
+
+            uint32_t q = t[0] * f.n0;
+            c = (static_cast<uint64_t>(t[0]) + static_cast<uint64_t>(q) * f.m.v[0]) >> 32;
+            for (int j = 1; j < 8; j++)
+            {
+                c += static_cast<uint64_t>(t[j]) + static_cast<uint64_t>(q) * f.m.v[j];
+                t[j - 1] = static_cast<uint32_t>(c);
+                c >>= 32;
+            }
+            c += t[8];
+            t[7] = static_cast<uint32_t>(c);
+            t[8] = t[9] + static_cast<uint32_t>(c >> 32);
+        }
+
+        U256 r, reduced;
+        std::memcpy(r.v, t, sizeof(r.v));
+        uint32_t borrow = subRaw(reduced, r, f.m);
+        return select(0 - (t[8] | (borrow ^ 1)), reduced, r);
+    }
+
+    static U256 toMont(const Field &f, const U256 &a) { return mul(f, a, f.r2); }
+
+    static U256 fromMont(const Field &f, const U256 &a)
+    {
+        U256 one = {{1}};
+        return mul(f, a, one);
+    }
+
+    // a^e (a는 몽고메리 형식, e는 일반 정수). 비트 값과 무관하게 같은 연산 순서
+    static U256 pow(const Field &f, const U256 &a, const U256 &e)
+    {
+        U256 r = f.one;
+        for (int i = 255; i >= 0; i--)
+        {
+            r = mul(f, r, r);
+            U256 t = mul(f, r, a);
+            r = select(0 - ((e.v[i / 32] >> (i % 32)) & 1), t, r);
+        }
+        return r;
+    }
+
+    // y^2 = x^3 - 3x + b 의 우변 (몽고메리 형식)
+    static U256 curveRHS(const U256 &x)
+    {
+        const Curve &c = curve();
+        const Field &p = c.p;
+        U256 x3 = mul(p, mul(p, x, x), x);
+        U256 threeX = add(p, add(p, x, x), x);
+        return add(p, sub(p, x3, threeX), c.b);
+    }
+
+    static Point affinePoint(const U256 &x, const U256 &y) { return affinePoint(x, y, curve().p); }
+
+    static Point affinePoint(const U256 &x, const U256 &y, const Field &p)
+    {
+        return Point{toMont(p, x), toMont(p, y), p.one};
+    }
+
+    static bool toAffine(const Point &pt, U256 &x, U256 &y)
+    {
+        const Curve &c = curve();
+        if (isZero(pt.z))
+        {
+            return false;
+        }
+        U256 pMinus2, two = {{2}};
+        subRaw(pMinus2, c.p.m, two);
+        U256 zInv = pow(c.p, pt.z, pMinus2);
+        x = fromMont(c.p, mul(c.p, pt.x, zInv));
+        y = fromMont(c.p, mul(c.p, pt.y, zInv));
+        return true;
+    }
+
+    // 완전 덧셈 공식 (Renes-Costello-Batina 2015, a = -3, 알고리즘 4)
+    static Point pointAdd(const Point &p1, const Point &p2)
+    {
+        const Curve &c = curve();
+        const Field &f = c.p;
+        U256 t0 = mul(f, p1.x, p2.x);
+        U256 t1 = mul(f, p1.y, p2.y);
+        U256 t2 = mul(f, p1.z, p2.z);
+        U256 t3 = add(f, p1.x, p1.y);
+        U256 t4 = add(f, p2.x, p2.y);
+        t3 = mul(f, t3, t4);
+        t4 = add(f, t0, t1);
+        t3 = sub(f, t3, t4);
+        t4 = add(f, p1.y, p1.z);
+        U256 x3 = add(f, p2.y, p2.z);
+        t4 = mul(f, t4, x3);
+        x3 = add(f, t1, t2);
+        t4 = sub(f, t4, x3);
+        x3 = add(f, p1.x, p1.z);
+        U256 y3 = add(f, p2.x, p2.z);
+        x3 = mul(f, x3, y3);
+        y3 = add(f, t0, t2);
+        y3 = sub(f, x3, y3);
+        U256 z3 = mul(f, c.b, t2);
+        x3 = sub(f, y3, z3);
+        z3 = add(f, x3, x3);
+        x3 = add(f, x3, z3);
+        z3 = sub(f, t1, x3);
+        x3 = add(f, t1, x3);
+        y3 = mul(f, c.b, y3);
+        t1 = add(f, t2, t2);
+        t2 = add(f, t1, t2);
+        y3 = sub(f, y3, t2);
+        y3 = sub(f, y3, t0);
+        t1 = add(f, y3, y3);
+        y3 = add(f, t1, y3);
+        t1 = add(f, t0, t0);
+        t0 = add(f, t1, t0);
+        t0 = sub(f, t0, t2);
+        t1 = mul(f, t4, y3);
+        t2 = mul(f, t0, y3);
+        y3 = mul(f, x3, z3);
+        y3 = add(f, y3, t2);
+        x3 = mul(f, t3, x3);
+        x3 = sub(f, x3, t1);
+        z3 = mul(f, t4, z3);
+        t1 = mul(f, t3, t0);
+        z3 = add(f, z3, t1);
+        return Point{x3, y3, z3};
+    }
+
+    // 완전 두 배 공식 (같은 논문, 알고리즘 6)
+    static Point pointDouble(const Point &p)
+    {
+        const Curve &c = curve();
+        const Field &f = c.p;
+        U256 t0 = mul(f, p.x, p.x);
+        U256 t1 = mul(f, p.y, p.y);
+        U256 t2 = mul(f, p.z, p.z);
+        U256 t3 = mul(f, p.x, p.y);
+        t3 = add(f, t3, t3);
+        U256 z3 = mul(f, p.x, p.z);
+        z3 = add(f, z3, z3);
+        U256 y3 = mul(f, c.b, t2);
+        y3 = sub(f, y3, z3);
+        U256 x3 = add(f, y3, y3);
+        y3 = add(f, x3, y3);
+        x3 = sub(f, t1, y3);
+        y3 = add(f, t1, y3);
+        y3 = mul(f, y3, x3);
+        x3 = mul(f, x3, t3);
+        t3 = add(f, t2, t2);
+        t2 = add(f, t2, t3);
+        z3 = mul(f, c.b, z3);
+        z3 = sub(f, z3, t2);
+        z3 = sub(f, z3, t0);
+        t3 = add(f, z3, z3);
+        z3 = add(f, z3, t3);
+        t3 = add(f, t0, t0);
+        t0 = add(f, t3, t0);
+        t0 = sub(f, t0, t2);
+        t0 = mul(f, t0, z3);
+        y3 = add(f, y3, t0);
+        t0 = mul(f, p.y, p.z);
+        t0 = add(f, t0, t0);
+        z3 = mul(f, t0, z3);
+        x3 = sub(f, x3, z3);
+        z3 = mul(f, t0, t1);
+        z3 = add(f, z3, z3);
+        z3 = add(f, z3, z3);
+        return Point{x3, y3, z3};
+    }
+
+    // k * p (k는 32바이트 big-endian), 4비트 고정 윈도
+    static Point scalarMul(const Point &p, const unsigned char k[32])
+    {
+        const Field &f = curve().p;
+        Point identity{U256{}, f.one, U256{}};
+
+        Point table[16];
+        table[0] = identity;
+        table[1] = p;
+        for (int i = 2; i < 16; i++)
+        {
+            table[i] = (i % 2 == 0) ? pointDouble(table[i / 2]) : pointAdd(table[i - 1], p);
+        }
+
+        Point r = identity;
+        for (int i = 0; i < 64; i++)
+        {
+            if (i > 0)
+            {
+                for (int d = 0; d < 4; d++)
+                {
+                    r = pointDouble(r);
+                }
+            }
+
+            uint32_t nibble = (k[i / 2] >> ((i % 2) ? 0 : 4)) & 0x0f;
+            Point t = identity;
+            for (uint32_t j = 1; j < 16; j++)
+            {
+                uint32_t mask = 0 - static_cast<uint32_t>(((j ^ nibble) - 1) >> 31);
+                t.x = select(mask, table[j].x, t.x);
+                t.y = select(mask, table[j].y, t.y);
+                t.z = select(mask, table[j].z, t.z);
+            }
+            r = pointAdd(r, t);
+        }
+
+        cleanse(table, sizeof(table));
+        return r;
+    }
+
+    // k * G, 고정 생성점 콤 테이블 사용
+    // table[i][j-1] = j * 16^(63-i) * G 이므로 k의 니블마다 덧셈 한 번 (두 배 연산 없음)
+    struct BaseTable
+    {
+        Point entries[64][15];
+    };
+
+    static const BaseTable &baseTable()
+    {
+        // 약 90KB라 스택에 만들지 않고 한 번만 힙에 생성 (프로세스 수명 동안 유지)
+        static const BaseTable *table = []() {
+            BaseTable *t = new BaseTable;
+            Point base = curve().g;
+            for (int i = 63; i >= 0; i--)
+            {
+                t->entries[i][0] = base;
+                for (int j = 2; j <= 15; j++)
+                {
+                    t->entries[i][j - 1] = (j % 2 == 0) ? pointDouble(t->entries[i][j / 2 - 1])
+                                                        : pointAdd(t->entries[i][j - 2], base);
+                }
+                base = pointDouble(t->entries[i][7]); // 16 * base
+            }
+            return t;
+        }();
+        return *table;
+    }
+
+    static Point baseMul(const unsigned char k[32])
+    {
+        const BaseTable &table = baseTable();
+        const Field &f = curve().p;
+        Point r{U256{}, f.one, U256{}};
+
+        for (int i = 0; i < 64; i++)
+        {
+            uint32_t nibble = (k[i / 2] >> ((i % 2) ? 0 : 4)) & 0x0f;
+            Point t{U256{}, f.one, U256{}};
+            for (uint32_t j = 1; j < 16; j++)
+            {
+                uint32_t mask = 0 - static_cast<uint32_t>(((j ^ nibble) - 1) >> 31);
+                t.x = select(mask, table.entries[i][j - 1].x, t.x);
+                t.y = select(mask, table.entries[i][j - 1].y, t.y);
+                t.z = select(mask, table.entries[i][j - 1].z, t.z);
+            }
+            r = pointAdd(r, t);
+        }
+        return r;
+    }
+
+    static U256 fromBytes(const unsigned char in[32])
+    {
+        U256 r;
+        for (int i = 0; i < 8; i++)
+        {
+            r.v[i] = loadBE32(in + 28 - i * 4);
+        }
+        return r;
+    }
+
+    static void toBytes(const U256 &a, unsigned char out[32])
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            storeBE32(out + 28 - i * 4, a.v[i]);
+        }
+    }
+
+    static bool isZero(const U256 &a)
+    {
+        uint32_t acc = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            acc |= a.v[i];
+        }
+        return acc == 0;
+    }
+
+    static bool equal(const U256 &a, const U256 &b)
+    {
+        uint32_t acc = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            acc |= a.v[i] ^ b.v[i];
+        }
+        return acc == 0;
+    }
+
+    static bool lessThan(const U256 &a, const U256 &m)
+    {
+        U256 t;
+        return subRaw(t, a, m) == 1;
+    }
+
+    // a < 2m 일 때 a mod m
+    static U256 reduceOnce(const U256 &a, const U256 &m)
+    {
+        U256 t;
+        uint32_t borrow = subRaw(t, a, m);
+        return select(0 - borrow, a, t);
+    }
+
+    static uint32_t loadBE32(const unsigned char *p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    static uint64_t loadBE64(const unsigned char *p)
+    {
+        return (static_cast<uint64_t>(loadBE32(p)) << 32) | loadBE32(p + 4);
+    }
+
+    static void storeBE32(unsigned char *p, uint32_t v)
+    {
+        p[0] = static_cast<unsigned char>(v >> 24);
+        p[1] = static_cast<unsigned char>(v >> 16);
+        p[2] = static_cast<unsigned char>(v >> 8);
+        p[3] = static_cast<unsigned char>(v);
+    }
+
+    static void storeBE64(unsigned char *p, uint64_t v)
+    {
+        storeBE32(p, static_cast<uint32_t>(v >> 32));
+        storeBE32(p + 4, static_cast<uint32_t>(v));
+    }
+
+    // GCM 카운터: 마지막 32비트만 증가
+    static void increment32(unsigned char counter[16])
+    {
+        storeBE32(counter + 12, loadBE32(counter + 12) + 1);
+    }
+
+    // CTR 카운터: 128비트 전체 증가 (OpenSSL EVP_aes_256_ctr와 동일)
+    static void increment128(unsigned char counter[16])
+    {
+        for (int i = 15; i >= 0; i--)
+        {
+            if (++counter[i] != 0)
+            {
+                break;
+            }
+        }
+    }
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+// 암호 기본 연산 백엔드 선택 (빌드 시)
+//   기본                           OpenSSL (openssl_crypto.cpp)
+//   -DMATTER_TUNNEL_COMPACT_CRYPTO  P-256/SHA-256/AES 자체 구현 (compact_crypto.cpp), libcrypto 불필요
+// 두 백엔드의 출력 형식은 같으므로 서로 만든 키/서명/TX를 그대로 주고받을 수 있다.
+#if defined(MATTER_TUNNEL_COMPACT_CRYPTO)
+#include "./compact_crypto.cpp"
+using CryptoBackend = CompactCrypto;
+#else
+#include "./openssl_crypto.cpp"
+using CryptoBackend = OpenSSLCrypto;
+#endif
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include "./crypto_backend.cpp"
+#include "./matter_result.cpp"
+
+// 디바이스 함수의 인자/반환 타입 (2비트 코드)
+enum class ValueType : uint8_t
+{
+    Void = 0x00,
+    String = 0x01,
+    Number = 0x02,
+    Boolean = 0x03,
+};
+
+inline const char *valueTypeName(ValueType type) noexcept
+{
+    switch (type)
+    {
+    case ValueType::String:
+        return "string";
+    case ValueType::Number:
+        return "number";
+    case ValueType::Boolean:
+        return "boolean";
+    default:
+        return "void";
+    }
+}
+
+// pos부터 연속된 10진수 자릿수를 건너뛰고 그 개수 반환
+inline size_t skipDigits(std::string_view value, size_t &pos) noexcept
+{
+    size_t start = pos;
+    while (pos < value.length() && value[pos] >= '0' && value[pos] <= '9')
+    {
+        pos++;
+    }
+    return pos - start;
+}
+
+// 문자열로 전달된 인자가 타입에 맞는지 (송신측의 JS String(value) 형식)
+// string은 무엇이든, boolean은 "true"/"false", number는 10진수/지수 표기 또는 NaN, Infinity
+inline bool valueMatchesType(ValueType type, std::string_view value) noexcept
+{
+    switch (type)
+    {
+    case ValueType::String:
+        return true;
+    case ValueType::Boolean:
+        return value == "true" || value == "false";
+    case ValueType::Number:
+    {
+        if (value == "NaN" || value == "Infinity" || value == "-Infinity")
+            return true;
+        size_t i = value.length() > 0 && value[0] == '-' ? 1 : 0;
+        size_t digits = skipDigits(value, i);
+        if (i < value.length() && value[i] == '.')
+        {
+            digits += skipDigits(value, ++i);
+        }
+        if (digits == 0)
+            return false;
+        if (i < value.length() && (value[i] == 'e' || value[i] == 'E'))
+        {
+            i++;
+            if (i < value.length() && (value[i] == '+' || value[i] == '-'))
+                i++;
+            if (skipDigits(value, i) == 0)
+                return false;
+        }
+        return i == value.length();
+    }
+    default:
+        return false;
+    }
+}
+
+// 디바이스 데이터의 function 항목 하나 (이름 18바이트 + 타입 2바이트)
+struct DeviceFunction
+{
+    std::string name;
+    ValueType argTypes[7]; // 상위 비트부터, 첫 Void 이후는 인자가 아님
+    ValueType returnType;
+
+    size_t argCount() const noexcept
+    {
+        size_t count = 0;
+        while (count < 7 && argTypes[count] != ValueType::Void)
+        {
+            count++;
+        }
+        return count;
+    }
+
+    // "setLED(number,boolean)->void"
+    std::string signature() const
+    {
+        std::string result = name + "(";
+        for (size_t i = 0; i < argCount(); i++)
+        {
+            if (i > 0)
+                result += ",";
+            result += valueTypeName(argTypes[i]);
+        }
+        return result + ")->" + valueTypeName(returnType);
+    }
+
+    // 복호화된 인자 목록 검사 (개수와 타입)
+    MatterError checkArgs(const std::vector<std::string> &args) const noexcept
+    {
+        if (args.size() != argCount())
+        {
+            return MatterError::InvalidArguments;
+        }
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            if (!valueMatchesType(argTypes[i], args[i]))
+            {
+                return MatterError::InvalidArguments;
+            }
+        }
+        return MatterError::Ok;
+    }
+};
+
+// 디바이스 데이터를 파싱한 결과: compressed pubkey(33) + passcode(16) + function(20) * n
+class DeviceInfo
+{
+public:
+    unsigned char publicKey[65];     // 비압축
+    unsigned char compressedKey[33]; // 디바이스 데이터에 기록된 그대로
+    unsigned char passcode[16];
+    std::vector<DeviceFunction> functions;
+
+    DeviceInfo() = default;
+
+    static DeviceInfo parse(const unsigned char *data, size_t len)
+    {
+        return tryParse(data, len).unwrap();
+    }
+
+    static MatterResult<DeviceInfo> tryParse(const unsigned char *data, size_t len)
+    {
+        if (len < 49)
+        { // 최소 크기: publicKey(33) + passcode(16)
+            return MatterError::InvalidDataSize;
+        }
+
+        DeviceInfo info;
+        if (!CryptoBackend::parsePublicKey(data, 33, info.publicKey))
+        {
+            return MatterError::InvalidPublicKey;
+        }
+        info.parseRest(data, len);
+        return info;
+    }
+
+    // 공개키를 이미 복원해 둔 경우 (레지스트리 스냅샷): 곡선 연산 없이 나머지만 파싱
+    static MatterResult<DeviceInfo> tryParse(const unsigned char *data, size_t len,
+                                             const unsigned char publicKey[65])
+    {
+        if (len < 49)
+        {
+            return MatterError::InvalidDataSize;
+        }
+
+        DeviceInfo info;
+        std::memcpy(info.publicKey, publicKey, 65);
+        info.parseRest(data, len);
+        return info;
+    }
+
+    // funcName으로 함수 찾기 (없으면 nullptr)
+    const DeviceFunction *function(const std::string &name) const noexcept
+    {
+        auto it = index_.find(name);
+        return it == index_.end() ? nullptr : &functions[it->second];
+    }
+
+    // extractDeviceInfo 형식: {"publicKey":"...","passcode":"...","functions":["name(args)->ret",...]}
+    std::string toJSON() const
+    {
+        std::string json = "{\"publicKey\":\"";
+        appendHex(json, publicKey, 65);
+        json += "\",\"passcode\":\"";
+        appendHex(json, passcode, 16);
+        json += "\",\"functions\":[";
+        for (size_t i = 0; i < functions.size(); i++)
+        {
+            if (i > 0)
+                json += ",";
+            json += "\"" + functions[i].signature() + "\"";
+        }
+        json += "]}";
+        return json;
+    }
+
+private:
+    // compressed pubkey 바이트, passcode, function 항목 (publicKey는 호출자가 채움)
+    void parseRest(const unsigned char *data, size_t len)
+    {
+        std::memcpy(compressedKey, data, 33);
+        std::memcpy(passcode, data + 33, 16);
+
+        // 남는 20바이트 미만은 무시
+        functions.reserve((len - 49) / 20);
+        for (size_t pos = 49; pos + 20 <= len; pos += 20)
+        {
+            DeviceFunction function;
+            for (size_t i = 0; i < 18; i++)
+            {
+                if (data[pos + i] != 0)
+                {
+                    function.name += static_cast<char>(data[pos + i]);
+                }
+            }
+
+            uint16_t types = (data[pos + 18] << 8) | data[pos + 19];
+            bool ended = false;
+            for (int i = 0; i < 7; i++)
+            {
+                ValueType type = static_cast<ValueType>((types >> (14 - i * 2)) & 0x03);
+                ended = ended || type == ValueType::Void; // void는 더 이상의 인자가 없음을 의미
+                function.argTypes[i] = ended ? ValueType::Void : type;
+            }
+            function.returnType = static_cast<ValueType>(types & 0x03);
+
+            // 같은 이름이 여러 번 나오면 처음 것으로 디스패치
+            index_.emplace(function.name, functions.size());
+            functions.push_back(std::move(function));
+        }
+    }
+
+    static void appendHex(std::string &out, const unsigned char *data, size_t len)
+    {
+        static const char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < len; i++)
+        {
+            out += digits[data[i] >> 4];
+            out += digits[data[i] & 0x0f];
+        }
+    }
+
+    std::unordered_map<std::string, size_t> index_; // name -> functions 인덱스
+};
+
+// 게이트웨이가 등록한 디바이스 하나 (DeviceRegistry 항목)
+// 공개키는 info에 복원된 상태로 두고 게이트웨이 키와의 공유키를 캐시하므로,
+// 이 항목으로 TX를 만들거나 풀 때는 공개키 복원과 ECDH를 하지 않는다.
+struct DeviceEntry
+{
+    DeviceInfo info;
+    std::string publicKeyHex;       // 비압축 16진수 (TX JSON의 srcPub)
+    std::string sharedKey;          // 게이트웨이 개인키와의 ECDH 결과 (16진수)
+    std::vector<unsigned char> data; // 등록한 디바이스 데이터 그대로
+
+    ~DeviceEntry()
+    {
+        CryptoBackend::cleanse(&sharedKey[0], sharedKey.size());
+    }
+};
+
+// 디바이스 공개키별 DeviceInfo 캐시
+// 게이트웨이는 디바이스 등록 시 한 번만 파싱하고, 명령 검증 때는 공개키로 찾아 쓴다.
+// 조회 결과는 shared_ptr이므로 다른 스레드가 교체/삭제해도 사용 중인 정보는 유지된다.
+class DeviceInfoCache
+{
+public:
+    using InfoPtr = std::shared_ptr<const DeviceInfo>;
+
+    InfoPtr add(const unsigned char *data, size_t len)
+    {
+        return tryAdd(data, len).unwrap();
+    }
+
+    // 같은 공개키가 같은 데이터로 이미 있으면 다시 파싱하지 않고 기존 항목 반환
+    MatterResult<InfoPtr> tryAdd(const unsigned char *data, size_t len)
+    {
+        if (len < 49)
+        {
+            return MatterError::InvalidDataSize;
+        }
+
+        std::string key(reinterpret_cast<const char *>(data), 33);
+        std::string raw(reinterpret_cast<const char *>(data), len);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.raw == raw)
+            {
+                return it->second.info;
+            }
+        }
+
+        MatterResult<DeviceInfo> parsed = DeviceInfo::tryParse(data, len);
+        if (!parsed)
+        {
+            return parsed.error();
+        }
+        InfoPtr info = std::make_shared<const DeviceInfo>(std::move(parsed).value());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_[key] = Entry{std::move(raw), info};
+        return info;
+    }
+
+    // 압축 공개키(33바이트)로 조회 (없으면 nullptr)
+    InfoPtr find(const unsigned char compressedKey[33]) const
+    {
+        std::string key(reinterpret_cast<const char *>(compressedKey), 33);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        return it == entries_.end() ? nullptr : it->second.info;
+    }
+
+    // 비압축 공개키(65바이트, TX 헤더의 srcPubBytes)로 조회
+    InfoPtr findUncompressed(const unsigned char publicKey[65]) const
+    {
+        unsigned char compressed[33];
+        compressed[0] = (publicKey[64] & 1) ? 0x03 : 0x02;
+        std::memcpy(compressed + 1, publicKey + 1, 32);
+        return find(compressed);
+    }
+
+    bool remove(const unsigned char compressedKey[33])
+    {
+        std::string key(reinterpret_cast<const char *>(compressedKey), 33);
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.erase(key) != 0;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+private:
+    struct Entry
+    {
+        std::string raw; // 파싱한 디바이스 데이터 (재등록 시 변경 여부 비교)
+        InfoPtr info;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_; // 압축 공개키 -> 항목
+};
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include "./matter_tunnel.cpp"
+
+class RegistrySnapshot;
+
+// 게이트웨이의 디바이스 레지스트리 (압축 공개키 -> DeviceEntry)
+// 디코딩 스레드의 조회는 잠금 없이, 프로비저닝의 등록/삭제는 샤드 단위 복사 후 교체(RCU)로 처리한다.
+//
+// 샤드마다 읽기 전용 테이블 포인터와 epoch 홀짝별 읽기 카운터 두 개가 있다.
+// 조회: 현재 epoch의 카운터를 올리고 epoch가 그대로인지 확인한 뒤 테이블을 읽고 카운터를 내린다.
+// 변경: 샤드의 쓰기 잠금 안에서 테이블을 복사/수정해 교체하고, epoch를 넘긴 뒤 이전 epoch 카운터가 0이 되면
+//       이전 테이블을 해제한다. 새로 들어오는 조회는 다른 카운터를 쓰므로 쓰는 쪽이 무한히 기다리지 않는다.
+// 항목은 shared_ptr이므로 조회한 항목은 삭제된 뒤에도 유효하다.
+// 디바이스 데이터 파싱, 공개키 복원, ECDH는 등록 시 잠금 밖에서 한 번만 수행된다.
+class DeviceRegistry
+{
+    friend class RegistrySnapshot;
+
+public:
+    using EntryPtr = std::shared_ptr<const DeviceEntry>;
+
+    // shardCount는 2의 거듭제곱으로 올림
+    explicit DeviceRegistry(const std::string &gatewayPrivateKey, size_t shardCount = 64)
+        : gatewayKey_(gatewayPrivateKey)
+    {
+        unsigned char priv[32];
+        MatterError error = MatterTunnel::privateKeyBytes(gatewayPrivateKey, priv);
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        if (error != MatterError::Ok)
+        {
+            throwMatterError(error);
+        }
+
+        shardCount_ = 1;
+        while (shardCount_ < shardCount)
+        {
+            shardCount_ <<= 1;
+        }
+        shards_.reset(new Shard[shardCount_]);
+    }
+
+    DeviceRegistry(const DeviceRegistry &) = delete;
+    DeviceRegistry &operator=(const DeviceRegistry &) = delete;
+
+    ~DeviceRegistry()
+    {
+        for (size_t i = 0; i < shardCount_; i++)
+        {
+            delete shards_[i].table.load();
+        }
+        CryptoBackend::cleanse(&gatewayKey_[0], gatewayKey_.size());
+    }
+
+    EntryPtr add(const std::vector<unsigned char> &data)
+    {
+        return tryAdd(data.data(), data.size()).unwrap();
+    }
+
+    EntryPtr add(const unsigned char *data, size_t len)
+    {
+        return tryAdd(data, len).unwrap();
+    }
+
+    // 같은 공개키가 같은 데이터로 이미 있으면 기존 항목 반환, 데이터가 다르면 교체
+    MatterResult<EntryPtr> tryAdd(const unsigned char *data, size_t len)
+    {
+        if (len < 49)
+        {
+            return MatterError::InvalidDataSize;
+        }
+        EntryPtr existing = find(data);
+        if (existing && existing->data.size() == len && std::memcmp(existing->data.data(), data, len) == 0)
+        {
+            return existing;
+        }
+
+        MatterResult<DeviceInfo> info = DeviceInfo::tryParse(data, len);
+        if (!info)
+        {
+            return info.error();
+        }
+        MatterResult<std::string> sharedKey = MatterTunnel::sharedKeyFromBytes(gatewayKey_, info.value().publicKey);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+
+        auto entry = std::make_shared<DeviceEntry>();
+        entry->info = std::move(info).value();
+        entry->publicKeyHex = MatterTunnel::bytesToHex(entry->info.publicKey, 65);
+        entry->sharedKey = std::move(sharedKey).value();
+        entry->data.assign(data, data + len);
+
+        update(keyOf(data), [&](Table &table) {
+            table[keyOf(data)] = entry;
+            return true;
+        });
+        return EntryPtr(entry);
+    }
+
+    bool remove(const unsigned char compressedKey[33])
+    {
+        return update(keyOf(compressedKey), [&](Table &table) { return table.erase(keyOf(compressedKey)) != 0; });
+    }
+
+    // 압축 공개키(33바이트)로 조회 (없으면 nullptr)
+    EntryPtr find(const unsigned char compressedKey[33]) const noexcept
+    {
+        Key key = keyOf(compressedKey);
+        Shard &shard = shardOf(key);
+
+        unsigned epoch = enter(shard);
+        const Table *table = shard.table.load();
+        auto it = table->find(key);
+        EntryPtr entry = it == table->end() ? nullptr : it->second;
+        leave(shard, epoch);
+        return entry;
+    }
+
+    // 모든 항목에 visit(EntryPtr) 호출 (샤드별 시점의 항목, 호출 중 변경은 반영되지 않을 수 있음)
+    template <typename Visit>
+    void forEach(Visit visit) const
+    {
+        std::vector<EntryPtr> entries;
+        for (size_t i = 0; i < shardCount_; i++)
+        {
+            Shard &shard = shards_[i];
+            entries.clear();
+            unsigned epoch = enter(shard);
+            const Table *table = shard.table.load();
+            entries.reserve(table->size());
+            for (const auto &item : *table)
+            {
+                entries.push_back(item.second);
+            }
+            leave(shard, epoch);
+
+            for (const EntryPtr &entry : entries)
+            {
+                visit(entry);
+            }
+        }
+    }
+
+    // 비압축 공개키(65바이트)로 조회
+    EntryPtr findUncompressed(const unsigned char publicKey[65]) const noexcept
+    {
+        unsigned char compressed[33];
+        MatterTunnel::compressPublicKey(publicKey, compressed);
+        return find(compressed);
+    }
+
+    size_t size() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+    // 헤더의 공개키로 보낸 디바이스를 찾아 추출 (등록되지 않았으면 ECDH 없이 UnknownDevice)
+    std::string extractTXData(const std::vector<unsigned char> &txBytes) const
+    {
+        return tryExtractTXData(txBytes.data(), txBytes.size()).unwrap();
+    }
+
+    MatterResult<std::string> tryExtractTXData(const unsigned char *txBytes, size_t txLen) const
+    {
+        // 최소 크기: signature(64) + funcName(18) + [format(1) [+ 수신자 힌트(8)]] + compressed pubkey(33) + timestamp(8)
+        if (txLen < 64 + 59)
+        {
+            return MatterError::InvalidTXSize;
+        }
+        size_t keyOffset = MatterTunnel::txKeyOffset(txBytes + 64);
+        if (keyOffset == 0)
+        {
+            return MatterError::UnsupportedTXFormat;
+        }
+        if (txLen < 64 + keyOffset + 33 + 8)
+        {
+            return MatterError::InvalidTXSize;
+        }
+        EntryPtr source = find(txBytes + 64 + keyOffset);
+        if (!source)
+        {
+            return MatterError::UnknownDevice;
+        }
+        return MatterTunnel::tryExtractTXData(*source, txBytes, txLen);
+    }
+
+    // 등록된 디바이스로 보내는 TX (게이트웨이 키로 서명, 캐시된 공유키로 암호화)
+    std::vector<unsigned char> makeTX(const std::string &funcName, const DeviceEntry &dest,
+                                      const std::vector<std::string> &data_list) const
+    {
+        return tryMakeTX(funcName, dest, data_list).unwrap();
+    }
+
+    MatterResult<std::vector<unsigned char>> tryMakeTX(const std::string &funcName, const DeviceEntry &dest,
+                                                       const std::vector<std::string> &data_list,
+                                                       unsigned char format = MatterTunnel::TX_FORMAT_LEGACY) const
+    {
+        return MatterTunnel::tryMakeTX(funcName, gatewayKey_, dest, data_list, format);
+    }
+
+private:
+    using Key = std::array<unsigned char, 33>;
+
+    // 압축 공개키의 x 좌표는 고르게 분포하므로 바이트를 그대로 해시값/샤드 번호로 사용
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const noexcept
+        {
+            uint64_t h;
+            std::memcpy(&h, key.data() + 1, sizeof(h));
+            return static_cast<size_t>(h);
+        }
+    };
+
+    using Table = std::unordered_map<Key, EntryPtr, KeyHash>;
+
+    struct alignas(64) Shard
+    {
+        std::atomic<const Table *> table{new Table()};
+        std::atomic<unsigned> epoch{0};
+        std::atomic<uint64_t> readers[2] = {};
+        std::mutex writeMutex;
+    };
+
+    static Key keyOf(const unsigned char *compressedKey) noexcept
+    {
+        Key key;
+        std::memcpy(key.data(), compressedKey, key.size());
+        return key;
+    }
+
+    Shard &shardOf(const Key &key) const noexcept
+    {
+        uint32_t h;
+        std::memcpy(&h, key.data() + 9, sizeof(h));
+        return shards_[h & (shardCount_ - 1)];
+    }
+
+    // 조회 구간 시작: 현재 epoch의 카운터를 올리고, 그 사이 epoch가 바뀌었으면 다시 시도
+    static unsigned enter(Shard &shard) noexcept
+    {
+        for (;;)
+        {
+            unsigned epoch = shard.epoch.load();
+            shard.readers[epoch & 1].fetch_add(1);
+            if (shard.epoch.load() == epoch)
+            {
+                return epoch;
+            }
+            shard.readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    static void leave(Shard &shard, unsigned epoch) noexcept
+    {
+        shard.readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+    }
+
+    template <typename Modify>
+    bool update(const Key &key, Modify modify)
+    {
+        return updateShard(shardOf(key), modify);
+    }
+
+    // 샤드 테이블을 복사해 modify로 고친 뒤 교체 (modify가 false면 바뀐 것이 없으므로 버림)
+    template <typename Modify>
+    bool updateShard(Shard &shard, Modify modify)
+    {
+        std::lock_guard<std::mutex> lock(shard.writeMutex);
+
+        const Table *old = shard.table.load();
+        std::unique_ptr<Table> next(new Table(*old));
+        if (!modify(*next))
+        {
+            return false;
+        }
+        count_.fetch_add(next->size() - old->size(), std::memory_order_relaxed); // 삭제면 wrap-around로 감소
+        shard.table.store(next.release());
+
+        // 이전 epoch로 테이블을 읽는 중인 조회가 끝날 때까지 대기
+        unsigned epoch = shard.epoch.load();
+        shard.epoch.store(epoch + 1);
+        while (shard.readers[epoch & 1].load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+        delete old;
+        return true;
+    }
+
+    // 이미 만든 항목을 한꺼번에 등록 (샤드마다 테이블 복사 한 번)
+    void insertAll(const std::vector<EntryPtr> &entries)
+    {
+        std::vector<std::vector<const EntryPtr *>> groups(shardCount_);
+        for (const EntryPtr &entry : entries)
+        {
+            groups[&shardOf(keyOf(entry->info.compressedKey)) - shards_.get()].push_back(&entry);
+        }
+        for (size_t i = 0; i < shardCount_; i++)
+        {
+            if (groups[i].empty())
+            {
+                continue;
+            }
+            updateShard(shards_[i], [&](Table &table) {
+                table.reserve(table.size() + groups[i].size());
+                for (const EntryPtr *entry : groups[i])
+                {
+                    table[keyOf((*entry)->info.compressedKey)] = *entry;
+                }
+                return true;
+            });
+        }
+    }
+
+    std::string gatewayKey_;
+    size_t shardCount_ = 0;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<size_t> count_{0};
+};
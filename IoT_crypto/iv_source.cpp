@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#if !defined(__EMSCRIPTEN__)
+#include <pthread.h>
+#endif
+#include "./crypto_backend.cpp"
+
+// 스레드별 버퍼링 IV/nonce 소스
+// 시스템 난수로 시드한 AES-256-CTR 키스트림을 한 번에 버퍼 단위로 생성해
+// 메시지마다 전역 RNG(및 잠금)를 거치지 않도록 한다.
+// - 버퍼를 채울 때마다 키스트림 끝 48바이트로 키/카운터를 갱신 (이전 출력 역추적 방지)
+// - reseedBytes 만큼 출력하면 시스템 난수로 재시드
+// - fork 후 자식 프로세스에서는 첫 호출 시 재시드 (부모와 같은 스트림 재사용 방지)
+class IVSource
+{
+public:
+    // 설정 변경은 각 스레드의 다음 재시드부터 적용
+    static void configure(size_t bufferSize, uint64_t reseedBytes)
+    {
+        bufferSize_.store(bufferSize < 64 ? 64 : bufferSize);
+        reseedBytes_.store(reseedBytes);
+        // 현재 스트림도 즉시 재시드하도록 세대 증가
+        generation_.fetch_add(1);
+    }
+
+    // RAND_bytes와 같은 규약: 성공 시 1, 실패 시 0
+    static int fill(unsigned char *out, size_t len)
+    {
+        State &state = threadState();
+
+        // fork/설정 변경 이후에는 남은 버퍼를 버리고 재시드
+        if (state.generation != generation_.load(std::memory_order_relaxed))
+        {
+            state.seeded = false;
+            state.pos = state.buffer.size();
+        }
+
+        while (len > 0)
+        {
+            if (state.pos == state.buffer.size() && !state.refill())
+            {
+                return 0;
+            }
+
+            size_t n = std::min(len, state.buffer.size() - state.pos);
+            std::memcpy(out, state.buffer.data() + state.pos, n);
+            // 내보낸 바이트는 버퍼에서 지움
+            CryptoBackend::cleanse(state.buffer.data() + state.pos, n);
+            state.pos += n;
+            out += n;
+            len -= n;
+        }
+        return 1;
+    }
+
+private:
+    struct State
+    {
+        CryptoBackend::Cipher cipher;
+        std::vector<unsigned char> buffer;
+        size_t pos = 0;
+        uint64_t sinceReseed = 0;
+        uint64_t generation = 0;
+        pid_t pid = 0;
+        bool seeded = false;
+
+        ~State()
+        {
+            CryptoBackend::cleanse(buffer.data(), buffer.size());
+        }
+
+        // 키(32) + 카운터(16)로 CTR 컨텍스트 초기화
+        bool rekey(const unsigned char *seed)
+        {
+            return cipher.init(CryptoBackend::Cipher::CTR, true, seed, seed + 32);
+        }
+
+        bool reseed()
+        {
+            unsigned char seed[48];
+            if (!CryptoBackend::randomBytes(seed, sizeof(seed)))
+            {
+                return false;
+            }
+            bool ok = rekey(seed);
+            CryptoBackend::cleanse(seed, sizeof(seed));
+
+            buffer.assign(bufferSize_.load(), 0);
+            pos = buffer.size();
+            sinceReseed = 0;
+            generation = generation_.load();
+            pid = getpid();
+            seeded = ok;
+            return ok;
+        }
+
+        bool refill()
+        {
+            if (!seeded || pid != getpid() || generation != generation_.load() ||
+                sinceReseed >= reseedBytes_.load())
+            {
+                if (!reseed())
+                {
+                    return false;
+                }
+            }
+
+            // 버퍼 + 다음 키/카운터(48바이트)를 한 번에 생성
+            std::vector<unsigned char> stream(buffer.size() + 48, 0);
+            size_t len = 0;
+            if (!cipher.update(stream.data(), stream.size(), stream.data(), len))
+            {
+                seeded = false;
+                return false;
+            }
+
+            std::memcpy(buffer.data(), stream.data(), buffer.size());
+            bool ok = rekey(stream.data() + buffer.size());
+            CryptoBackend::cleanse(stream.data(), stream.size());
+            if (!ok)
+            {
+                seeded = false;
+                return false;
+            }
+
+            pos = 0;
+            sinceReseed += buffer.size();
+            return true;
+        }
+    };
+
+    static State &threadState()
+    {
+#if !defined(__EMSCRIPTEN__)
+        static const int atforkRegistered =
+            pthread_atfork(nullptr, nullptr, []() { generation_.fetch_add(1); });
+        (void)atforkRegistered;
+#endif
+        thread_local State state;
+        return state;
+    }
+
+    static inline std::atomic<size_t> bufferSize_{4096};
+    static inline std::atomic<uint64_t> reseedBytes_{1ULL << 20};
+    static inline std::atomic<uint64_t> generation_{0};
+};
@@ -0,0 +1,79 @@
+// embind API와 raw export의 호출 비용 비교 (Node)
+//
+//   node js/bench_call_overhead.mjs [모듈 경로] [반복 횟수]
+//
+// 모듈은 -sMODULARIZE -sEXPORT_ES6 -sEXPORTED_RUNTIME_METHODS=HEAPU8 로 빌드한 ES 모듈이어야 한다.
+import path from 'node:path';
+import { pathToFileURL } from 'node:url';
+import { MatterTunnelRaw, hexToBytes } from './matter_tunnel_raw.mjs';
+
+const modulePath = path.resolve(process.argv[2] ?? 'matter_tunnel.mjs');
+const iterations = Number(process.argv[3] ?? 2000);
+
+const { default: factory } = await import(pathToFileURL(modulePath).href);
+const Module = await factory();
+const MT = Module.MatterTunnel;
+const raw = new MatterTunnelRaw(Module);
+
+// 테스트 데이터
+const alicePriv = MT.generatePrivateKey();
+const alicePub = MT.derivePublicKey(alicePriv);
+const bobPriv = MT.generatePrivateKey();
+const bobPub = MT.derivePublicKey(bobPriv);
+const sharedKey = MT.getSharedKey(alicePriv, bobPub);
+const message = 'x'.repeat(64);
+const signature = MT.sign(message, alicePriv);
+const encrypted = MT.encrypt(sharedKey, message);
+const tx = MT.makeTX('setLED', alicePriv, bobPub, ['1', 'true']).slice();
+
+const rawAlicePriv = hexToBytes(alicePriv);
+const rawAlicePub = hexToBytes(alicePub);
+const rawBobPriv = hexToBytes(bobPriv);
+const rawBobPub = hexToBytes(bobPub);
+const rawSharedKey = hexToBytes(sharedKey);
+const rawSignature = hexToBytes(signature);
+const rawEncrypted = hexToBytes(encrypted);
+
+function bench(name, fn) {
+    for (let i = 0; i < Math.min(100, iterations); i++) fn(); // warm-up
+    const start = process.hrtime.bigint();
+    for (let i = 0; i < iterations; i++) fn();
+    const elapsed = Number(process.hrtime.bigint() - start) / 1e3;
+    return { name, usPerCall: elapsed / iterations };
+}
+
+const cases = [
+    ['sign', () => MT.sign(message, alicePriv), () => raw.sign(message, rawAlicePriv)],
+    ['verify', () => MT.verify(signature, message, alicePub), () => raw.verify(rawSignature, message, rawAlicePub)],
+    ['encrypt', () => MT.encrypt(sharedKey, message), () => raw.encrypt(rawSharedKey, message)],
+    ['decrypt', () => MT.decrypt(sharedKey, encrypted), () => raw.decrypt(rawSharedKey, rawEncrypted)],
+    ['makeTX', () => MT.makeTX('setLED', alicePriv, bobPub, ['1', 'true']),
+        () => raw.makeTX('setLED', rawAlicePriv, rawBobPub, ['1', 'true'])],
+    ['extractTXData', () => MT.extractTXData(bobPriv, tx), () => raw.extractTXData(rawBobPriv, tx)],
+];
+
+// 배치: 항목당 비용 (경계 통과 1회에 batchSize개)
+const batchSize = 256;
+const batchTXs = Array.from({ length: batchSize }, () => tx);
+const batchItems = Array.from({ length: batchSize }, () => ({ signature: rawSignature, message, publicKey: rawAlicePub }));
+const batchIterations = Math.max(1, Math.floor(iterations / batchSize));
+
+function benchBatch(fn) {
+    fn(); // warm-up
+    const start = process.hrtime.bigint();
+    for (let i = 0; i < batchIterations; i++) fn();
+    return Number(process.hrtime.bigint() - start) / 1e3 / (batchIterations * batchSize);
+}
+
+console.log(`iterations: ${iterations}`);
+console.log('function        embind(us)   raw(us)   saved(us)');
+for (const [name, viaEmbind, viaRaw] of cases) {
+    const a = bench(name, viaEmbind);
+    const b = bench(name, viaRaw);
+    console.log(`${name.padEnd(15)} ${a.usPerCall.toFixed(2).padStart(10)} ${b.usPerCall.toFixed(2).padStart(9)} ` +
+        `${(a.usPerCall - b.usPerCall).toFixed(2).padStart(11)}`);
+}
+
+console.log(`\nbatch of ${batchSize}   per-item(us)`);
+console.log(`extractTXData   ${benchBatch(() => raw.extractTXDataBatch(rawBobPriv, batchTXs)).toFixed(2).padStart(10)}`);
+console.log(`verify          ${benchBatch(() => raw.verifyBatch(batchItems)).toFixed(2).padStart(10)}`);
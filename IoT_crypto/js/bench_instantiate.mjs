@@ -0,0 +1,62 @@
+// WASM 빌드 변형별 모듈 크기와 컴파일/인스턴스화 시간 (Node)
+//
+//   node js/bench_instantiate.mjs [빌드 디렉터리] [반복 횟수]
+//
+// build_wasm.sh 결과물(dist/*.mjs + *.wasm)을 대상으로 한다.
+//   raw/gzip   .wasm 파일 크기 (전송량 기준은 gzip)
+//   compile    WebAssembly.compile (바이트 -> Module), 콜드 스타트의 대부분
+//   init       모듈 팩토리 호출 전체 (컴파일 + 인스턴스화 + 런타임 초기화)
+//   first op   generatePrivateKey + sign 첫 호출 (지연 초기화 포함)
+import fs from 'node:fs';
+import path from 'node:path';
+import zlib from 'node:zlib';
+import { pathToFileURL } from 'node:url';
+
+const dir = path.resolve(process.argv[2] ?? 'dist');
+const iterations = Number(process.argv[3] ?? 10);
+
+const median = (values) => {
+    const sorted = [...values].sort((a, b) => a - b);
+    return sorted[Math.floor(sorted.length / 2)];
+};
+
+const now = () => Number(process.hrtime.bigint()) / 1e6;
+
+// pthreads 변형은 워커가 필요하므로 제외
+const variants = fs.readdirSync(dir).filter((f) => f.endsWith('.mjs') && !f.includes('-mt')).sort();
+
+console.log('variant                          raw(KB)  gzip(KB)  compile(ms)  init(ms)  first op(ms)');
+for (const file of variants) {
+    const wasmPath = path.join(dir, file.replace(/\.mjs$/, '.wasm'));
+    if (!fs.existsSync(wasmPath)) continue;
+
+    const bytes = fs.readFileSync(wasmPath);
+    const gzip = zlib.gzipSync(bytes, { level: 9 }).length;
+
+    const compileTimes = [];
+    for (let i = 0; i < iterations; i++) {
+        const start = now();
+        await WebAssembly.compile(bytes);
+        compileTimes.push(now() - start);
+    }
+
+    // ES 모듈 캐시를 피하도록 쿼리 문자열을 바꿔 매번 새로 로드
+    const initTimes = [];
+    const firstOpTimes = [];
+    for (let i = 0; i < iterations; i++) {
+        const url = `${pathToFileURL(path.join(dir, file)).href}?run=${i}`;
+        const start = now();
+        const { default: factory } = await import(url);
+        const Module = await factory();
+        initTimes.push(now() - start);
+
+        const opStart = now();
+        const MT = Module.MatterTunnel;
+        MT.sign('hello', MT.generatePrivateKey());
+        firstOpTimes.push(now() - opStart);
+    }
+
+    console.log(`${file.padEnd(32)} ${(bytes.length / 1024).toFixed(1).padStart(7)} ${(gzip / 1024).toFixed(1).padStart(9)} ` +
+        `${median(compileTimes).toFixed(2).padStart(12)} ${median(initTimes).toFixed(2).padStart(9)} ` +
+        `${median(firstOpTimes).toFixed(2).padStart(13)}`);
+}
@@ -0,0 +1,89 @@
+// 실행 환경에 맞는 WASM 빌드 변형 선택 (build_wasm.sh 참고)
+//
+//   import { loadMatterTunnel } from './loader.mjs';
+//   const Module = await loadMatterTunnel({ baseUrl: '/dist/' });
+//   const MT = Module.MatterTunnel;
+//
+// UI 스레드를 막지 않으려면 createMatterTunnelWorker()로 워커에서 실행할 것.
+// pthreads 변형은 배치 호출 동안 호출한 스레드가 대기하므로 메인 스레드에서는 쓰지 않는 편이 좋다.
+
+// i32.const 0; i8x16.splat; i8x16.popcnt 로 된 최소 모듈 (SIMD 미지원이면 검증 실패)
+const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+export function detectFeatures() {
+    const simd = WebAssembly.validate(SIMD_PROBE);
+
+    // SharedArrayBuffer + 공유 메모리 생성 가능 + (브라우저라면) cross-origin isolated
+    let threads = typeof SharedArrayBuffer !== 'undefined' && globalThis.crossOriginIsolated !== false;
+    if (threads) {
+        try {
+            new WebAssembly.Memory({ initial: 1, maximum: 1, shared: true });
+        } catch {
+            threads = false;
+        }
+    }
+    return { simd, threads };
+}
+
+// backend: 'openssl' (기본) 또는 'compact' (소형 백엔드, 모바일 콜드 스타트용)
+export function selectVariant({ simd, threads } = detectFeatures(), backend = 'openssl') {
+    const base = backend === 'compact' ? 'matter_tunnel.compact' : 'matter_tunnel';
+    if (simd && threads) return `${base}.simd-mt.mjs`;
+    if (simd) return `${base}.simd.mjs`;
+    return `${base}.mjs`;
+}
+
+// options.baseUrl: 빌드 결과 디렉터리 (기본: 이 파일 기준 ../dist/)
+// options.backend: 'openssl' | 'compact'
+// options.variant: 강제로 사용할 파일 이름
+export async function loadMatterTunnel(options = {}) {
+    const baseUrl = new URL(options.baseUrl ?? '../dist/', import.meta.url);
+    const variant = options.variant ?? selectVariant(detectFeatures(), options.backend);
+    const { default: factory } = await import(new URL(variant, baseUrl).href);
+    const Module = await factory(options.moduleArgs ?? {});
+    Module.variant = variant;
+    return Module;
+}
+
+// 워커에서 모듈을 실행하는 비동기 프록시 (브라우저 전용)
+//   const mt = createMatterTunnelWorker();
+//   const valid = await mt.call('verifyBatch', signatures, messages, publicKeys);
+export function createMatterTunnelWorker(options = {}) {
+    const worker = new Worker(new URL('./matter_tunnel_worker.mjs', import.meta.url), { type: 'module' });
+    const pending = new Map();
+    let nextId = 0;
+
+    worker.onmessage = ({ data }) => {
+        const entry = pending.get(data.id);
+        if (!entry) return;
+        pending.delete(data.id);
+        if (data.error !== undefined) entry.reject(new Error(data.error));
+        else entry.resolve(data.result);
+    };
+
+    const ready = new Promise((resolve, reject) => {
+        pending.set(-1, { resolve, reject });
+        worker.postMessage({
+            id: -1,
+            init: { baseUrl: options.baseUrl, backend: options.backend, variant: options.variant },
+        });
+    });
+
+    return {
+        ready, // 로드된 변형 이름으로 resolve
+        call(method, ...args) {
+            return ready.then(() => new Promise((resolve, reject) => {
+                const id = nextId++;
+                pending.set(id, { resolve, reject });
+                worker.postMessage({ id, method, args });
+            }));
+        },
+        terminate() {
+            worker.terminate();
+            for (const { reject } of pending.values()) reject(new Error('worker terminated'));
+            pending.clear();
+        },
+    };
+}
@@ -0,0 +1,169 @@
+// wasm_matter_tunnel.cpp의 extern "C" raw export 래퍼
+// embind의 std::string(16진수) 변환 없이 WASM 힙 포인터 + 길이로 호출한다.
+//
+// 키는 바이트 형식: 개인키 32, 공유키 32, 공개키 33(압축) 또는 65(비압축)
+// 바이트 결과(encrypt/decrypt/makeTX)는 WASM 힙의 결과 버퍼를 가리키는 뷰이며
+// 다음 raw 호출 전까지만 유효하다. 보관하려면 slice()로 복사할 것.
+//
+// 빌드 시 필요한 옵션: -sEXPORTED_RUNTIME_METHODS=HEAPU8 (mt_* 함수는 EMSCRIPTEN_KEEPALIVE로 export됨)
+
+const encoder = new TextEncoder();
+const decoder = new TextDecoder();
+
+const toBytes = (value) => (typeof value === 'string' ? encoder.encode(value) : value);
+
+export class MatterTunnelRaw {
+    constructor(Module) {
+        this.M = Module;
+        this.scratchPtr = 0;
+        this.scratchSize = 0;
+    }
+
+    // 입력들을 scratch 영역에 연속 배치 (의도된 복사 1회), 각 입력의 포인터 반환
+    _stage(parts, extra = 0) {
+        const total = parts.reduce((sum, part) => sum + part.length, 0) + extra;
+        if (total > this.scratchSize) {
+            if (this.scratchPtr) this.M._mt_free(this.scratchPtr);
+            this.scratchSize = Math.max(total, this.scratchSize * 2, 4096);
+            this.scratchPtr = this.M._mt_alloc(this.scratchSize);
+        }
+
+        const heap = this.M.HEAPU8;
+        const ptrs = [];
+        let offset = this.scratchPtr;
+        for (const part of parts) {
+            heap.set(part, offset);
+            ptrs.push(offset);
+            offset += part.length;
+        }
+        ptrs.push(offset); // extra 영역 (출력용)
+        return ptrs;
+    }
+
+    _result(length, what) {
+        if (length < 0) throw new Error(`${what} failed (${length})`);
+        const ptr = this.M._mt_result();
+        return this.M.HEAPU8.subarray(ptr, ptr + length);
+    }
+
+    sign(message, privateKey) {
+        const msg = toBytes(message);
+        const [msgPtr, privPtr, outPtr] = this._stage([msg, privateKey], 64);
+        const rc = this.M._mt_sign(msgPtr, msg.length, privPtr, outPtr);
+        if (rc < 0) throw new Error(`sign failed (${rc})`);
+        return this.M.HEAPU8.slice(outPtr, outPtr + 64);
+    }
+
+    verify(signature, message, publicKey) {
+        const msg = toBytes(message);
+        const [sigPtr, msgPtr, pubPtr] = this._stage([signature, msg, publicKey]);
+        const rc = this.M._mt_verify(sigPtr, msgPtr, msg.length, pubPtr, publicKey.length);
+        if (rc < 0) throw new Error(`verify failed (${rc})`);
+        return rc === 1;
+    }
+
+    encrypt(sharedKey, message) {
+        const msg = toBytes(message);
+        const [keyPtr, msgPtr] = this._stage([sharedKey, msg]);
+        return this._result(this.M._mt_encrypt(keyPtr, msgPtr, msg.length), 'encrypt');
+    }
+
+    decrypt(sharedKey, encrypted) {
+        const [keyPtr, encPtr] = this._stage([sharedKey, encrypted]);
+        return this._result(this.M._mt_decrypt(keyPtr, encPtr, encrypted.length), 'decrypt');
+    }
+
+    makeTX(funcName, srcPriv, destPub, dataList) {
+        const name = encoder.encode(funcName);
+        // TX payload와 같은 직렬화 형식: 길이(1바이트) + 데이터
+        const items = dataList.map(toBytes);
+        const packed = new Uint8Array(items.reduce((sum, item) => sum + 1 + item.length, 0));
+        let offset = 0;
+        for (const item of items) {
+            if (item.length > 255) throw new Error('data item too long');
+            packed[offset++] = item.length;
+            packed.set(item, offset);
+            offset += item.length;
+        }
+
+        const [namePtr, privPtr, pubPtr, dataPtr] = this._stage([name, srcPriv, destPub, packed]);
+        return this._result(
+            this.M._mt_makeTX(namePtr, name.length, privPtr, pubPtr, destPub.length, dataPtr, packed.length),
+            'makeTX');
+    }
+
+    extractTXData(privateKey, tx) {
+        const [keyPtr, txPtr] = this._stage([privateKey, tx]);
+        return decoder.decode(this._result(this.M._mt_extractTXData(keyPtr, txPtr, tx.length), 'extractTXData'));
+    }
+
+    // 배치 API: 경계 통과 1회로 여러 항목 처리
+    // 결과는 [{ ok, json | error }], 항목별 실패는 예외 대신 ok: false
+    extractTXDataBatch(privateKey, txs) {
+        const packed = packLengthPrefixed(txs);
+        const [keyPtr, txsPtr, statusPtr] = this._stage([privateKey, packed], txs.length * 4 + 3);
+        const aligned = (statusPtr + 3) & ~3;
+        const length = this.M._mt_extractTXDataBatch(keyPtr, txsPtr, packed.length, txs.length, aligned);
+        const status = new Int32Array(this.M.HEAPU8.buffer, aligned, txs.length).slice();
+        const texts = unpackLengthPrefixed(this._result(length, 'extractTXDataBatch'));
+        return texts.map((text, i) => (status[i] === 0 ? { ok: true, json: text } : { ok: false, error: text }));
+    }
+
+    // items: [{ signature, message, publicKey }], 결과는 boolean 배열
+    verifyBatch(items) {
+        const parts = [];
+        for (const { signature, message, publicKey } of items) {
+            const msg = toBytes(message);
+            const head = new Uint8Array(65 + publicKey.length + 4);
+            head.set(signature, 0);
+            head[64] = publicKey.length;
+            head.set(publicKey, 65);
+            new DataView(head.buffer).setUint32(65 + publicKey.length, msg.length, true);
+            parts.push(head, msg);
+        }
+        const packed = concat(parts);
+        const [packedPtr, statusPtr] = this._stage([packed], items.length * 4 + 3);
+        const aligned = (statusPtr + 3) & ~3;
+        const rc = this.M._mt_verifyBatch(packedPtr, packed.length, items.length, aligned);
+        if (rc < 0) throw new Error(`verifyBatch failed (${rc})`);
+        return Array.from(new Int32Array(this.M.HEAPU8.buffer, aligned, items.length), (s) => s === 1);
+    }
+}
+
+const concat = (parts) => {
+    const out = new Uint8Array(parts.reduce((sum, part) => sum + part.length, 0));
+    let offset = 0;
+    for (const part of parts) {
+        out.set(part, offset);
+        offset += part.length;
+    }
+    return out;
+};
+
+// 길이(4바이트 LE) + 데이터의 연속
+const packLengthPrefixed = (items) => {
+    const out = new Uint8Array(items.reduce((sum, item) => sum + 4 + item.length, 0));
+    const view = new DataView(out.buffer);
+    let offset = 0;
+    for (const item of items) {
+        view.setUint32(offset, item.length, true);
+        out.set(item, offset + 4);
+        offset += 4 + item.length;
+    }
+    return out;
+};
+
+const unpackLengthPrefixed = (bytes) => {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const items = [];
+    for (let offset = 0; offset < bytes.length;) {
+        const length = view.getUint32(offset, true);
+        items.push(decoder.decode(bytes.subarray(offset + 4, offset + 4 + length)));
+        offset += 4 + length;
+    }
+    return items;
+};
+
+// 16진수 <-> 바이트 변환 (embind API와 섞어 쓸 때)
+export const hexToBytes = (hex) => Uint8Array.from(hex.match(/../g) ?? [], (byte) => parseInt(byte, 16));
+export const bytesToHex = (bytes) => Array.from(bytes, (byte) => byte.toString(16).padStart(2, '0')).join('');
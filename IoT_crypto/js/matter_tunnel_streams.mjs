@@ -0,0 +1,52 @@
+// WHATWG TransformStream 어댑터 (wasm_matter_tunnel.cpp의 Encryptor/Decryptor 사용)
+// 청크를 받는 대로 WASM에 넘기므로 JS와 WASM 힙 어느 쪽에도 전체 payload가 쌓이지 않는다.
+//
+//   const Module = await loadMatterTunnel();
+//   const plain = response.body.pipeThrough(createDecryptStream(Module, sharedKey));
+//
+// 출력 형식은 MatterTunnel.encrypt와 같다: IV(16) + AES-256-CBC 암호문 (16진수가 아닌 바이트)
+
+function createCipherStream(Cipher, sharedKey) {
+    let cipher = null;
+    const release = () => {
+        if (cipher) {
+            cipher.delete();
+            cipher = null;
+        }
+    };
+
+    return new TransformStream({
+        start() {
+            cipher = new Cipher(sharedKey);
+        },
+        transform(chunk, controller) {
+            try {
+                const out = cipher.update(chunk);
+                // WASM 힙 뷰는 다음 호출에서 덮어쓰이므로 복사해서 내보냄
+                if (out.length > 0) controller.enqueue(out.slice());
+            } catch (e) {
+                release();
+                throw e;
+            }
+        },
+        flush(controller) {
+            try {
+                const out = cipher.finalize();
+                if (out.length > 0) controller.enqueue(out.slice());
+            } finally {
+                release();
+            }
+        },
+        cancel() {
+            release();
+        },
+    });
+}
+
+export function createEncryptStream(Module, sharedKey) {
+    return createCipherStream(Module.Encryptor, sharedKey);
+}
+
+export function createDecryptStream(Module, sharedKey) {
+    return createCipherStream(Module.Decryptor, sharedKey);
+}
@@ -0,0 +1,24 @@
+// loader.mjs의 createMatterTunnelWorker()가 띄우는 워커
+// MatterTunnel의 class_function을 이름으로 호출하고 결과를 돌려준다.
+import { loadMatterTunnel } from './loader.mjs';
+
+let MT = null;
+
+self.onmessage = async ({ data }) => {
+    const { id } = data;
+    try {
+        if (data.init) {
+            const Module = await loadMatterTunnel(data.init);
+            MT = Module.MatterTunnel;
+            self.postMessage({ id, result: Module.variant });
+            return;
+        }
+
+        let result = MT[data.method](...data.args);
+        // WASM 힙 뷰는 다음 호출에서 덮어쓰이므로 복사해서 전달
+        if (result instanceof Uint8Array) result = result.slice();
+        self.postMessage({ id, result });
+    } catch (e) {
+        self.postMessage({ id, error: String(e?.message ?? e) });
+    }
+};
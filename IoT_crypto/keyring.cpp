@@ -0,0 +1,295 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include "./matter_tunnel.cpp"
+
+// 여러 개인키를 가진 게이트웨이의 TX 디코더
+// 수신자 힌트(TX_FLAG_DEST_HINT)가 있는 TX는 힌트 -> 개인키 표에서 키를 바로 고른다 (없으면 UnknownRecipient).
+// 힌트가 없는 기존 TX는 최대 maxTrials개 키로 시험 복호화한다.
+//   - 보낸 디바이스의 공개키 -> 마지막으로 성공한 키를 기억해 두고 그 키부터 시도한다.
+//   - 기존 형식(CBC)은 패딩과 직렬화 항목 길이가 평문 끝에 정확히 맞아야 성공으로 본다.
+//     (잘못된 키가 통과할 확률은 약 1/256 * 항목 길이가 맞을 확률, 확실히 하려면 힌트를 붙여 보낼 것)
+//   - TX_FORMAT_INDEXED(CTR)는 잘못된 키를 구별할 수 없으므로 기억된 키 또는 키가 하나뿐일 때만 복호화한다.
+// 서명 검증, 공개키 복원은 키 개수와 관계없이 한 번만 수행된다.
+// 조회는 여러 스레드에서 동시에 호출할 수 있다 (add/remove는 쓰기 잠금).
+class Keyring
+{
+public:
+    explicit Keyring(size_t maxTrials = 8) : maxTrials_(maxTrials) {}
+
+    Keyring(const Keyring &) = delete;
+    Keyring &operator=(const Keyring &) = delete;
+
+    ~Keyring()
+    {
+        for (Key &key : keys_)
+        {
+            CryptoBackend::cleanse(&key.privateKey[0], key.privateKey.size());
+        }
+    }
+
+    // 개인키 추가 (이미 있으면 false, 다른 키와 힌트가 겹치면 예외)
+    bool add(const std::string &privateKey)
+    {
+        unsigned char pub[65];
+        MatterError error = MatterTunnel::derivePublicKeyBytes(privateKey, pub);
+        if (error != MatterError::Ok)
+        {
+            throwMatterError(error);
+        }
+        Key key;
+        key.privateKey = privateKey;
+        unsigned char compressed[33];
+        MatterTunnel::compressPublicKey(pub, compressed);
+        MatterTunnel::destHint(compressed, key.hint.data());
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = hints_.find(key.hint);
+        if (it != hints_.end())
+        {
+            if (keys_[it->second].privateKey == privateKey)
+            {
+                return false;
+            }
+            throw std::runtime_error("Destination hint collision");
+        }
+        hints_.emplace(key.hint, keys_.size());
+        keys_.push_back(std::move(key));
+        return true;
+    }
+
+    bool remove(const std::string &privateKey)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (size_t i = 0; i < keys_.size(); i++)
+        {
+            if (keys_[i].privateKey != privateKey)
+            {
+                continue;
+            }
+            CryptoBackend::cleanse(&keys_[i].privateKey[0], keys_[i].privateKey.size());
+            keys_.erase(keys_.begin() + i);
+
+            // 위치가 바뀌었으므로 색인과 기억된 키를 다시 만든다
+            hints_.clear();
+            for (size_t k = 0; k < keys_.size(); k++)
+            {
+                hints_.emplace(keys_[k].hint, k);
+            }
+            std::lock_guard<std::mutex> senderLock(senderMutex_);
+            senders_.clear();
+            return true;
+        }
+        return false;
+    }
+
+    size_t size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return keys_.size();
+    }
+
+    std::string extractTXData(const std::vector<unsigned char> &txBytes) const
+    {
+        return tryExtractTXData(txBytes.data(), txBytes.size()).unwrap();
+    }
+
+    MatterResult<std::string> tryExtractTXData(const unsigned char *txBytes, size_t txLen) const
+    {
+        MatterError error = MatterTunnel::precheckTX(txBytes, txLen);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        const unsigned char *txData = txBytes + 64;
+        size_t txDataLen = txLen - 64;
+        MatterTunnel::TXHeader header;
+        error = MatterTunnel::parseTXHeader(txData, txDataLen, header);
+        if (error == MatterError::Ok)
+        {
+            error = MatterTunnel::checkTXSignature(txBytes, txData, txDataLen, header.srcPubBytes);
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        return open(header, txData, txDataLen);
+    }
+
+    std::string extractTXDataWithoutSign(const std::string &txHex) const
+    {
+        return tryExtractTXDataWithoutSign(txHex).unwrap();
+    }
+
+    MatterResult<std::string> tryExtractTXDataWithoutSign(const std::string &txHex) const
+    {
+        std::vector<unsigned char> txData;
+        if (MatterTunnel::decodeHex(txHex, txData) != MatterError::Ok)
+        {
+            return MatterError::InvalidHex;
+        }
+        if (txData.size() < 59)
+        { // 최소 크기: funcName(18) + compressed pubkey(33) + timestamp(8)
+            return MatterError::InvalidTXSize;
+        }
+        MatterTunnel::TXHeader header;
+        MatterError error = MatterTunnel::parseTXHeader(txData.data(), txData.size(), header);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        return open(header, txData.data(), txData.size());
+    }
+
+private:
+    static constexpr size_t SENDER_CACHE_LIMIT = 4096;
+
+    using Hint = std::array<unsigned char, MatterTunnel::DEST_HINT_SIZE>;
+    using SenderKey = std::array<unsigned char, 33>;
+
+    // 힌트와 압축 공개키는 해시 출력/x 좌표이므로 바이트를 그대로 해시값으로 사용
+    template <typename Bytes, size_t Offset>
+    struct BytesHash
+    {
+        size_t operator()(const Bytes &bytes) const noexcept
+        {
+            uint64_t h;
+            std::memcpy(&h, bytes.data() + Offset, sizeof(h));
+            return static_cast<size_t>(h);
+        }
+    };
+
+    struct Key
+    {
+        std::string privateKey;
+        Hint hint;
+    };
+
+    // 헤더 파싱(과 서명 검증)을 마친 본문의 수신자 키 선택 및 복호화
+    MatterResult<std::string> open(const MatterTunnel::TXHeader &header, const unsigned char *txData,
+                                   size_t len) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        std::vector<std::string> dataList;
+
+        // 1. 수신자 힌트: 표에서 바로 선택
+        if (const unsigned char *hintBytes = MatterTunnel::txDestHint(txData))
+        {
+            Hint hint;
+            std::memcpy(hint.data(), hintBytes, hint.size());
+            auto it = hints_.find(hint);
+            if (it == hints_.end())
+            {
+                return MatterError::UnknownRecipient;
+            }
+            MatterError error = decrypt(keys_[it->second], header, txData, len, dataList);
+            if (error != MatterError::Ok)
+            {
+                return error;
+            }
+            return MatterTunnel::txToJSON(header, dataList);
+        }
+
+        // 2. 기존 TX: 기억된 키부터 최대 maxTrials개 시험 복호화
+        SenderKey sender;
+        std::memcpy(sender.data(), txData + MatterTunnel::txKeyOffset(txData), sender.size());
+        size_t cached = cachedKey(sender);
+        bool indexed = header.format == MatterTunnel::TX_FORMAT_INDEXED;
+        if (indexed && cached == keys_.size() && keys_.size() != 1)
+        {
+            return MatterError::UnknownRecipient;
+        }
+
+        size_t trials = 0;
+        for (size_t n = 0; n <= keys_.size() && trials < maxTrials_; n++)
+        {
+            // n == 0: 기억된 키 (없으면 0번 키부터)
+            size_t i = n == 0 ? cached : n - 1;
+            if (i >= keys_.size() || (n > 0 && i == cached))
+            {
+                continue;
+            }
+            trials++;
+            if (decrypt(keys_[i], header, txData, len, dataList) == MatterError::Ok)
+            {
+                remember(sender, i);
+                return MatterTunnel::txToJSON(header, dataList);
+            }
+            if (indexed)
+            {
+                break;
+            }
+        }
+        return MatterError::UnknownRecipient;
+    }
+
+    // 기존 형식은 패딩 검사 후 항목 길이가 평문 끝에 정확히 맞는지까지 확인 (시험 복호화의 성공 판정)
+    static MatterError decrypt(const Key &key, const MatterTunnel::TXHeader &header, const unsigned char *txData,
+                               size_t len, std::vector<std::string> &dataList)
+    {
+        MatterResult<std::string> sharedKey = MatterTunnel::sharedKeyFromBytes(key.privateKey, header.srcPubBytes);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+        if (header.format == MatterTunnel::TX_FORMAT_INDEXED)
+        {
+            return MatterTunnel::decryptTXPayload(sharedKey.value(), header, txData, len, dataList);
+        }
+
+        MatterResult<std::string> plain = MatterTunnel::tryDecryptBytes(
+            sharedKey.value(), txData + header.payloadOffset, len - header.payloadOffset);
+        if (!plain)
+        {
+            return plain.error();
+        }
+        const std::string &data = plain.value();
+        dataList.clear();
+        size_t pos = 0;
+        while (pos < data.length())
+        {
+            size_t length = static_cast<unsigned char>(data[pos++]);
+            if (pos + length > data.length())
+            {
+                return MatterError::DecryptionFailed;
+            }
+            dataList.emplace_back(data, pos, length);
+            pos += length;
+        }
+        return MatterError::Ok;
+    }
+
+    // 보낸 디바이스가 마지막으로 성공한 키 위치 (없으면 keys_.size())
+    size_t cachedKey(const SenderKey &sender) const
+    {
+        std::lock_guard<std::mutex> lock(senderMutex_);
+        auto it = senders_.find(sender);
+        return it == senders_.end() || it->second >= keys_.size() ? keys_.size() : it->second;
+    }
+
+    void remember(const SenderKey &sender, size_t index) const
+    {
+        std::lock_guard<std::mutex> lock(senderMutex_);
+        if (senders_.size() >= SENDER_CACHE_LIMIT && senders_.find(sender) == senders_.end())
+        {
+            senders_.clear();
+        }
+        senders_[sender] = index;
+    }
+
+    size_t maxTrials_;
+    mutable std::shared_mutex mutex_;
+    std::vector<Key> keys_;
+    std::unordered_map<Hint, size_t, BytesHash<Hint, 0>> hints_;
+
+    mutable std::mutex senderMutex_;
+    mutable std::unordered_map<SenderKey, size_t, BytesHash<SenderKey, 1>> senders_;
+};
@@ -1,6 +1,33 @@
 #include <string>
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <fstream>
 #include "./matter_tunnel.cpp"
+#include "./matter_session.cpp"
+#include "./matter_stream.cpp"
+#include "./typed_function.cpp"
+#include "./rpc_dispatcher.cpp"
+#include "./matter_rpc.cpp"
+#include "./device_registry.cpp"
+#include "./registry_snapshot.cpp"
+#include "./keyring.cpp"
+
+// C++20에서는 using SetLED = Fn<"setLED", void(double, bool)>;
+struct SetLEDName
+{
+    static constexpr const char *value = "setLED";
+};
+using SetLED = TypedFunction<SetLEDName, void(double, bool)>;
+
+struct GetTempName
+{
+    static constexpr const char *value = "getTemp";
+};
+using GetTemp = TypedFunction<GetTempName, double()>;
 
 std::string bytesToHexForTest(const unsigned char *data, size_t len)
 {
@@ -25,6 +52,17 @@ std::vector<unsigned char> hexToBytesForTest(const std::string &hex)
     return bytes;
 }
 
+// 키 쌍의 공개키(압축)와 고정 passcode로 디바이스 데이터 생성, functions는 20바이트 함수 항목들
+std::vector<unsigned char> deviceDataForTest(const MatterTunnel::KeyPair &pair,
+                                             const std::vector<unsigned char> &functions = {})
+{
+    std::vector<unsigned char> pub = hexToBytesForTest(pair.publicKey);
+    std::vector<unsigned char> data(33 + 16, 0x5a);
+    MatterTunnel::compressPublicKey(pub.data(), data.data());
+    data.insert(data.end(), functions.begin(), functions.end());
+    return data;
+}
+
 int main()
 {
     try
@@ -164,6 +202,752 @@ int main()
         std::cerr << "Error: " << e.what() << std::endl;
     }
     
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "세션 모드 테스트" << std::endl;
+
+        std::string alicePrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPublicKey = MatterTunnel::derivePublicKey(bobPrivateKey);
+
+        // 핸드셰이크 (ECDH 1회, 2메시지)
+        std::vector<unsigned char> handshake;
+        std::vector<unsigned char> response;
+        MatterSession alice = MatterSession::initiate(alicePrivateKey, bobPublicKey, handshake);
+        MatterSession bob = MatterSession::accept(bobPrivateKey, handshake, response);
+        alice.complete(response);
+
+        std::vector<unsigned char> tx = alice.makeTX("setLED", {"1", "true"});
+        std::cout << "session TX size: " << tx.size() << std::endl;
+        std::cout << bob.extractTXData(tx) << std::endl;
+        std::cout << alice.extractTXData(bob.makeTX("getTemp", {"23.5"})) << std::endl;
+
+        // 재전송 거부
+        try
+        {
+            bob.extractTXData(tx);
+            std::cout << "replay: 실패 테스트 실패" << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << "replay: 실패 테스트 성공 (" << e.what() << ")" << std::endl;
+        }
+
+        // 핸드셰이크 재전송: 응답자 nonce가 달라 이전 세션키가 다시 만들어지지 않음
+        std::vector<unsigned char> replayResponse;
+        MatterSession replayed = MatterSession::accept(bobPrivateKey, handshake, replayResponse);
+        std::cout << "handshake replay: "
+                  << (std::memcmp(replayed.sessionId(), bob.sessionId(), MatterSession::SESSION_ID_SIZE) != 0
+                          ? "새 세션키 (성공)"
+                          : "같은 세션키 (실패)")
+                  << std::endl;
+
+        // 재협상 (ECDH 없음)
+        alice.complete(bob.acceptRekey(bobPrivateKey, alice.rekey(alicePrivateKey)));
+        std::cout << bob.extractTXData(alice.makeTX("setLED", {"0", "false"})) << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "스트리밍 암호화 테스트" << std::endl;
+
+        std::string sharedKey = MatterTunnel::getSharedKey(MatterTunnel::generatePrivateKey(),
+                                                           MatterTunnel::derivePublicKey(MatterTunnel::generatePrivateKey()));
+
+        // 1MB payload를 4KB 청크로 암호화
+        std::string payload(1 << 20, '\0');
+        for (size_t i = 0; i < payload.size(); i++)
+            payload[i] = static_cast<char>(i * 31 + 7);
+
+        MatterTunnel::Encryptor encryptor(sharedKey);
+        std::vector<unsigned char> encrypted;
+        for (size_t pos = 0; pos < payload.size(); pos += 4096)
+            encryptor.update(payload.substr(pos, 4096), encrypted);
+        encryptor.finalize(encrypted);
+
+        // 스트리밍 출력 -> 기존 decrypt
+        std::string decrypted = MatterTunnel::decrypt(sharedKey, bytesToHexForTest(encrypted.data(), encrypted.size()));
+        std::cout << "stream -> decrypt: " << (decrypted == payload ? "Yes" : "No") << std::endl;
+
+        // 기존 encrypt -> 스트리밍 복호화 (홀수 크기 청크)
+        std::vector<unsigned char> oneShot = hexToBytesForTest(MatterTunnel::encrypt(sharedKey, payload));
+        MatterTunnel::Decryptor decryptor(sharedKey);
+        std::vector<unsigned char> plain;
+        for (size_t pos = 0; pos < oneShot.size(); pos += 1000)
+            decryptor.update(oneShot.data() + pos, std::min<size_t>(1000, oneShot.size() - pos), plain);
+        decryptor.finalize(plain);
+        std::cout << "encrypt -> stream: " << (std::string(plain.begin(), plain.end()) == payload ? "Yes" : "No") << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "선택 복호화 테스트" << std::endl;
+
+        std::string alicePrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPublicKey = MatterTunnel::derivePublicKey(bobPrivateKey);
+
+        std::vector<std::string> data_list = {"route-a", std::string(100000, 'x'), "tail item"};
+        std::vector<unsigned char> tx = MatterTunnel::makeIndexedTX("forward", alicePrivateKey,
+                                                                    bobPublicKey, data_list);
+
+        // 첫 번째 항목만 복호화
+        MatterTunnel::TXRecord record = MatterTunnel::openTX(bobPrivateKey, tx);
+        std::cout << record.funcName() << " items: " << record.size()
+                  << " first: " << record.item(0) << " last: " << record.item(2) << std::endl;
+        std::cout << "items match: " << (record.items() == data_list ? "Yes" : "No") << std::endl;
+
+        // 기존 API로도 디코딩 가능
+        std::string json = MatterTunnel::extractTXData(bobPrivateKey, tx);
+        std::cout << "extractTXData size: " << json.size() << std::endl;
+
+        // 기존 형식 TX도 같은 레코드로 열림
+        MatterTunnel::TXRecord legacy = MatterTunnel::openTX(
+            bobPrivateKey, MatterTunnel::makeTX("legacy", alicePrivateKey, bobPublicKey, {"a", "b"}));
+        std::cout << legacy.funcName() << " " << legacy.item(1) << std::endl;
+
+        // 길이 합이 32비트에서 넘쳐 암호문 길이와 같아지는 길이 표는 거부
+        std::vector<unsigned char> overflow = MatterTunnel::makeIndexedTX(
+            "forward", alicePrivateKey, bobPublicKey, {std::string(16, 'a'), std::string(16, 'b')});
+        const unsigned char lengths[8] = {0xf0, 0xff, 0xff, 0xff, 0x20, 0x00, 0x00, 0x00};
+        std::copy(lengths, lengths + 8, overflow.end() - 32 - 8);
+        try
+        {
+            // 서명 검사가 없는 경로 (서명 64바이트를 뺀 TX)
+            MatterTunnel::extractTXDataWithoutSign(bobPrivateKey,
+                                                   bytesToHexForTest(overflow.data() + 64, overflow.size() - 64));
+            std::cout << "overflowing lengths: 실패" << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << "overflowing lengths: 성공 (" << e.what() << ")" << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "병렬 CBC 복호화 테스트" << std::endl;
+
+        std::string sharedKey = MatterTunnel::getSharedKey(MatterTunnel::generatePrivateKey(),
+                                                           MatterTunnel::derivePublicKey(MatterTunnel::generatePrivateKey()));
+        std::string payload(4 * 1024 * 1024 + 5, '\0');
+        for (size_t i = 0; i < payload.size(); i++)
+            payload[i] = static_cast<char>(i * 13 + 1);
+        std::string encrypted = MatterTunnel::encrypt(sharedKey, payload);
+
+        MatterTunnel::setParallelDecrypt(64 * 1024, 4);
+        std::cout << "parallel: " << (MatterTunnel::decrypt(sharedKey, encrypted) == payload ? "Yes" : "No") << std::endl;
+
+        // 잘못된 패딩은 거부
+        std::vector<unsigned char> tampered = hexToBytesForTest(encrypted);
+        tampered[tampered.size() - 20] ^= 0x01;
+        try
+        {
+            MatterTunnel::decrypt(sharedKey, bytesToHexForTest(tampered.data(), tampered.size()));
+            std::cout << "padding: 실패 테스트 실패" << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << "padding: 실패 테스트 성공 (" << e.what() << ")" << std::endl;
+        }
+
+        // 블록 수가 스레드 수에 비해 적을 때 (청크 수 < 스레드 수)
+        MatterTunnel::setParallelDecrypt(0, 8);
+        bool smallOk = true;
+        for (size_t size : {0, 1, 15, 16, 100, 300})
+        {
+            std::string small = payload.substr(0, size);
+            smallOk = smallOk && MatterTunnel::decrypt(sharedKey, MatterTunnel::encrypt(sharedKey, small)) == small;
+        }
+        std::cout << "small, many threads: " << (smallOk ? "성공" : "실패") << std::endl;
+        MatterTunnel::setParallelDecrypt(1 << 20);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "배치 검증/디코딩 테스트" << std::endl;
+
+        std::string alicePrivateKey = MatterTunnel::generatePrivateKey();
+        std::string alicePublicKey = MatterTunnel::derivePublicKey(alicePrivateKey);
+        std::string bobPrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPublicKey = MatterTunnel::derivePublicKey(bobPrivateKey);
+
+        std::vector<std::string> signatures, messages, publicKeys;
+        std::vector<std::vector<unsigned char>> txs;
+        for (int i = 0; i < 32; i++)
+        {
+            messages.push_back("message " + std::to_string(i));
+            signatures.push_back(MatterTunnel::sign(messages.back(), alicePrivateKey));
+            publicKeys.push_back(alicePublicKey);
+            txs.push_back(MatterTunnel::makeTX("batch", alicePrivateKey, bobPublicKey, {std::to_string(i)}));
+        }
+        messages[5] = "forged";
+        txs[7][100] ^= 0x01;
+
+        std::vector<bool> valid = MatterTunnel::verifyBatch(signatures, messages, publicKeys);
+        std::vector<std::string> decoded = MatterTunnel::extractTXDataBatch(bobPrivateKey, txs);
+        int validCount = 0, decodedCount = 0;
+        for (size_t i = 0; i < valid.size(); i++)
+        {
+            validCount += valid[i];
+            decodedCount += decoded[i].find("\"error\"") == std::string::npos;
+        }
+        std::cout << "verified: " << validCount << "/32, decoded: " << decodedCount << "/32" << std::endl;
+        std::cout << decoded[7] << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "오류 코드 API 테스트" << std::endl;
+
+        std::string alicePrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPrivateKey = MatterTunnel::generatePrivateKey();
+        MatterResult<std::string> bobPublicKey = MatterTunnel::tryDerivePublicKey(bobPrivateKey);
+
+        MatterResult<std::vector<unsigned char>> tx =
+            MatterTunnel::tryMakeTX("setLED", alicePrivateKey, bobPublicKey.value(), {"1", "true"});
+        MatterResult<std::string> json = MatterTunnel::tryExtractTXData(bobPrivateKey, tx.value());
+        std::cout << "ok: " << (json ? json.value() : json.message()) << std::endl;
+
+        tx.value()[70] ^= 0x01;
+        json = MatterTunnel::tryExtractTXData(bobPrivateKey, tx.value());
+        std::cout << "tampered: " << json.message() << std::endl;
+        std::cout << "short sig: " << MatterTunnel::tryVerify("00", "msg", bobPublicKey.value()).message() << std::endl;
+        std::cout << "bad hex: " << MatterTunnel::tryDerivePublicKey("xyz").message() << std::endl;
+
+        // 예외 API는 기존과 같은 메시지를 던짐
+        const std::pair<const char *, std::function<void()>> legacy[] = {
+            {"Failed to create public key point",
+             [&] { MatterTunnel::getSharedKey(alicePrivateKey, "04" + std::string(128, '1')); }},
+            {"Failed to decompress public key",
+             [&] {
+                 std::vector<unsigned char> badKey = MatterTunnel::makeTX("setLED", alicePrivateKey, bobPublicKey.value(), {"1"});
+                 std::fill(badKey.begin() + 64 + 19, badKey.begin() + 64 + 51, 0xff); // x >= p
+                 MatterTunnel::extractTXData(bobPrivateKey, badKey);
+             }},
+            {"Invalid encrypted data length", [&] { MatterTunnel::decrypt("key", "00"); }},
+            {"Failed to finalize decryption", [&] { MatterTunnel::decrypt("key", std::string(64, '0')); }},
+        };
+        for (const auto &test : legacy)
+        {
+            try
+            {
+                test.second();
+                std::cout << test.first << ": 실패 테스트 실패" << std::endl;
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << test.first << ": " << (std::string(e.what()) == test.first ? "성공" : e.what()) << std::endl;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "사전 검사 테스트" << std::endl;
+
+        std::string alicePrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPrivateKey = MatterTunnel::generatePrivateKey();
+        std::string bobPublicKey = MatterTunnel::derivePublicKey(bobPrivateKey);
+        std::vector<unsigned char> tx = MatterTunnel::makeTX("setLED", alicePrivateKey, bobPublicKey, {"1"});
+
+        MatterTunnel::resetPrecheckStats();
+        std::vector<std::vector<unsigned char>> garbage(5, tx);
+        garbage[0].resize(100);                   // 크기
+        garbage[1][64 + 3] = 0x01;                // funcName
+        garbage[2][64 + 18] = 0x05;               // 공개키 prefix
+        std::fill(garbage[3].begin(), garbage[3].begin() + 32, 0xff); // r >= n
+        garbage[4].pop_back();                    // 암호문 길이
+        for (const auto &g : garbage)
+        {
+            std::cout << MatterTunnel::tryExtractTXData(bobPrivateKey, g).message() << std::endl;
+        }
+
+        MatterTunnel::setTimestampWindow(3600, 300);
+        std::cout << MatterTunnel::tryExtractTXData(bobPrivateKey, tx).ok() << std::endl;
+        MatterTunnel::setTimestampWindow(0, 0);
+
+        MatterTunnel::PrecheckStats stats = MatterTunnel::precheckStats();
+        std::cout << "accepted: " << stats.accepted << ", rejected: " << stats.rejected() << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "키 쌍 생성 테스트" << std::endl;
+
+        MatterTunnel::KeyPair pair = MatterTunnel::generateKeyPair();
+        std::cout << "pair: " << (MatterTunnel::derivePublicKey(pair.privateKey) == pair.publicKey ? "Yes" : "No")
+                  << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<MatterTunnel::RawKeyPair> pairs = MatterTunnel::generateKeyPairs(5000);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        const MatterTunnel::RawKeyPair &last = pairs.back();
+        unsigned char check[65];
+        bool match = CryptoBackend::derivePublicKey(last.privateKey, check) &&
+                     std::memcmp(check, last.publicKey, 65) == 0;
+        std::cout << "bulk: " << pairs.size() << " pairs, " << elapsed.count() << " ms, last pair: "
+                  << (match ? "Yes" : "No") << std::endl;
+        CryptoBackend::cleanse(pairs.data(), pairs.size() * sizeof(MatterTunnel::RawKeyPair));
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "디바이스 정보 캐시 테스트" << std::endl;
+
+        MatterTunnel::RawKeyPair device = MatterTunnel::generateKeyPairs(1).front();
+        std::vector<unsigned char> deviceData(33 + 16);
+        MatterTunnel::compressPublicKey(device.publicKey, deviceData.data());
+        const unsigned char functions[] = {
+            's', 'e', 't', 'L', 'E', 'D', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xb0, 0x00,
+            'g', 'e', 't', 'T', 'e', 'm', 'p', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x02};
+        deviceData.insert(deviceData.end(), functions, functions + sizeof(functions));
+
+        DeviceInfo info = MatterTunnel::parseDeviceInfo(deviceData);
+        const DeviceFunction *setLED = info.function("setLED");
+        std::cout << "setLED: " << setLED->signature() << ", args: " << setLED->argCount() << std::endl;
+        std::cout << "missing: " << (info.function("reboot") == nullptr ? "Yes" : "No") << std::endl;
+
+        DeviceInfoCache cache;
+        DeviceInfoCache::InfoPtr first = cache.add(deviceData.data(), deviceData.size());
+        DeviceInfoCache::InfoPtr second = cache.add(deviceData.data(), deviceData.size());
+        std::cout << "parsed once: " << (first == second ? "Yes" : "No") << std::endl;
+        std::cout << "by TX key: " << (cache.findUncompressed(device.publicKey) == first ? "Yes" : "No") << std::endl;
+        CryptoBackend::cleanse(device.privateKey, sizeof(device.privateKey));
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "스키마 검증 테스트" << std::endl;
+
+        MatterTunnel::KeyPair device = MatterTunnel::generateKeyPair();
+        MatterTunnel::KeyPair gateway = MatterTunnel::generateKeyPair();
+        unsigned char devicePub[65];
+        for (size_t i = 0; i < 65; i++)
+        {
+            devicePub[i] = static_cast<unsigned char>(std::stoi(device.publicKey.substr(i * 2, 2), nullptr, 16));
+        }
+        std::vector<unsigned char> deviceData(33 + 16);
+        MatterTunnel::compressPublicKey(devicePub, deviceData.data());
+        const unsigned char functions[] = {
+            's', 'e', 't', 'L', 'E', 'D', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xb0, 0x00,
+            'g', 'e', 't', 'T', 'e', 'm', 'p', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x02};
+        deviceData.insert(deviceData.end(), functions, functions + sizeof(functions));
+        DeviceInfo info = MatterTunnel::parseDeviceInfo(deviceData);
+
+        auto check = [&](const char *label, const std::vector<unsigned char> &tx) {
+            MatterResult<std::string> result = MatterTunnel::tryExtractTXData(device.privateKey, tx, info);
+            std::cout << label << ": " << (result ? result.value() : result.message()) << std::endl;
+        };
+        check("valid", MatterTunnel::makeTX("setLED", gateway.privateKey, device.publicKey, {"1", "true"}));
+        check("bad type", MatterTunnel::makeTX("setLED", gateway.privateKey, device.publicKey, {"on", "true"}));
+        check("bad count", MatterTunnel::makeIndexedTX("getTemp", gateway.privateKey, device.publicKey, {"1"}));
+
+        // 서명이 틀려도 funcName 조회에서 먼저 거부됨
+        std::vector<unsigned char> unknown = MatterTunnel::makeTX("reboot", gateway.privateKey, device.publicKey, {});
+        unknown[40] ^= 0x01;
+        check("unknown", unknown);
+
+        MatterTunnel::TXRecord record = MatterTunnel::openTX(
+            device.privateKey, MatterTunnel::makeIndexedTX("setLED", gateway.privateKey, device.publicKey, {"2", "yes"}),
+            info);
+        std::cout << "indexed item 0: " << record.item(0) << ", item 1: " << record.tryItem(1).message() << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "타입 시그니처 테스트" << std::endl;
+
+        static_assert(SetLED::typeCode == 0xb000, "setLED(number,boolean)->void");
+
+        MatterTunnel::KeyPair gateway = MatterTunnel::generateKeyPair();
+        MatterTunnel::KeyPair device = MatterTunnel::generateKeyPair();
+
+        std::vector<unsigned char> tx = SetLED::makeTX(gateway.privateKey, device.publicKey, 0.5, true);
+        SetLED::Call call = SetLED::decode(device.privateKey, tx);
+        std::cout << "typed: " << std::get<0>(call.args) << ", " << std::get<1>(call.args) << std::endl;
+        std::cout << "string: " << MatterTunnel::extractTXData(device.privateKey, tx) << std::endl;
+
+        std::vector<unsigned char> other = MatterTunnel::makeTX("getTemp", gateway.privateKey, device.publicKey, {});
+        std::cout << "other: " << SetLED::tryDecode(device.privateKey, other).message() << std::endl;
+
+        std::vector<unsigned char> deviceData(49, 0x02);
+        deviceData.insert(deviceData.end(), SetLED::functionData.begin(), SetLED::functionData.end());
+        DeviceFunction declared = DeviceInfo::parse(deviceData.data(), deviceData.size()).functions[0];
+        std::cout << "device entry: " << declared.signature() << " " << (SetLED::matches(declared) ? "Yes" : "No")
+                  << std::endl;
+
+        // 정수 타입 범위: 2^63, 2^64는 double로 max()와 같아지므로 거부돼야 함
+        int64_t i64 = 0;
+        uint64_t u64 = 0;
+        int32_t i32 = 0;
+        bool rangeOk = !ValueTraits<int64_t>::decode("9223372036854775808", i64) &&
+                       ValueTraits<int64_t>::decode("-9223372036854775808", i64) &&
+                       i64 == std::numeric_limits<int64_t>::lowest() &&
+                       !ValueTraits<uint64_t>::decode("18446744073709551616", u64) &&
+                       ValueTraits<uint64_t>::decode("9007199254740992", u64) && u64 == (uint64_t(1) << 53) &&
+                       ValueTraits<int32_t>::decode("2147483647", i32) &&
+                       !ValueTraits<int32_t>::decode("2147483648", i32);
+        std::cout << "integer range: " << (rangeOk ? "성공" : "실패") << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "RPC 디스패처 테스트" << std::endl;
+
+        MatterTunnel::KeyPair gateway = MatterTunnel::generateKeyPair();
+        MatterTunnel::KeyPair device = MatterTunnel::generateKeyPair();
+
+        std::vector<unsigned char> deviceData(49, 0x02);
+        const unsigned char getTemp[] = {'g', 'e', 't', 'T', 'e', 'm', 'p', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x02};
+        deviceData.insert(deviceData.end(), SetLED::functionData.begin(), SetLED::functionData.end());
+        deviceData.insert(deviceData.end(), getTemp, getTemp + sizeof(getTemp));
+
+        RpcDispatcher dispatcher(DeviceInfo::parse(deviceData.data(), deviceData.size()));
+        dispatcher.bind<SetLED>([](double brightness, bool on) {
+            std::cout << "setLED(" << brightness << ", " << on << ")" << std::endl;
+        });
+        dispatcher.bindRaw("getTemp", [](const unsigned char *, size_t txLen) {
+            std::cout << "getTemp: " << txLen << " bytes forwarded" << std::endl;
+            return MatterError::Ok;
+        });
+
+        dispatcher.dispatch(device.privateKey, SetLED::makeTX(gateway.privateKey, device.publicKey, 0.75, true));
+        dispatcher.dispatch(device.privateKey, MatterTunnel::makeTX("getTemp", gateway.privateKey, device.publicKey, {}));
+        MatterError error = dispatcher.dispatch(
+            device.privateKey, MatterTunnel::makeTX("reboot", gateway.privateKey, device.publicKey, {}));
+        std::cout << "reboot: " << matterErrorMessage(error) << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "요청/응답 테스트" << std::endl;
+
+        MatterTunnel::KeyPair gateway = MatterTunnel::generateKeyPair();
+        MatterTunnel::KeyPair device = MatterTunnel::generateKeyPair();
+        RpcClient client(std::chrono::milliseconds(500));
+
+        // 게이트웨이: 요청 전송 및 대기 등록
+        RpcClient::Sent getTemp = client.tryCall<GetTemp>(gateway.privateKey, device.publicKey).unwrap();
+        RpcClient::Sent echo = client.call("echo", gateway.privateKey, device.publicKey, {"ping"});
+        RpcClient::Sent lost = client.call("echo", gateway.privateKey, device.publicKey, {"lost"});
+        std::cout << "pending: " << client.pending() << std::endl;
+
+        // 디바이스: 요청 복호화 후 같은 공유키로 응답 (ECDH, 서명 없음)
+        auto tempCall =
+            MatterRpc::tryOpenCall<GetTemp>(device.privateKey, getTemp.txBytes.data(), getTemp.txBytes.size()).unwrap();
+        std::vector<unsigned char> tempResponse = MatterRpc::tryRespond<GetTemp>(tempCall.context, 21.5).unwrap();
+        MatterRpc::Request echoRequest = MatterRpc::openRequest(device.privateKey, echo.txBytes);
+        std::vector<unsigned char> echoResponse = MatterRpc::makeResponse(echoRequest.context, echoRequest.data[0]);
+        std::cout << "response size: " << tempResponse.size() << " (request " << getTemp.txBytes.size() << ")"
+                  << std::endl;
+
+        // 게이트웨이: 응답 매칭
+        RpcClient::Response temp = client.receive(tempResponse);
+        std::cout << temp.funcName << " #" << temp.requestId << " -> " << MatterRpc::tryResult<GetTemp>(temp).value()
+                  << std::endl;
+        RpcClient::Response pong = client.receive(echoResponse);
+        std::cout << pong.funcName << " #" << pong.requestId << " -> " << pong.value << std::endl;
+        std::cout << "replayed: " << client.tryReceive(echoResponse).message() << std::endl;
+
+        echoResponse[MatterRpc::HEADER_SIZE] ^= 0x01;
+        std::cout << "tampered: "
+                  << MatterRpc::tryOpenResponse(echoRequest.context, echoResponse.data(), echoResponse.size()).message()
+                  << std::endl;
+
+        auto later = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        for (const RpcClient::Response &timeout : client.expire(later))
+        {
+            std::cout << timeout.funcName << " #" << timeout.requestId << " -> " << matterErrorMessage(timeout.status)
+                      << (timeout.requestId == lost.requestId ? " (lost)" : "") << std::endl;
+        }
+        std::cout << "pending: " << client.pending() << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "디바이스 레지스트리 테스트" << std::endl;
+
+        MatterTunnel::KeyPair gateway = MatterTunnel::generateKeyPair();
+        DeviceRegistry registry(gateway.privateKey);
+
+        // 디바이스 데이터: compressed pubkey(33) + passcode(16)
+        std::vector<MatterTunnel::KeyPair> devices;
+        std::vector<std::vector<unsigned char>> txs;
+        for (int i = 0; i < 8; i++)
+        {
+            devices.push_back(MatterTunnel::generateKeyPair());
+            registry.add(deviceDataForTest(devices.back()));
+            txs.push_back(MatterTunnel::makeTX("report", devices.back().privateKey, gateway.publicKey,
+                                               {std::to_string(i)}));
+        }
+        std::cout << "registered: " << registry.size() << std::endl;
+
+        // 디코딩 스레드들이 조회하는 동안 다른 디바이스를 등록/삭제
+        std::atomic<int> decoded(0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; t++)
+        {
+            readers.emplace_back([&]() {
+                for (int n = 0; n < 50; n++)
+                {
+                    decoded += registry.tryExtractTXData(txs[n % txs.size()].data(), txs[n % txs.size()].size()).ok();
+                }
+            });
+        }
+        for (int n = 0; n < 20; n++)
+        {
+            std::vector<unsigned char> data = deviceDataForTest(MatterTunnel::generateKeyPair());
+            registry.add(data);
+            registry.remove(data.data());
+        }
+        for (auto &thread : readers)
+        {
+            thread.join();
+        }
+        std::cout << "decoded: " << decoded << "/200, registered: " << registry.size() << std::endl;
+        std::cout << registry.extractTXData(txs[3]).substr(0, 20) << "..." << std::endl;
+
+        // 캐시된 공유키로 디바이스에 전송
+        DeviceRegistry::EntryPtr entry = registry.find(deviceDataForTest(devices[0]).data());
+        std::vector<unsigned char> command = registry.makeTX("setLED", *entry, {"1", "true"});
+        std::cout << "device: " << MatterTunnel::extractTXData(devices[0].privateKey, command).substr(0, 20) << "..."
+                  << std::endl;
+
+        registry.remove(entry->info.compressedKey);
+        std::cout << "removed: " << registry.tryExtractTXData(txs[0].data(), txs[0].size()).message()
+                  << ", entry still usable: " << MatterTunnel::extractTXData(*entry, txs[0]).substr(0, 20) << "..."
+                  << std::endl;
+        std::cout << "wrong entry: " << MatterTunnel::tryExtractTXData(*entry, txs[1].data(), txs[1].size()).message()
+                  << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "레지스트리 스냅샷 테스트" << std::endl;
+
+        MatterTunnel::KeyPair gateway = MatterTunnel::generateKeyPair();
+        const std::vector<unsigned char> functions(SetLED::functionData.begin(), SetLED::functionData.end());
+
+        std::vector<MatterTunnel::KeyPair> devices;
+        std::string path = (std::filesystem::temp_directory_path() / "matter_registry.snap").string();
+        {
+            DeviceRegistry registry(gateway.privateKey);
+            for (int i = 0; i < 3; i++)
+            {
+                devices.push_back(MatterTunnel::generateKeyPair());
+                registry.add(deviceDataForTest(devices.back(), functions));
+            }
+            RegistrySnapshot::write(path, registry);
+        }
+
+        // 재시작: mmap 후 그대로 조회, 레지스트리로 불러오기 (ECDH 없음)
+        RegistrySnapshot snapshot = RegistrySnapshot::open(path, gateway.privateKey);
+        RegistrySnapshot::Record record = snapshot.find(deviceDataForTest(devices[0], functions).data());
+        std::cout << "snapshot: " << snapshot.size() << " devices, " << record.function(0).signature() << std::endl;
+
+        DeviceRegistry restored(gateway.privateKey);
+        std::cout << "loaded: " << snapshot.load(restored) << std::endl;
+        std::vector<unsigned char> tx = MatterTunnel::makeTX("report", devices[1].privateKey, gateway.publicKey, {"ok"});
+        std::cout << restored.extractTXData(tx).substr(0, 20) << "..." << std::endl;
+
+        // 새 디바이스 추가 후 다시 열기
+        devices.push_back(MatterTunnel::generateKeyPair());
+        snapshot.append(*restored.add(deviceDataForTest(devices.back(), functions)));
+        snapshot.remove(deviceDataForTest(devices[2], functions).data());
+        RegistrySnapshot reopened = RegistrySnapshot::open(path, gateway.privateKey);
+        std::cout << "reopened: " << reopened.size() << " devices, removed found: "
+                  << (reopened.find(deviceDataForTest(devices[2], functions).data()) ? "Yes" : "No") << std::endl;
+
+        // 파일의 한 바이트를 직접 바꿔 변조 (같은 mask로 한 번 더 호출하면 복원)
+        auto patch = [&path](size_t offset, unsigned char mask) {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekg(offset);
+            char value = static_cast<char>(file.get() ^ mask);
+            file.seekp(offset);
+            file.put(value);
+        };
+        auto expectFailure = [](const char *label, const std::function<void()> &fn) {
+            try
+            {
+                fn();
+                std::cout << label << ": 실패" << std::endl;
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << label << ": " << e.what() << std::endl;
+            }
+        };
+        const size_t first = RegistrySnapshot::HEADER_SIZE;
+
+        // 첫 레코드의 삭제 비트를 켜면 열 때 인증 실패
+        patch(first + 6, 0x01);
+        expectFailure("tampered tombstone", [&] { RegistrySnapshot::open(path, gateway.privateKey); });
+        patch(first + 6, 0x01);
+
+        // 함수 이름 길이가 18을 넘으면 손상된 파일
+        patch(first + RegistrySnapshot::RECORD_HEADER_SIZE + 20, 0xf0);
+        expectFailure("bad name length", [&] { RegistrySnapshot::open(path, gateway.privateKey); });
+        patch(first + RegistrySnapshot::RECORD_HEADER_SIZE + 20, 0xf0);
+
+        // passcode가 바뀐 살아 있는 레코드는 find에서 인증 실패
+        patch(first + 101, 0x01);
+        expectFailure("tampered record", [&] {
+            RegistrySnapshot tampered = RegistrySnapshot::open(path, gateway.privateKey);
+            for (const auto &device : devices)
+            {
+                tampered.find(deviceDataForTest(device, functions).data());
+            }
+        });
+        patch(first + 101, 0x01);
+
+        try
+        {
+            RegistrySnapshot::open(path, devices[0].privateKey);
+        }
+        catch (const std::exception &e)
+        {
+            std::cout << "other key: " << e.what() << std::endl;
+        }
+        std::remove(path.c_str());
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    try
+    {
+        std::cout << "------------------------" << std::endl
+                  << std::endl;
+        std::cout << "수신자 힌트 / 키링 테스트" << std::endl;
+
+        // 게이트웨이가 테넌트마다 다른 개인키를 가짐
+        std::vector<MatterTunnel::KeyPair> tenants;
+        Keyring keyring;
+        for (int i = 0; i < 4; i++)
+        {
+            tenants.push_back(MatterTunnel::generateKeyPair());
+            keyring.add(tenants.back().privateKey);
+        }
+        MatterTunnel::KeyPair device = MatterTunnel::generateKeyPair();
+
+        // 힌트가 있는 TX: 키를 바로 선택
+        std::vector<unsigned char> hinted =
+            MatterTunnel::makeTX("report", device.privateKey, tenants[2].publicKey, {"21.5", "ok"},
+                                 MatterTunnel::TX_FORMAT_LEGACY | MatterTunnel::TX_FLAG_DEST_HINT);
+        std::cout << "hinted: " << keyring.extractTXData(hinted).substr(0, 20) << "..." << std::endl;
+        std::cout << "single key: " << MatterTunnel::extractTXData(tenants[2].privateKey, hinted).substr(0, 20)
+                  << "..." << std::endl;
+
+        // 기존 TX: 시험 복호화 후 보낸 디바이스의 키를 기억
+        std::vector<unsigned char> legacy = MatterTunnel::makeTX("report", device.privateKey, tenants[3].publicKey, {"ok"});
+        std::cout << "legacy: " << keyring.extractTXData(legacy).substr(0, 20) << "..." << std::endl;
+
+        // 기억된 키가 있으므로 같은 디바이스의 INDEXED TX도 열림
+        std::vector<unsigned char> indexed =
+            MatterTunnel::makeIndexedTX("report", device.privateKey, tenants[3].publicKey, {"a", "b"});
+        std::cout << "indexed: " << keyring.extractTXData(indexed).substr(0, 20) << "..." << std::endl;
+
+        MatterTunnel::KeyPair stranger = MatterTunnel::generateKeyPair();
+        std::vector<unsigned char> other =
+            MatterTunnel::makeTX("report", device.privateKey, stranger.publicKey, {"ok"},
+                                 MatterTunnel::TX_FORMAT_INDEXED | MatterTunnel::TX_FLAG_DEST_HINT);
+        MatterResult<std::string> result = keyring.tryExtractTXData(other.data(), other.size());
+        std::cout << "other recipient: " << result.message() << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
     try{
         // wasm test
         std::cout << "------------------------" << std::endl
@@ -208,6 +992,29 @@ int main()
         };
 
         std::cout << MatterTunnel::extractTXData(bobPrivateKey, txData) << std::endl;
+
+        // 바이트 키 API (raw export용): 16진수 API와 결과가 같아야 함
+        std::vector<unsigned char> alicePriv = hexToBytesForTest(alicePrivateKey);
+        std::vector<unsigned char> bobPriv = hexToBytesForTest(bobPrivateKey);
+        std::vector<unsigned char> bobPub = hexToBytesForTest(bobPublicKey);
+        std::vector<unsigned char> alicePub = hexToBytesForTest(alicePublicKey);
+        unsigned char rawSig[64];
+        bool rawOk = MatterTunnel::trySignBytes(reinterpret_cast<const unsigned char *>(msg.data()), msg.length(),
+                                                alicePriv.data(), rawSig) == MatterError::Ok &&
+                     MatterTunnel::verify(bytesToHexForTest(rawSig, 64), msg, alicePublicKey) &&
+                     MatterTunnel::verifyBytes(hexToBytesForTest(sig).data(),
+                                               reinterpret_cast<const unsigned char *>(msg.data()), msg.length(),
+                                               alicePub.data(), alicePub.size());
+        MatterResult<std::vector<unsigned char>> rawTX =
+            MatterTunnel::tryMakeTX("rawFunction", alicePriv.data(), bobPub.data(), bobPub.size(), {"a", "b"});
+        MatterResult<std::string> rawJSON = rawTX ? MatterTunnel::tryExtractTXData(bobPriv.data(), rawTX.value().data(),
+                                                                                   rawTX.value().size())
+                                                  : MatterResult<std::string>(rawTX.error());
+        std::cout << "raw bytes API: " << (rawOk && rawJSON.ok() &&
+                                                   rawJSON.value() == MatterTunnel::extractTXData(bobPrivateKey, rawTX.value())
+                                               ? "성공"
+                                               : "실패")
+                  << std::endl;
         
     }
     catch (const std::exception &e)
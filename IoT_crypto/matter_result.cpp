@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// 예외 없는 API(MatterTunnel::try*)의 오류 코드
+// 기존 예외 API에 있던 오류는 각각 기존과 같은 메시지를 가지며, 예외 API는 이 코드를 같은 메시지의 예외로 바꿔 던진다.
+// (16진수 오류만 예외: 기존에는 std::stoi의 invalid_argument("stoi")였고 지금은 invalid_argument("Invalid hex string"))
+// 값은 외부에 저장될 수 있으므로 새 코드는 끝에 추가한다.
+enum class MatterError : uint8_t
+{
+    Ok = 0,
+    InvalidHex,             // 16진수가 아닌 문자
+    InvalidPrivateKey,      // 32바이트 초과 또는 범위 밖의 개인키
+    InvalidPublicKey,       // 압축 공개키(TX 헤더, 디바이스 정보) 복원 실패
+    InvalidSignatureLength, // 서명 16진수가 128자가 아님
+    InvalidSignature,       // 서명 검증 실패
+    InvalidDataSize,        // 디바이스 정보가 너무 짧음
+    InvalidTXSize,          // TX가 최소 크기보다 짧음
+    UnsupportedTXFormat,    // 알 수 없는 format 바이트
+    InvalidEncryptedLength, // 암호문이 IV보다 짧음
+    DecryptionFailed,       // 블록 길이/패딩 오류
+    InvalidIndexedPayload,  // TX_FORMAT_INDEXED 인덱스 불일치
+    TooManyItems,           // 데이터 항목 65535개 초과
+    DataItemTooLarge,       // 항목 하나가 4GiB 이상
+    RandomFailure,          // IV/nonce 생성 실패
+    CryptoFailure,          // 그 밖의 내부 연산 실패
+    InvalidFuncName,        // 출력할 수 없는 문자 또는 잘못된 패딩
+    InvalidTimestamp,       // 허용 범위를 벗어난 타임스탬프
+    UnknownFunction,        // 디바이스 함수 테이블에 없는 funcName
+    InvalidArguments,       // 인자 개수/타입이 함수 시그니처와 다름
+    UnknownRequest,         // 응답의 correlation ID에 해당하는 대기 요청이 없음
+    RequestTimeout,         // 응답 대기 시간 초과
+    UnknownDevice,          // 레지스트리에 등록되지 않은 공개키
+    UnknownRecipient,       // 키링에 수신자 개인키가 없음
+    InvalidPublicKeyPoint,  // 상대 공개키(getSharedKey, makeTX)가 형식 오류이거나 곡선 위에 없음
+    PublicKeyMismatch,      // TX 헤더의 공개키가 등록된 디바이스와 다름
+    KeyGenerationFailed,    // 개인키 생성 실패
+    SigningFailed,          // 서명 생성 실패
+    SharedSecretFailed,     // ECDH 공유 포인트 계산 실패
+    CipherInitFailed,       // AES 컨텍스트 초기화 실패
+    EncryptionFailed,       // 암호화 실패
+    EncryptionFinalizeFailed, // 암호화 종료(패딩) 실패
+    DecryptionUpdateFailed, // 복호화 실패 (패딩 오류는 DecryptionFailed)
+};
+
+inline const char *matterErrorMessage(MatterError error) noexcept
+{
+    switch (error)
+    {
+    case MatterError::Ok:
+        return "OK";
+    case MatterError::InvalidHex:
+        return "Invalid hex string";
+    case MatterError::InvalidPrivateKey:
+        return "Failed to set private key";
+    case MatterError::InvalidPublicKey:
+        return "Failed to decompress public key";
+    case MatterError::InvalidSignatureLength:
+        return "Invalid signature length";
+    case MatterError::InvalidSignature:
+        return "Invalid signature";
+    case MatterError::InvalidDataSize:
+        return "Invalid data size";
+    case MatterError::InvalidTXSize:
+        return "Invalid TX data size";
+    case MatterError::UnsupportedTXFormat:
+        return "Unsupported TX format";
+    case MatterError::InvalidEncryptedLength:
+        return "Invalid encrypted data length";
+    case MatterError::DecryptionFailed:
+        return "Failed to finalize decryption";
+    case MatterError::InvalidIndexedPayload:
+        return "Invalid indexed payload";
+    case MatterError::TooManyItems:
+        return "Too many data items";
+    case MatterError::DataItemTooLarge:
+        return "Data item too large";
+    case MatterError::RandomFailure:
+        return "Failed to generate IV";
+    case MatterError::CryptoFailure:
+        return "Crypto operation failed";
+    case MatterError::InvalidFuncName:
+        return "Invalid function name";
+    case MatterError::InvalidTimestamp:
+        return "Invalid timestamp";
+    case MatterError::UnknownFunction:
+        return "Unknown function";
+    case MatterError::InvalidArguments:
+        return "Invalid function arguments";
+    case MatterError::UnknownRequest:
+        return "Unknown request";
+    case MatterError::RequestTimeout:
+        return "Request timed out";
+    case MatterError::UnknownDevice:
+        return "Unknown device";
+    case MatterError::UnknownRecipient:
+        return "Unknown recipient";
+    case MatterError::InvalidPublicKeyPoint:
+        return "Failed to create public key point";
+    case MatterError::PublicKeyMismatch:
+        return "Public key does not match device";
+    case MatterError::KeyGenerationFailed:
+        return "Failed to generate private key";
+    case MatterError::SigningFailed:
+        return "Failed to create signature";
+    case MatterError::SharedSecretFailed:
+        return "Failed to compute shared point";
+    case MatterError::CipherInitFailed:
+        return "Failed to initialize CBC mode";
+    case MatterError::EncryptionFailed:
+        return "Failed to encrypt message";
+    case MatterError::EncryptionFinalizeFailed:
+        return "Failed to finalize encryption";
+    case MatterError::DecryptionUpdateFailed:
+        return "Failed to decrypt message";
+    }
+    return "Unknown error";
+}
+
+// 예외 API용: 기존과 같은 예외 타입/메시지로 변환
+[[noreturn]] inline void throwMatterError(MatterError error)
+{
+    if (error == MatterError::InvalidHex)
+    {
+        throw std::invalid_argument(matterErrorMessage(error));
+    }
+    throw std::runtime_error(matterErrorMessage(error));
+}
+
+// 값 또는 오류 코드 (std::expected와 비슷한 최소 구현)
+template <typename T>
+class MatterResult
+{
+public:
+    MatterResult(const T &value) : value_(value), error_(MatterError::Ok) {}
+    MatterResult(T &&value) : value_(std::move(value)), error_(MatterError::Ok) {}
+    MatterResult(MatterError error) : value_(), error_(error) {}
+
+    bool ok() const noexcept { return error_ == MatterError::Ok; }
+    explicit operator bool() const noexcept { return ok(); }
+    MatterError error() const noexcept { return error_; }
+    const char *message() const noexcept { return matterErrorMessage(error_); }
+
+    // 실패한 결과의 값은 기본값
+    const T &value() const & noexcept { return value_; }
+    T &value() & noexcept { return value_; }
+    T &&value() && noexcept { return std::move(value_); }
+
+    // 실패면 예외, 성공이면 값
+    T unwrap() &&
+    {
+        if (!ok())
+        {
+            throwMatterError(error_);
+        }
+        return std::move(value_);
+    }
+
+private:
+    T value_;
+    MatterError error_;
+};
@@ -0,0 +1,534 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include "./typed_function.cpp"
+
+// 요청/응답 RPC
+// 요청은 일반 서명 TX이고, 응답 TX는 요청에 쓴 ECDH 공유키와 요청 서명으로 파생한 키의 AES-256-GCM으로만 인증한다.
+// 응답을 만들고 받는 쪽 모두 ECDH, ECDSA 서명/검증, 공개키 복원이 없다 (공유키를 아는 두 당사자만 태그를 만들 수 있음).
+//
+// 응답 TX: magic(4, "MTR" 0x01) + correlationId(16) + status(1) + timestamp(8) + nonce(12) + GCM 암호문 + tag(16)
+//          헤더 41바이트는 GCM AAD로 인증됨
+//          correlationId = SHA-256("matter-rpc-id" || 요청 서명)[0..16)
+//          key = SHA-256("matter-rpc-key" || sharedKey || 요청 서명)
+//          평문 = 반환값 문자열 그대로 (void면 빈 평문), status는 처리 실패 시 MatterError 코드
+class MatterRpc
+{
+public:
+    static constexpr unsigned char RESPONSE_MAGIC[4] = {'M', 'T', 'R', 0x01};
+    static constexpr size_t CORRELATION_ID_SIZE = 16;
+    static constexpr size_t HEADER_SIZE = 4 + CORRELATION_ID_SIZE + 1 + 8 + 12;
+    static constexpr size_t TAG_SIZE = 16;
+
+    using CorrelationId = std::array<unsigned char, CORRELATION_ID_SIZE>;
+
+    // 요청 하나에 대한 응답 키 (요청 송신측과 수신측이 각자 파생)
+    struct ResponseContext
+    {
+        CorrelationId correlationId{};
+        unsigned char key[32] = {0};
+
+        ~ResponseContext()
+        {
+            CryptoBackend::cleanse(key, sizeof(key));
+        }
+    };
+
+    // 수신한 요청 (디바이스)
+    struct Request
+    {
+        std::string funcName;
+        std::string srcPub; // uncompressed 16진수
+        uint64_t timestamp = 0;
+        std::vector<std::string> data;
+        ResponseContext context;
+    };
+
+    // 수신한 typed 요청
+    template <typename F>
+    struct TypedRequest
+    {
+        typename F::Call call;
+        ResponseContext context;
+    };
+
+    // 수신한 응답 (requestId, funcName은 RpcClient가 채움)
+    struct Response
+    {
+        uint64_t requestId = 0;
+        std::string funcName;
+        MatterError status = MatterError::Ok;
+        uint64_t timestamp = 0;
+        std::string value;
+    };
+
+    // ---- 요청 송신측 ----
+
+    // makeTX와 같은 TX를 만들고, 같은 공유키로 응답 키를 파생
+    static std::vector<unsigned char> makeRequest(const std::string &funcName, const std::string &src_priv,
+                                                  const std::string &dest_pub,
+                                                  const std::vector<std::string> &data_list,
+                                                  ResponseContext &context)
+    {
+        return tryMakeRequest(funcName, src_priv, dest_pub, data_list, context).unwrap();
+    }
+
+    static MatterResult<std::vector<unsigned char>> tryMakeRequest(const std::string &funcName,
+                                                                   const std::string &src_priv,
+                                                                   const std::string &dest_pub,
+                                                                   const std::vector<std::string> &data_list,
+                                                                   ResponseContext &context)
+    {
+        MatterResult<std::string> sharedKey = MatterTunnel::tryGetSharedKey(src_priv, dest_pub);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+        MatterResult<std::vector<unsigned char>> tx =
+            MatterTunnel::tryBuildTX(funcName, src_priv, sharedKey.value(), data_list, MatterTunnel::TX_FORMAT_LEGACY);
+        if (tx)
+        {
+            deriveContext(sharedKey.value(), tx.value().data(), context);
+        }
+        CryptoBackend::cleanse(&sharedKey.value()[0], sharedKey.value().length());
+        return tx;
+    }
+
+    // TypedFunction::makeTX와 같은 TX
+    template <typename F, typename... V>
+    static MatterResult<std::vector<unsigned char>> tryMakeCall(ResponseContext &context, const std::string &src_priv,
+                                                                const std::string &dest_pub,
+                                                                const V &...args)
+    {
+        MatterResult<std::string> sharedKey = MatterTunnel::tryGetSharedKey(src_priv, dest_pub);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+        MatterResult<std::vector<unsigned char>> tx = F::tryBuildTX(sharedKey.value(), src_priv, args...);
+        if (tx)
+        {
+            deriveContext(sharedKey.value(), tx.value().data(), context);
+        }
+        CryptoBackend::cleanse(&sharedKey.value()[0], sharedKey.value().length());
+        return tx;
+    }
+
+    // 응답 TX 복호화 (correlationId가 다르면 UnknownRequest, 태그 검증 실패는 DecryptionFailed)
+    static MatterResult<Response> tryOpenResponse(const ResponseContext &context, const unsigned char *txBytes,
+                                                  size_t txLen)
+    {
+        MatterError error = precheckResponse(txBytes, txLen);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        if (std::memcmp(txBytes + 4, context.correlationId.data(), CORRELATION_ID_SIZE) != 0)
+        {
+            return MatterError::UnknownRequest;
+        }
+
+        size_t cipherLen = txLen - HEADER_SIZE - TAG_SIZE;
+        Response response;
+        response.value.resize(cipherLen);
+        if (!CryptoBackend::gcm(false, context.key, txBytes + HEADER_SIZE - 12, txBytes, HEADER_SIZE,
+                                txBytes + HEADER_SIZE, cipherLen,
+                                reinterpret_cast<unsigned char *>(&response.value[0]),
+                                const_cast<unsigned char *>(txBytes + HEADER_SIZE + cipherLen)))
+        {
+            return MatterError::DecryptionFailed;
+        }
+        response.status = static_cast<MatterError>(txBytes[4 + CORRELATION_ID_SIZE]);
+        response.timestamp = readLE64(txBytes + 4 + CORRELATION_ID_SIZE + 1);
+        return response;
+    }
+
+    // typed 반환값 (처리 실패 응답이면 그 status, 형식이 맞지 않으면 InvalidArguments)
+    template <typename F>
+    static MatterResult<std::decay_t<typename F::Result>> tryResult(const Response &response)
+    {
+        using R = std::decay_t<typename F::Result>;
+        if (response.status != MatterError::Ok)
+        {
+            return response.status;
+        }
+        R value{};
+        if (!ValueTraits<R>::decode(response.value, value))
+        {
+            return MatterError::InvalidArguments;
+        }
+        return value;
+    }
+
+    // 응답 TX의 correlationId (형식이 아니면 false)
+    static bool correlationIdOf(const unsigned char *txBytes, size_t txLen, CorrelationId &id) noexcept
+    {
+        if (precheckResponse(txBytes, txLen) != MatterError::Ok)
+        {
+            return false;
+        }
+        std::memcpy(id.data(), txBytes + 4, CORRELATION_ID_SIZE);
+        return true;
+    }
+
+    // ---- 요청 수신측 ----
+
+    // extractTXData와 같은 검증/복호화 후 응답 키 파생 (ECDH는 요청 복호화 때 한 번뿐)
+    static Request openRequest(const std::string &privateKey, const std::vector<unsigned char> &txBytes)
+    {
+        return tryOpenRequest(privateKey, txBytes.data(), txBytes.size()).unwrap();
+    }
+
+    static MatterResult<Request> tryOpenRequest(const std::string &privateKey, const unsigned char *txBytes,
+                                                size_t txLen)
+    {
+        MatterTunnel::TXFields fields;
+        MatterError error = MatterTunnel::openTXFields(privateKey, txBytes, txLen, nullptr,
+                                                       MatterTunnel::ANY_ARG_COUNT, fields);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+
+        Request request;
+        request.funcName = std::move(fields.header.funcName);
+        request.srcPub = std::move(fields.header.srcPub);
+        request.timestamp = fields.header.timestamp;
+        request.data.assign(fields.fields.begin(), fields.fields.end());
+        deriveContext(fields.sharedKey, txBytes, request.context);
+        return request;
+    }
+
+    // TypedFunction::tryDecode와 같은 검사 후 응답 키 파생
+    template <typename F>
+    static MatterResult<TypedRequest<F>> tryOpenCall(const std::string &privateKey, const unsigned char *txBytes,
+                                                     size_t txLen)
+    {
+        MatterTunnel::TXFields fields;
+        MatterError error = MatterTunnel::openTXFields(privateKey, txBytes, txLen, F::funcName.data(), F::argCount,
+                                                       fields);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+
+        TypedRequest<F> request;
+        if (!F::decodeFields(fields.fields, request.call.args))
+        {
+            return MatterError::InvalidArguments;
+        }
+        std::memcpy(request.call.srcPub, fields.header.srcPubBytes, 65);
+        request.call.timestamp = fields.header.timestamp;
+        deriveContext(fields.sharedKey, txBytes, request.context);
+        return request;
+    }
+
+    static std::vector<unsigned char> makeResponse(const ResponseContext &context, const std::string &value)
+    {
+        return tryMakeResponse(context, MatterError::Ok, value).unwrap();
+    }
+
+    // 처리 실패 응답 (예: UnknownFunction, InvalidArguments)
+    static std::vector<unsigned char> makeErrorResponse(const ResponseContext &context, MatterError status)
+    {
+        return tryMakeResponse(context, status, std::string()).unwrap();
+    }
+
+    static MatterResult<std::vector<unsigned char>> tryMakeResponse(const ResponseContext &context,
+                                                                    MatterError status,
+                                                                    const std::string &value)
+    {
+        return buildResponse(context, status, reinterpret_cast<const unsigned char *>(value.data()), value.length());
+    }
+
+    // typed 반환값 응답 (void 함수는 값 없이)
+    template <typename F, typename R = typename F::Result>
+    static std::enable_if_t<std::is_void_v<R>, MatterResult<std::vector<unsigned char>>>
+    tryRespond(const ResponseContext &context)
+    {
+        return buildResponse(context, MatterError::Ok, nullptr, 0);
+    }
+
+    template <typename F, typename R = typename F::Result>
+    static std::enable_if_t<!std::is_void_v<R>, MatterResult<std::vector<unsigned char>>>
+    tryRespond(const ResponseContext &context, const std::decay_t<R> &value)
+    {
+        // 인자와 같은 문자열 표현, 길이 바이트는 빼고 담는다
+        std::vector<unsigned char> encoded;
+        if (!ValueTraits<std::decay_t<R>>::encode(value, encoded))
+        {
+            return MatterError::DataItemTooLarge;
+        }
+        return buildResponse(context, MatterError::Ok, encoded.data() + 1, encoded.size() - 1);
+    }
+
+private:
+    static void deriveContext(const std::string &sharedKey, const unsigned char signature[64],
+                              ResponseContext &context)
+    {
+        unsigned char hash[32];
+        std::string input = "matter-rpc-id";
+        input.append(reinterpret_cast<const char *>(signature), 64);
+        MatterTunnel::sha256(input, hash);
+        std::memcpy(context.correlationId.data(), hash, CORRELATION_ID_SIZE);
+
+        input = "matter-rpc-key" + sharedKey;
+        input.append(reinterpret_cast<const char *>(signature), 64);
+        MatterTunnel::sha256(input, context.key);
+        CryptoBackend::cleanse(&input[0], input.length());
+    }
+
+    static MatterError precheckResponse(const unsigned char *txBytes, size_t txLen) noexcept
+    {
+        if (txLen < HEADER_SIZE + TAG_SIZE)
+        {
+            return MatterError::InvalidTXSize;
+        }
+        return std::memcmp(txBytes, RESPONSE_MAGIC, 4) == 0 ? MatterError::Ok : MatterError::UnsupportedTXFormat;
+    }
+
+    // 응답 키는 요청마다 다르지만 같은 요청에 두 번 응답해도 nonce가 겹치지 않도록 nonce는 난수
+    static MatterResult<std::vector<unsigned char>> buildResponse(const ResponseContext &context, MatterError status,
+                                                                  const unsigned char *value, size_t len)
+    {
+        std::vector<unsigned char> result;
+        result.reserve(HEADER_SIZE + len + TAG_SIZE);
+        result.insert(result.end(), RESPONSE_MAGIC, RESPONSE_MAGIC + 4);
+        result.insert(result.end(), context.correlationId.begin(), context.correlationId.end());
+        result.push_back(static_cast<unsigned char>(status));
+
+        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+        for (int i = 0; i < 8; i++)
+        {
+            result.push_back(static_cast<unsigned char>((static_cast<uint64_t>(timestamp) >> (i * 8)) & 0xFF));
+        }
+
+        result.resize(HEADER_SIZE + len + TAG_SIZE);
+        if (IVSource::fill(result.data() + HEADER_SIZE - 12, 12) != 1)
+        {
+            return MatterError::RandomFailure;
+        }
+        if (!CryptoBackend::gcm(true, context.key, result.data() + HEADER_SIZE - 12, result.data(), HEADER_SIZE,
+                                value, len, result.data() + HEADER_SIZE, result.data() + HEADER_SIZE + len))
+        {
+            return MatterError::EncryptionFailed;
+        }
+        return result;
+    }
+
+    static uint64_t readLE64(const unsigned char *data) noexcept
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            value |= static_cast<uint64_t>(data[i]) << (i * 8);
+        }
+        return value;
+    }
+};
+
+// 응답을 기다리는 요청 테이블 (게이트웨이)
+// 응답은 correlationId 해시 조회 한 번으로 요청과 짝지어지고, 태그 검증이 끝난 뒤에만 테이블에서 빠진다
+// (위조된 응답으로 대기 요청을 지울 수 없음). 만료 시간은 모든 요청에 같으므로 마감 시각이 송신 순서대로
+// 쌓이고, expire는 큐 앞에서 지난 것만 꺼낸다. 이미 응답받은 요청의 큐 항목은 그때 함께 버려진다.
+class RpcClient
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Response = MatterRpc::Response;
+
+    struct Sent
+    {
+        uint64_t requestId = 0;
+        std::vector<unsigned char> txBytes;
+    };
+
+    explicit RpcClient(std::chrono::milliseconds timeout = std::chrono::seconds(5)) : timeout_(timeout) {}
+
+    Sent call(const std::string &funcName, const std::string &src_priv, const std::string &dest_pub,
+              const std::vector<std::string> &data_list)
+    {
+        return tryCall(funcName, src_priv, dest_pub, data_list).unwrap();
+    }
+
+    MatterResult<Sent> tryCall(const std::string &funcName, const std::string &src_priv, const std::string &dest_pub,
+                               const std::vector<std::string> &data_list)
+    {
+        MatterRpc::ResponseContext context;
+        MatterResult<std::vector<unsigned char>> tx =
+            MatterRpc::tryMakeRequest(funcName, src_priv, dest_pub, data_list, context);
+        if (!tx)
+        {
+            return tx.error();
+        }
+        return track(funcName, context, std::move(tx).value());
+    }
+
+    // typed 요청: client.tryCall<SetLED>(srcPriv, destPub, 1.5, true)
+    template <typename F, typename... V>
+    MatterResult<Sent> tryCall(const std::string &src_priv, const std::string &dest_pub, const V &...args)
+    {
+        MatterRpc::ResponseContext context;
+        MatterResult<std::vector<unsigned char>> tx = MatterRpc::tryMakeCall<F>(context, src_priv, dest_pub, args...);
+        if (!tx)
+        {
+            return tx.error();
+        }
+        return track(F::name(), context, std::move(tx).value());
+    }
+
+    Response receive(const std::vector<unsigned char> &txBytes)
+    {
+        return tryReceive(txBytes.data(), txBytes.size()).unwrap();
+    }
+
+    MatterResult<Response> tryReceive(const std::vector<unsigned char> &txBytes)
+    {
+        return tryReceive(txBytes.data(), txBytes.size());
+    }
+
+    // 대기 중인 요청이 없으면 UnknownRequest (만료됐거나 이미 응답받음)
+    MatterResult<Response> tryReceive(const unsigned char *txBytes, size_t txLen)
+    {
+        MatterRpc::CorrelationId id;
+        if (!MatterRpc::correlationIdOf(txBytes, txLen, id))
+        {
+            return txLen < MatterRpc::HEADER_SIZE + MatterRpc::TAG_SIZE ? MatterError::InvalidTXSize
+                                                                         : MatterError::UnsupportedTXFormat;
+        }
+
+        MatterRpc::ResponseContext context;
+        uint64_t requestId;
+        std::string funcName;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(id);
+            if (it == pending_.end())
+            {
+                return MatterError::UnknownRequest;
+            }
+            context.correlationId = id;
+            std::memcpy(context.key, it->second.key, 32);
+            requestId = it->second.requestId;
+            funcName = it->second.funcName;
+        }
+
+        // 복호화는 잠금 밖에서
+        MatterResult<Response> response = MatterRpc::tryOpenResponse(context, txBytes, txLen);
+        if (!response)
+        {
+            return response.error();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(id);
+            if (it == pending_.end() || it->second.requestId != requestId)
+            {
+                return MatterError::UnknownRequest; // 다른 스레드가 먼저 처리했거나 만료됨
+            }
+            CryptoBackend::cleanse(it->second.key, 32);
+            pending_.erase(it);
+        }
+        response.value().requestId = requestId;
+        response.value().funcName = std::move(funcName);
+        return response;
+    }
+
+    // 마감 시각이 지난 요청을 테이블에서 빼고 RequestTimeout 응답으로 반환 (주기적으로 호출)
+    std::vector<Response> expire(Clock::time_point now = Clock::now())
+    {
+        std::vector<Response> expired;
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!deadlines_.empty() && deadlines_.front().at <= now)
+        {
+            const Deadline &front = deadlines_.front();
+            auto it = pending_.find(front.id);
+            if (it != pending_.end() && it->second.requestId == front.requestId)
+            {
+                Response response;
+                response.requestId = front.requestId;
+                response.funcName = std::move(it->second.funcName);
+                response.status = MatterError::RequestTimeout;
+                expired.push_back(std::move(response));
+                CryptoBackend::cleanse(it->second.key, 32);
+                pending_.erase(it);
+            }
+            deadlines_.pop_front();
+        }
+        return expired;
+    }
+
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+    }
+
+    ~RpcClient()
+    {
+        for (auto &entry : pending_)
+        {
+            CryptoBackend::cleanse(entry.second.key, 32);
+        }
+    }
+
+private:
+    struct Pending
+    {
+        uint64_t requestId;
+        std::string funcName;
+        unsigned char key[32];
+    };
+
+    struct Deadline
+    {
+        Clock::time_point at;
+        MatterRpc::CorrelationId id;
+        uint64_t requestId;
+    };
+
+    // correlationId는 SHA-256 출력이므로 앞 8바이트를 그대로 해시값으로 사용
+    struct IdHash
+    {
+        size_t operator()(const MatterRpc::CorrelationId &id) const noexcept
+        {
+            uint64_t h;
+            std::memcpy(&h, id.data(), sizeof(h));
+            return static_cast<size_t>(h);
+        }
+    };
+
+    MatterResult<Sent> track(const std::string &funcName, const MatterRpc::ResponseContext &context,
+                             std::vector<unsigned char> txBytes)
+    {
+        Sent sent;
+        sent.txBytes = std::move(txBytes);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        sent.requestId = ++nextRequestId_;
+        Pending &entry = pending_[context.correlationId];
+        entry.requestId = sent.requestId;
+        entry.funcName = funcName;
+        std::memcpy(entry.key, context.key, 32);
+        deadlines_.push_back(Deadline{Clock::now() + timeout_, context.correlationId, sent.requestId});
+        return sent;
+    }
+
+    std::chrono::milliseconds timeout_;
+    mutable std::mutex mutex_;
+    uint64_t nextRequestId_ = 0;
+    std::unordered_map<MatterRpc::CorrelationId, Pending, IdHash> pending_;
+    std::deque<Deadline> deadlines_; // 마감 시각 순 (송신 순서)
+};
@@ -0,0 +1,429 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include "./matter_tunnel.cpp"
+
+// 세션 모드
+// 최초 1회만 ECDH를 수행하고, 이후 TX는 공개키 대신 세션ID + 카운터 nonce를 사용한다.
+//
+// 핸드셰이크 (2메시지):
+//   1. 개시자 -> 응답자: 일반 서명 TX (funcName = SESSION_FUNC_NAME, data = [salt(hex), 이전 세션ID(hex)])
+//   2. 응답자 -> 개시자: 일반 서명 TX (funcName = SESSION_ACK_FUNC_NAME, data = [응답자 nonce(hex), salt(hex)])
+//   세션키는 salt와 응답자 nonce로 파생하므로, 재전송된 핸드셰이크로는 이전 세션키/nonce가 다시 만들어지지 않는다.
+// 세션 TX: sessionId(8) + counter(8) + funcName(18) + timestamp(8) + AES-256-GCM 암호문 + tag(16)
+//          헤더 42바이트는 GCM AAD로 인증됨
+class MatterSession
+{
+public:
+    static constexpr const char *SESSION_FUNC_NAME = "__session";
+    static constexpr const char *SESSION_ACK_FUNC_NAME = "__session_ack";
+    static constexpr size_t SALT_SIZE = 16;
+    static constexpr size_t SESSION_ID_SIZE = 8;
+    static constexpr size_t HEADER_SIZE = SESSION_ID_SIZE + 8 + 18 + 8;
+    static constexpr size_t TAG_SIZE = 16;
+
+    // 세션 만료 조건 (둘 중 하나라도 도달하면 재협상 필요)
+    struct Limits
+    {
+        uint64_t maxMessages;        // 방향별 최대 TX 수
+        uint64_t maxLifetimeSeconds; // 세션 수명
+        uint64_t maxHandshakeSkew;   // 핸드셰이크 TX 타임스탬프 허용 오차 (초)
+
+        Limits(uint64_t maxMessages = 1ULL << 32, uint64_t maxLifetimeSeconds = 3600,
+               uint64_t maxHandshakeSkew = 300)
+            : maxMessages(maxMessages), maxLifetimeSeconds(maxLifetimeSeconds),
+              maxHandshakeSkew(maxHandshakeSkew)
+        {
+        }
+    };
+
+    // 세션 시작 (개시자): handshakeTX를 상대에게 전송하고, 응답을 complete()에 넘겨야 세션이 열림
+    static MatterSession initiate(const std::string &srcPriv, const std::string &destPub,
+                                  std::vector<unsigned char> &handshakeTX,
+                                  const Limits &limits = Limits())
+    {
+        MatterSession session(true, limits);
+        session.peerPub_ = destPub;
+        session.sharedKey_ = MatterTunnel::getSharedKey(srcPriv, destPub);
+        handshakeTX = session.startEpoch(srcPriv, "");
+        return session;
+    }
+
+    // 세션 수락 (응답자): 핸드셰이크 TX 검증 후 세션 생성, responseTX를 개시자에게 전송해야 함
+    static MatterSession accept(const std::string &privateKey,
+                                const std::vector<unsigned char> &handshakeTX,
+                                std::vector<unsigned char> &responseTX,
+                                const Limits &limits = Limits())
+    {
+        MatterSession session(false, limits);
+        MatterTunnel::TXHeader header = session.openHandshake(handshakeTX, SESSION_FUNC_NAME);
+        session.peerPub_ = header.srcPub;
+        session.sharedKey_ = MatterTunnel::getSharedKey(privateKey, header.srcPub);
+        responseTX = session.respond(privateKey, handshakeTX, header, false);
+        return session;
+    }
+
+    // 핸드셰이크 완료 (개시자): 응답자의 응답 TX 검증 후 세션키 적용 (initiate, rekey 공통)
+    void complete(const std::vector<unsigned char> &responseTX)
+    {
+        if (!initiator_ || !pending_)
+        {
+            throw std::runtime_error("No pending session handshake");
+        }
+
+        MatterTunnel::TXHeader header = openHandshake(responseTX, SESSION_ACK_FUNC_NAME);
+        if (header.srcPub != peerPub_)
+        {
+            throw std::runtime_error("Handshake from unexpected peer");
+        }
+        std::vector<std::string> dataList = verifyHandshake(responseTX, header);
+        if (dataList[1] != MatterTunnel::bytesToHex(pendingSalt_, SALT_SIZE))
+        {
+            throw std::runtime_error("Handshake does not match session");
+        }
+
+        std::vector<unsigned char> responderNonce = MatterTunnel::hexToBytes(dataList[0]);
+        deriveKeys(pendingSalt_, responderNonce.data());
+        CryptoBackend::cleanse(pendingSalt_, SALT_SIZE);
+        pending_ = false;
+        established_ = true;
+    }
+
+    // 재협상 (개시자): 캐시된 공유키를 재사용하므로 ECDH 없이 새 세션키를 만든다
+    // 응답을 complete()에 넘길 때까지는 현재 세션키를 계속 사용
+    std::vector<unsigned char> rekey(const std::string &srcPriv)
+    {
+        if (!initiator_)
+        {
+            throw std::runtime_error("Only the initiator can rekey");
+        }
+        if (!established_)
+        {
+            throw std::runtime_error("Session not established");
+        }
+        return startEpoch(srcPriv, MatterTunnel::bytesToHex(sessionId_, SESSION_ID_SIZE));
+    }
+
+    // 재협상 수락 (응답자): 반환된 응답 TX를 개시자에게 전송해야 함
+    std::vector<unsigned char> acceptRekey(const std::string &privateKey,
+                                           const std::vector<unsigned char> &handshakeTX)
+    {
+        MatterTunnel::TXHeader header = openHandshake(handshakeTX, SESSION_FUNC_NAME);
+        if (header.srcPub != peerPub_)
+        {
+            throw std::runtime_error("Handshake from unexpected peer");
+        }
+        return respond(privateKey, handshakeTX, header, true);
+    }
+
+    // 세션 만료 여부
+    bool expired() const
+    {
+        auto age = std::chrono::steady_clock::now() - establishedAt_;
+        return sendCounter_ >= limits_.maxMessages ||
+               recvCounter_ >= limits_.maxMessages ||
+               std::chrono::duration_cast<std::chrono::seconds>(age).count() >=
+                   static_cast<long long>(limits_.maxLifetimeSeconds);
+    }
+
+    bool established() const { return established_; }
+    const unsigned char *sessionId() const { return sessionId_; }
+
+    // 세션 TX의 세션ID 조회 (게이트웨이에서 세션 테이블 검색용)
+    static std::string peekSessionId(const std::vector<unsigned char> &txBytes)
+    {
+        if (txBytes.size() < SESSION_ID_SIZE)
+        {
+            throw std::runtime_error("Invalid session TX size");
+        }
+        return MatterTunnel::bytesToHex(txBytes.data(), SESSION_ID_SIZE);
+    }
+
+    // 세션 TX 생성
+    std::vector<unsigned char> makeTX(const std::string &funcName,
+                                      const std::vector<std::string> &data_list)
+    {
+        if (!established_)
+        {
+            throw std::runtime_error("Session not established");
+        }
+        if (expired())
+        {
+            throw std::runtime_error("Session expired");
+        }
+
+        uint64_t counter = ++sendCounter_;
+
+        // 1. 헤더 조합
+        std::vector<unsigned char> result;
+        result.insert(result.end(), sessionId_, sessionId_ + SESSION_ID_SIZE);
+        appendLE64(result, counter);
+
+        std::string paddedFuncName = funcName;
+        paddedFuncName.resize(18, '\0');
+        result.insert(result.end(), paddedFuncName.begin(), paddedFuncName.end());
+
+        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+        appendLE64(result, static_cast<uint64_t>(timestamp));
+
+        // 2. 데이터 직렬화 및 암호화 (헤더는 AAD)
+        std::vector<unsigned char> serializedData = MatterTunnel::serializeDataList(data_list);
+        unsigned char nonce[12];
+        makeNonce(nonce, initiator_, counter);
+
+        size_t headerLen = result.size();
+        result.resize(headerLen + serializedData.size() + TAG_SIZE);
+        aesGcm(true, sendKey_, nonce, result.data(), headerLen,
+               serializedData.data(), serializedData.size(),
+               result.data() + headerLen, result.data() + headerLen + serializedData.size());
+
+        return result;
+    }
+
+    // 세션 TX 복호화 (JSON 형식은 MatterTunnel::extractTXData와 동일, srcPub은 세션 상대)
+    std::string extractTXData(const std::vector<unsigned char> &txBytes)
+    {
+        if (txBytes.size() < HEADER_SIZE + TAG_SIZE)
+        {
+            throw std::runtime_error("Invalid session TX size");
+        }
+        if (!established_)
+        {
+            throw std::runtime_error("Session not established");
+        }
+        if (std::memcmp(txBytes.data(), sessionId_, SESSION_ID_SIZE) != 0)
+        {
+            throw std::runtime_error("Unknown session");
+        }
+        if (expired())
+        {
+            throw std::runtime_error("Session expired");
+        }
+
+        // 1. 카운터 확인 (재전송 방지, 단조 증가)
+        uint64_t counter = readLE64(txBytes.data() + SESSION_ID_SIZE);
+        if (counter <= recvCounter_)
+        {
+            throw std::runtime_error("Replayed session TX");
+        }
+
+        // 2. 복호화 및 인증
+        unsigned char nonce[12];
+        makeNonce(nonce, !initiator_, counter);
+
+        size_t cipherLen = txBytes.size() - HEADER_SIZE - TAG_SIZE;
+        std::vector<unsigned char> plaintext(cipherLen);
+        aesGcm(false, recvKey_, nonce, txBytes.data(), HEADER_SIZE,
+               txBytes.data() + HEADER_SIZE, cipherLen,
+               plaintext.data(), const_cast<unsigned char *>(txBytes.data() + HEADER_SIZE + cipherLen));
+        recvCounter_ = counter;
+
+        // 3. 헤더 파싱
+        MatterTunnel::TXHeader header = {};
+        const unsigned char *namePtr = txBytes.data() + SESSION_ID_SIZE + 8;
+        header.funcName = std::string(namePtr, namePtr + 18);
+        header.funcName = header.funcName.substr(0, header.funcName.find('\0'));
+        header.srcPub = peerPub_;
+        header.timestamp = readLE64(namePtr + 18);
+        header.format = MatterTunnel::TX_FORMAT_LEGACY;
+        header.payloadOffset = HEADER_SIZE;
+
+        // 4. 역직렬화 후 JSON 생성
+        std::vector<std::string> dataList = MatterTunnel::deserializeDataList(
+            std::string(plaintext.begin(), plaintext.end()));
+        return MatterTunnel::txToJSON(header, dataList);
+    }
+
+private:
+    MatterSession(bool initiator, const Limits &limits)
+        : initiator_(initiator), limits_(limits)
+    {
+    }
+
+    // 새 salt로 핸드셰이크 TX 생성 (세션키는 응답을 받은 뒤 complete()에서 파생)
+    std::vector<unsigned char> startEpoch(const std::string &srcPriv, const std::string &prevIdHex)
+    {
+        if (IVSource::fill(pendingSalt_, SALT_SIZE) != 1)
+        {
+            throw std::runtime_error("Failed to generate session salt");
+        }
+
+        std::vector<std::string> handshakeData = {MatterTunnel::bytesToHex(pendingSalt_, SALT_SIZE), prevIdHex};
+        std::vector<unsigned char> handshakeTX =
+            MatterTunnel::buildTX(SESSION_FUNC_NAME, srcPriv, sharedKey_, handshakeData);
+
+        pending_ = true;
+        return handshakeTX;
+    }
+
+    // 핸드셰이크 TX 사전 검사, 헤더 파싱, 타임스탬프 확인 (서명 검증 전)
+    MatterTunnel::TXHeader openHandshake(const std::vector<unsigned char> &handshakeTX,
+                                         const char *funcName) const
+    {
+        MatterError error = MatterTunnel::precheckTX(handshakeTX.data(), handshakeTX.size());
+        if (error != MatterError::Ok)
+        {
+            throwMatterError(error);
+        }
+
+        MatterTunnel::TXHeader header = MatterTunnel::parseTXHeader(handshakeTX.data() + 64,
+                                                                    handshakeTX.size() - 64);
+        if (header.funcName != funcName)
+        {
+            throw std::runtime_error("Not a session handshake");
+        }
+
+        uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                                 std::chrono::system_clock::now().time_since_epoch())
+                                                 .count());
+        uint64_t skew = header.timestamp > now ? header.timestamp - now : now - header.timestamp;
+        if (skew > limits_.maxHandshakeSkew)
+        {
+            throw std::runtime_error("Stale session handshake");
+        }
+        return header;
+    }
+
+    // 핸드셰이크 TX 서명 검증 및 복호화: data = [nonce 또는 salt(hex), 세션ID 또는 salt(hex)]
+    std::vector<std::string> verifyHandshake(const std::vector<unsigned char> &handshakeTX,
+                                             const MatterTunnel::TXHeader &header) const
+    {
+        const unsigned char *txData = handshakeTX.data() + 64;
+        size_t txDataLen = handshakeTX.size() - 64;
+        MatterTunnel::verifyTXSignature(handshakeTX.data(), txData, txDataLen, header.srcPub);
+
+        std::vector<std::string> dataList =
+            MatterTunnel::decryptTXPayload(sharedKey_, header, txData, txDataLen);
+        if (dataList.size() != 2 || dataList[0].length() != SALT_SIZE * 2)
+        {
+            throw std::runtime_error("Invalid session handshake");
+        }
+        return dataList;
+    }
+
+    // 핸드셰이크 TX 검증 후 응답자 nonce를 섞어 세션키를 적용하고 응답 TX 생성
+    std::vector<unsigned char> respond(const std::string &privateKey,
+                                       const std::vector<unsigned char> &handshakeTX,
+                                       const MatterTunnel::TXHeader &header, bool isRekey)
+    {
+        std::vector<std::string> dataList = verifyHandshake(handshakeTX, header);
+
+        // 재협상이면 현재 세션을 가리켜야 함
+        std::string expectedPrev = isRekey ? MatterTunnel::bytesToHex(sessionId_, SESSION_ID_SIZE) : "";
+        if (dataList[1] != expectedPrev)
+        {
+            throw std::runtime_error("Handshake does not match session");
+        }
+
+        unsigned char responderNonce[SALT_SIZE];
+        if (IVSource::fill(responderNonce, sizeof(responderNonce)) != 1)
+        {
+            throw std::runtime_error("Failed to generate session nonce");
+        }
+
+        std::vector<std::string> responseData = {MatterTunnel::bytesToHex(responderNonce, sizeof(responderNonce)),
+                                                 dataList[0]};
+        std::vector<unsigned char> responseTX =
+            MatterTunnel::buildTX(SESSION_ACK_FUNC_NAME, privateKey, sharedKey_, responseData);
+
+        std::vector<unsigned char> salt = MatterTunnel::hexToBytes(dataList[0]);
+        deriveKeys(salt.data(), responderNonce);
+        established_ = true;
+        return responseTX;
+    }
+
+    // 공유키 + salt + 응답자 nonce로 방향별 세션키와 세션ID 파생
+    void deriveKeys(const unsigned char *salt, const unsigned char *responderNonce)
+    {
+        unsigned char initiatorKey[32];
+        unsigned char responderKey[32];
+        unsigned char idHash[32];
+        kdf("matter-session-i", salt, responderNonce, initiatorKey);
+        kdf("matter-session-r", salt, responderNonce, responderKey);
+        kdf("matter-session-id", salt, responderNonce, idHash);
+
+        std::memcpy(sendKey_, initiator_ ? initiatorKey : responderKey, 32);
+        std::memcpy(recvKey_, initiator_ ? responderKey : initiatorKey, 32);
+        std::memcpy(sessionId_, idHash, SESSION_ID_SIZE);
+
+        CryptoBackend::cleanse(initiatorKey, sizeof(initiatorKey));
+        CryptoBackend::cleanse(responderKey, sizeof(responderKey));
+
+        sendCounter_ = 0;
+        recvCounter_ = 0;
+        establishedAt_ = std::chrono::steady_clock::now();
+    }
+
+    // SHA-256(label || sharedKey || salt || responderNonce)
+    void kdf(const char *label, const unsigned char *salt, const unsigned char *responderNonce,
+             unsigned char out[32]) const
+    {
+        std::string input = label + sharedKey_;
+        input.append(reinterpret_cast<const char *>(salt), SALT_SIZE);
+        input.append(reinterpret_cast<const char *>(responderNonce), SALT_SIZE);
+        MatterTunnel::sha256(input, out);
+        CryptoBackend::cleanse(&input[0], input.length());
+    }
+
+    // nonce = direction(4) + counter(8)
+    static void makeNonce(unsigned char nonce[12], bool fromInitiator, uint64_t counter)
+    {
+        std::memset(nonce, 0, 4);
+        nonce[3] = fromInitiator ? 0x01 : 0x02;
+        for (int i = 0; i < 8; i++)
+        {
+            nonce[4 + i] = static_cast<unsigned char>((counter >> (i * 8)) & 0xFF);
+        }
+    }
+
+    // AES-256-GCM 암호화/복호화 (복호화 시 tag 검증 실패하면 예외)
+    static void aesGcm(bool encrypting, const unsigned char key[32], const unsigned char nonce[12],
+                       const unsigned char *aad, size_t aadLen,
+                       const unsigned char *in, size_t inLen,
+                       unsigned char *out, unsigned char *tag)
+    {
+        if (!CryptoBackend::gcm(encrypting, key, nonce, aad, aadLen, in, inLen, out, tag))
+        {
+            throw std::runtime_error(encrypting ? "Failed to encrypt session TX"
+                                                : "Failed to authenticate session TX");
+        }
+    }
+
+    static void appendLE64(std::vector<unsigned char> &out, uint64_t value)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            out.push_back(static_cast<unsigned char>((value >> (i * 8)) & 0xFF));
+        }
+    }
+
+    static uint64_t readLE64(const unsigned char *data)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            value |= static_cast<uint64_t>(data[i]) << (i * 8);
+        }
+        return value;
+    }
+
+    bool initiator_;
+    Limits limits_;
+    std::string peerPub_;
+    std::string sharedKey_; // ECDH 결과 (16진수), 재협상 시 재사용
+    unsigned char sessionId_[SESSION_ID_SIZE] = {0};
+    unsigned char sendKey_[32] = {0};
+    unsigned char recvKey_[32] = {0};
+    unsigned char pendingSalt_[SALT_SIZE] = {0}; // 개시자: 응답 대기 중인 핸드셰이크의 salt
+    bool pending_ = false;
+    bool established_ = false;
+    uint64_t sendCounter_ = 0;
+    uint64_t recvCounter_ = 0;
+    std::chrono::steady_clock::time_point establishedAt_;
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "./matter_tunnel.cpp"
+
+// 스트리밍 암호화
+// MatterTunnel::encrypt와 같은 형식(IV(16) + AES-256-CBC 암호문)을 청크 단위로 생성한다.
+// 출력 바이트를 모두 이어 붙여 16진수로 바꾸면 decrypt에 그대로 넣을 수 있다.
+// 메모리 사용량은 청크 크기 + 블록 1개로 고정된다.
+class MatterTunnel::Encryptor
+{
+public:
+    explicit Encryptor(const std::string &key)
+    {
+        unsigned char keyHash[32];
+        hashKey(key, keyHash);
+
+        if (IVSource::fill(iv_, sizeof(iv_)) != 1)
+        {
+            throw std::runtime_error("Failed to generate IV");
+        }
+
+        bool ok = cipher_.init(CryptoBackend::Cipher::CBC, true, keyHash, iv_);
+        CryptoBackend::cleanse(keyHash, sizeof(keyHash));
+        if (!ok)
+        {
+            throw std::runtime_error("Failed to initialize CBC mode");
+        }
+    }
+
+    Encryptor(const Encryptor &) = delete;
+    Encryptor &operator=(const Encryptor &) = delete;
+
+    // 청크 암호화, 결과를 out 뒤에 덧붙임 (첫 출력에는 IV 포함)
+    void update(const unsigned char *data, size_t len, std::vector<unsigned char> &out)
+    {
+        if (finalized_)
+        {
+            throw std::runtime_error("Encryptor already finalized");
+        }
+        writeIV(out);
+
+        size_t offset = out.size();
+        out.resize(offset + len + 16);
+        size_t outLen = 0;
+        if (!cipher_.update(data, len, out.data() + offset, outLen))
+        {
+            throw std::runtime_error("Failed to encrypt message");
+        }
+        out.resize(offset + outLen);
+    }
+
+    void update(const std::string &chunk, std::vector<unsigned char> &out)
+    {
+        update(reinterpret_cast<const unsigned char *>(chunk.data()), chunk.length(), out);
+    }
+
+    // 마지막 블록(패딩 포함)을 out 뒤에 덧붙임
+    void finalize(std::vector<unsigned char> &out)
+    {
+        if (finalized_)
+        {
+            throw std::runtime_error("Encryptor already finalized");
+        }
+        writeIV(out);
+
+        size_t offset = out.size();
+        out.resize(offset + 16);
+        size_t outLen = 0;
+        if (!cipher_.finish(out.data() + offset, outLen))
+        {
+            throw std::runtime_error("Failed to finalize encryption");
+        }
+        out.resize(offset + outLen);
+        finalized_ = true;
+    }
+
+private:
+    void writeIV(std::vector<unsigned char> &out)
+    {
+        if (!ivWritten_)
+        {
+            out.insert(out.end(), iv_, iv_ + sizeof(iv_));
+            ivWritten_ = true;
+        }
+    }
+
+    CryptoBackend::Cipher cipher_;
+    unsigned char iv_[16];
+    bool ivWritten_ = false;
+    bool finalized_ = false;
+};
+
+// 스트리밍 복호화
+// encrypt 결과(16진수를 바이트로 변환한 것) 또는 Encryptor 출력을 임의 크기 청크로 받는다.
+// 앞의 16바이트는 IV로 사용하고, 패딩은 finalize에서 제거한다.
+class MatterTunnel::Decryptor
+{
+public:
+    explicit Decryptor(const std::string &key)
+    {
+        hashKey(key, keyHash_);
+    }
+
+    ~Decryptor()
+    {
+        CryptoBackend::cleanse(keyHash_, sizeof(keyHash_));
+    }
+
+    Decryptor(const Decryptor &) = delete;
+    Decryptor &operator=(const Decryptor &) = delete;
+
+    // 청크 복호화, 평문을 out 뒤에 덧붙임
+    void update(const unsigned char *data, size_t len, std::vector<unsigned char> &out)
+    {
+        if (finalized_)
+        {
+            throw std::runtime_error("Decryptor already finalized");
+        }
+
+        // IV가 다 모일 때까지 버퍼링
+        while (ivLen_ < sizeof(iv_) && len > 0)
+        {
+            iv_[ivLen_++] = *data++;
+            len--;
+            if (ivLen_ == sizeof(iv_) &&
+                !cipher_.init(CryptoBackend::Cipher::CBC, false, keyHash_, iv_))
+            {
+                throw std::runtime_error("Failed to initialize CBC mode");
+            }
+        }
+        if (len == 0)
+        {
+            return;
+        }
+
+        size_t offset = out.size();
+        out.resize(offset + len + 16);
+        size_t outLen = 0;
+        if (!cipher_.update(data, len, out.data() + offset, outLen))
+        {
+            throw std::runtime_error("Failed to decrypt message");
+        }
+        out.resize(offset + outLen);
+    }
+
+    void update(const std::vector<unsigned char> &chunk, std::vector<unsigned char> &out)
+    {
+        update(chunk.data(), chunk.size(), out);
+    }
+
+    // 마지막 블록의 패딩 검증 및 제거
+    void finalize(std::vector<unsigned char> &out)
+    {
+        if (finalized_)
+        {
+            throw std::runtime_error("Decryptor already finalized");
+        }
+        if (ivLen_ < sizeof(iv_))
+        { // 최소 IV(16) 필요
+            throw std::runtime_error("Invalid encrypted data length");
+        }
+
+        size_t offset = out.size();
+        out.resize(offset + 16);
+        size_t outLen = 0;
+        if (!cipher_.finish(out.data() + offset, outLen))
+        {
+            throw std::runtime_error("Failed to finalize decryption");
+        }
+        out.resize(offset + outLen);
+        finalized_ = true;
+    }
+
+private:
+    CryptoBackend::Cipher cipher_;
+    unsigned char keyHash_[32];
+    unsigned char iv_[16];
+    size_t ivLen_ = 0;
+    bool finalized_ = false;
+};
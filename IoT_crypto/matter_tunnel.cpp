@@ -1,88 +1,206 @@
-#include <openssl/ec.h>
-#include <openssl/ecdsa.h>
-#include <openssl/rand.h>
-#include <openssl/aes.h>
+#pragma once
+
 #include <string>
 #include <vector>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
 #include <stdexcept>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <string_view>
+#include "./crypto_backend.cpp"
+#include "./matter_result.cpp"
+#include "./device_info.cpp"
+#include "./iv_source.cpp"
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+class MatterSession;
+class MatterRpc;
+class DeviceRegistry;
+class RegistrySnapshot;
+class Keyring;
+template <typename Name, typename Signature>
+struct TypedFunction;
 
 class MatterTunnel
 {
+    friend class MatterSession;
+    friend class MatterRpc;
+    friend class DeviceRegistry;
+    friend class RegistrySnapshot;
+    friend class Keyring;
+    template <typename Name, typename Signature>
+    friend struct TypedFunction;
+
+public:
+    // 대용량 payload용 스트리밍 암호화/복호화 (matter_stream.cpp)
+    class Encryptor;
+    class Decryptor;
+
+    // TX payload 형식 (funcName 바로 뒤 1바이트)
+    // 기존 TX는 이 위치가 압축 공개키 prefix(0x02/0x03)이므로 그대로 구분된다.
+    static constexpr unsigned char TX_FORMAT_LEGACY = 0x00;  // IV + AES-256-CBC(직렬화 데이터)
+    static constexpr unsigned char TX_FORMAT_INDEXED = 0x11; // IV + 항목 인덱스 + AES-256-CTR(항목들)
+
+    // format에 더하면 format 바이트 뒤에 수신자 힌트가 붙는다 (기존 형식 0x20, INDEXED 0x31)
+    // 힌트 = SHA-256("matter-dest" || 수신자 압축 공개키)[0..8), 서명 범위에 포함된다.
+    // 여러 개인키를 가진 게이트웨이(Keyring)가 시험 복호화 없이 키를 고를 수 있다.
+    static constexpr unsigned char TX_FLAG_DEST_HINT = 0x20;
+    static constexpr size_t DEST_HINT_SIZE = 8;
+
 private:
+    // 16진수 변환 (SIMD 빌드(-msimd128)에서는 16바이트 단위 벡터 처리)
     static std::string bytesToHex(const unsigned char *data, size_t len)
     {
-        std::stringstream ss;
-        ss << std::hex << std::setfill('0');
-        for (size_t i = 0; i < len; i++)
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(len * 2, '\0');
+        char *out = &hex[0];
+        size_t i = 0;
+
+#if defined(__wasm_simd128__)
+        const v128_t table = wasm_i8x16_make('0', '1', '2', '3', '4', '5', '6', '7',
+                                             '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+        const v128_t mask = wasm_i8x16_splat(0x0f);
+        for (; i + 16 <= len; i += 16)
+        {
+            v128_t v = wasm_v128_load(data + i);
+            v128_t hiChars = wasm_i8x16_swizzle(table, wasm_u8x16_shr(v, 4));
+            v128_t loChars = wasm_i8x16_swizzle(table, wasm_v128_and(v, mask));
+            wasm_v128_store(out + i * 2, wasm_i8x16_shuffle(hiChars, loChars,
+                                                            0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23));
+            wasm_v128_store(out + i * 2 + 16, wasm_i8x16_shuffle(hiChars, loChars,
+                                                                 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+        }
+#endif
+
+        for (; i < len; i++)
         {
-            ss << std::setw(2) << static_cast<int>(data[i]);
+            out[i * 2] = digits[data[i] >> 4];
+            out[i * 2 + 1] = digits[data[i] & 0x0f];
         }
-        return ss.str();
+        return hex;
     }
 
     static std::vector<unsigned char> hexToBytes(const std::string &hex)
     {
         std::vector<unsigned char> bytes;
-        for (size_t i = 0; i < hex.length(); i += 2)
+        if (decodeHex(hex, bytes) != MatterError::Ok)
         {
-            std::string byteString = hex.substr(i, 2);
-            unsigned char byte = static_cast<unsigned char>(std::stoi(byteString, nullptr, 16));
-            bytes.push_back(byte);
+            throwMatterError(MatterError::InvalidHex);
         }
         return bytes;
     }
 
-    static std::string getTypeString(uint16_t types)
+    static MatterError decodeHex(const std::string &hex, std::vector<unsigned char> &bytes)
     {
-        std::string result;
-        // 상위 14비트에서 7개의 2비트 패턴 처리 (인자)
-        for (int i = 6; i >= 0; i--)
+        bytes.resize((hex.length() + 1) / 2);
+        const unsigned char *in = reinterpret_cast<const unsigned char *>(hex.data());
+        size_t i = 0;
+
+#if defined(__wasm_simd128__)
+        const v128_t zero = wasm_i8x16_splat('0');
+        const v128_t lowerA = wasm_i8x16_splat('a');
+        const v128_t caseBit = wasm_i8x16_splat(0x20);
+        const v128_t nine = wasm_i8x16_splat(9);
+        const v128_t five = wasm_i8x16_splat(5);
+        const v128_t ten = wasm_i8x16_splat(10);
+
+        // 문자 16개를 nibble로 변환, 16진수 문자가 아니면 valid 레인이 0
+        auto toNibbles = [&](v128_t c, v128_t &valid) {
+            v128_t digit = wasm_i8x16_sub(c, zero);
+            v128_t alpha = wasm_i8x16_sub(wasm_v128_or(c, caseBit), lowerA);
+            v128_t isDigit = wasm_u8x16_le(digit, nine);
+            v128_t isAlpha = wasm_u8x16_le(alpha, five);
+            valid = wasm_v128_or(isDigit, isAlpha);
+            return wasm_v128_bitselect(digit, wasm_i8x16_add(alpha, ten), isDigit);
+        };
+
+        for (; i + 32 <= hex.length(); i += 32)
         {
-            uint16_t argType = (types >> (i * 2 + 2)) & 0x03;
-            if (argType == 0x00)
-                break; // void는 더 이상의 인자가 없음을 의미
+            v128_t validA, validB;
+            v128_t a = toNibbles(wasm_v128_load(in + i), validA);
+            v128_t b = toNibbles(wasm_v128_load(in + i + 16), validB);
+            if (!wasm_i8x16_all_true(wasm_v128_and(validA, validB)))
+            {
+                break; // 잘못된 문자는 아래 스칼라 경로에서 처리
+            }
 
-            if (result.length() > 0)
-                result += ",";
+            v128_t hi = wasm_i8x16_shuffle(a, b, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+            v128_t lo = wasm_i8x16_shuffle(a, b, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+            wasm_v128_store(bytes.data() + i / 2, wasm_v128_or(wasm_i8x16_shl(hi, 4), lo));
+        }
+#endif
 
-            switch (argType)
+        for (; i < hex.length(); i += 2)
+        {
+            int hi = hexDigit(in[i]);
+            int lo = i + 1 < hex.length() ? hexDigit(in[i + 1]) : -1;
+            if (hi < 0 || (i + 1 < hex.length() && lo < 0))
             {
-            case 0x01:
-                result += "string";
-                break;
-            case 0x02:
-                result += "number";
-                break;
-            case 0x03:
-                result += "boolean";
-                break;
+                return MatterError::InvalidHex;
             }
+            // 홀수 길이의 마지막 한 자리는 그 값 그대로
+            bytes[i / 2] = static_cast<unsigned char>(lo < 0 ? hi : (hi << 4) | lo);
         }
+        return MatterError::Ok;
+    }
+
+    static int hexDigit(unsigned char c) noexcept
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        c |= 0x20;
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        return -1;
+    }
 
-        result += ")";
+    // AES 키 생성: 공유키 문자열의 SHA-256
+    static void hashKey(const std::string &key, unsigned char keyHash[32]) noexcept
+    {
+        sha256(key, keyHash);
+    }
+
+    static void sha256(const std::string &data, unsigned char hash[32]) noexcept
+    {
+        CryptoBackend::sha256(reinterpret_cast<const unsigned char *>(data.data()), data.length(), hash);
+    }
 
-        // 하위 2비트 처리 (반환값)
-        std::string returnType;
-        switch (types & 0x03)
+    // 16진수 개인키를 32바이트로 (짧으면 앞을 0으로 채움)
+    static MatterError privateKeyBytes(const std::string &privateKeyHex, unsigned char priv[32])
+    {
+        std::vector<unsigned char> bytes;
+        MatterError error = decodeHex(privateKeyHex, bytes);
+        if (error == MatterError::Ok && bytes.size() > 32)
         {
-        case 0x00:
-            returnType = "void";
-            break;
-        case 0x01:
-            returnType = "string";
-            break;
-        case 0x02:
-            returnType = "number";
-            break;
-        case 0x03:
-            returnType = "boolean";
-            break;
+            error = MatterError::InvalidPrivateKey;
+        }
+        if (error == MatterError::Ok)
+        {
+            std::memset(priv, 0, 32 - bytes.size());
+            std::memcpy(priv + 32 - bytes.size(), bytes.data(), bytes.size());
         }
+        CryptoBackend::cleanse(bytes.data(), bytes.size());
+        return error;
+    }
 
-        return result + "->" + returnType;
+    // 16진수 공개키(압축/비압축)를 검증 후 비압축 65바이트로
+    static MatterError publicKeyBytes(const std::string &publicKeyHex, unsigned char pub[65])
+    {
+        std::vector<unsigned char> bytes;
+        if (decodeHex(publicKeyHex, bytes) != MatterError::Ok)
+        {
+            return MatterError::InvalidHex;
+        }
+        return CryptoBackend::parsePublicKey(bytes.data(), bytes.size(), pub) ? MatterError::Ok
+                                                                              : MatterError::InvalidPublicKeyPoint;
     }
 
     // 데이터 리스트 직렬화를 위한 메서드
@@ -130,667 +248,1981 @@ private:
     }
 
 public:
+    // 예외 API는 아래 try* 함수의 래퍼이며, 실패 시 MatterError 메시지로 예외를 던진다.
+    // try* 함수는 입력/암호 연산 오류를 MatterResult의 오류 코드로 반환한다.
+    // 메모리 할당 실패(std::bad_alloc)는 오류 코드로 바꾸지 않고 그대로 전파되므로 할당하는 함수는 noexcept가 아니다.
+
     // 시크릿키 생성 (64자리 16진수 문자열 반환)
     static std::string generatePrivateKey()
     {
-        unsigned char privateKey[32];
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        if (!key)
-        {
-            throw std::runtime_error("Failed to create EC_KEY");
-        }
+        return tryGeneratePrivateKey().unwrap();
+    }
 
-        if (!EC_KEY_generate_key(key))
+    static MatterResult<std::string> tryGeneratePrivateKey()
+    {
+        unsigned char privateKey[32];
+        if (!CryptoBackend::generatePrivateKey(privateKey))
         {
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to generate private key");
+            return MatterError::KeyGenerationFailed;
         }
 
-        const BIGNUM *priv = EC_KEY_get0_private_key(key);
-        BN_bn2binpad(priv, privateKey, 32);
-        EC_KEY_free(key);
-
-        return bytesToHex(privateKey, 32);
+        std::string result = bytesToHex(privateKey, 32);
+        CryptoBackend::cleanse(privateKey, sizeof(privateKey));
+        return result;
     }
 
     // 공개키 파생 (16진수 문자열 반환)
     static std::string derivePublicKey(const std::string &privateKeyHex)
     {
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        if (!key)
+        return tryDerivePublicKey(privateKeyHex).unwrap();
+    }
+
+    static MatterResult<std::string> tryDerivePublicKey(const std::string &privateKeyHex)
+    {
+        unsigned char publicKey[65];
+        MatterError error = derivePublicKeyBytes(privateKeyHex, publicKey);
+        if (error != MatterError::Ok)
         {
-            throw std::runtime_error("Failed to create EC_KEY");
+            return error;
         }
+        return bytesToHex(publicKey, 65);
+    }
+
+    // 개인키/공개키 쌍 (16진수, 공개키는 비압축)
+    struct KeyPair
+    {
+        std::string privateKey;
+        std::string publicKey;
+    };
 
-        BIGNUM *priv = BN_new();
-        std::vector<unsigned char> privateKeyBytes = hexToBytes(privateKeyHex);
-        BN_bin2bn(privateKeyBytes.data(), privateKeyBytes.size(), priv);
+    // generatePrivateKey + derivePublicKey를 한 번의 생성점 곱셈으로
+    static KeyPair generateKeyPair()
+    {
+        return tryGenerateKeyPair().unwrap();
+    }
 
-        if (!EC_KEY_set_private_key(key, priv))
+    static MatterResult<KeyPair> tryGenerateKeyPair()
+    {
+        unsigned char priv[32], pub[65];
+        if (!CryptoBackend::generateKeyPair(priv, pub))
         {
-            BN_free(priv);
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to set private key");
+            CryptoBackend::cleanse(priv, sizeof(priv));
+            return MatterError::KeyGenerationFailed;
         }
 
-        const EC_GROUP *group = EC_KEY_get0_group(key);
-        EC_POINT *pub = EC_POINT_new(group);
-        if (!EC_POINT_mul(group, pub, priv, nullptr, nullptr, nullptr))
+        KeyPair pair{bytesToHex(priv, 32), bytesToHex(pub, 65)};
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return pair;
+    }
+
+    // 대량 프로비저닝용 바이트 키 쌍 (16진수 변환 없음)
+    struct RawKeyPair
+    {
+        unsigned char privateKey[32];
+        unsigned char publicKey[65]; // 비압축 (0x04 + x + y)
+    };
+
+    // count개의 키 쌍을 여러 스레드에서 생성 (threads = 0이면 코어 수)
+    // 생성점 곱셈은 백엔드의 고정 생성점 사전 계산 테이블을 사용한다.
+    // 결과에 개인키가 들어 있으므로 사용 후 CryptoBackend::cleanse로 지울 것
+    static std::vector<RawKeyPair> generateKeyPairs(size_t count, unsigned threads = 0)
+    {
+        std::vector<RawKeyPair> pairs(count);
+        MatterError error = tryGenerateKeyPairs(pairs.data(), count, threads);
+        if (error != MatterError::Ok)
         {
-            EC_POINT_free(pub);
-            BN_free(priv);
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to compute public key");
+            CryptoBackend::cleanse(pairs.data(), pairs.size() * sizeof(RawKeyPair));
+            throwMatterError(error);
         }
+        return pairs;
+    }
 
-        EC_KEY_set_public_key(key, pub);
-
-        unsigned char publicKey[65];
-        size_t len = EC_POINT_point2oct(group, pub, POINT_CONVERSION_UNCOMPRESSED,
-                                        publicKey, 65, nullptr);
+    static MatterError tryGenerateKeyPairs(RawKeyPair *out, size_t count, unsigned threads = 0)
+    {
+        static constexpr size_t CHUNK = 64; // 스레드 간 작업 분배 단위
 
-        EC_POINT_free(pub);
-        BN_free(priv);
-        EC_KEY_free(key);
+        std::atomic<bool> failed{false};
+        size_t chunks = (count + CHUNK - 1) / CHUNK;
+        parallelFor(chunks, workerCount(threads), [&](size_t chunk) {
+            size_t end = std::min(count, (chunk + 1) * CHUNK);
+            for (size_t i = chunk * CHUNK; i < end && !failed.load(std::memory_order_relaxed); i++)
+            {
+                if (!CryptoBackend::generateKeyPair(out[i].privateKey, out[i].publicKey))
+                {
+                    failed.store(true);
+                }
+            }
+        });
+        return failed.load() ? MatterError::KeyGenerationFailed : MatterError::Ok;
+    }
 
-        return bytesToHex(publicKey, len);
+    // 비압축 공개키(65바이트)를 압축 형식(33바이트: y 홀짝 prefix + x)으로
+    static void compressPublicKey(const unsigned char uncompressed[65], unsigned char compressed[33]) noexcept
+    {
+        compressed[0] = 0x02 | (uncompressed[64] & 1);
+        std::memcpy(compressed + 1, uncompressed + 1, 32);
     }
 
     // 서명 생성
     static std::string sign(const std::string &message, const std::string &privateKeyHex)
     {
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        BIGNUM *priv = BN_new();
-        std::vector<unsigned char> privateKeyBytes = hexToBytes(privateKeyHex);
-        BN_bin2bn(privateKeyBytes.data(), privateKeyBytes.size(), priv);
-        EC_KEY_set_private_key(key, priv);
-
-        // 메시지 해시 생성
-        unsigned char hash[32];
-        EVP_MD_CTX *mdctx = EVP_MD_CTX_new();
-        EVP_DigestInit_ex(mdctx, EVP_sha256(), nullptr);
-        EVP_DigestUpdate(mdctx, message.c_str(), message.length());
-        EVP_DigestFinal_ex(mdctx, hash, nullptr);
-        EVP_MD_CTX_free(mdctx);
+        return trySign(message, privateKeyHex).unwrap();
+    }
 
-        // 서명 생성
-        ECDSA_SIG *signature = ECDSA_do_sign(hash, sizeof(hash), key);
-        if (!signature)
+    static MatterResult<std::string> trySign(const std::string &message, const std::string &privateKeyHex)
+    {
+        unsigned char signature[64];
+        MatterError error = signBytes(message, privateKeyHex, signature);
+        if (error != MatterError::Ok)
         {
-            BN_free(priv);
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to create signature");
+            return error;
         }
+        return bytesToHex(signature, 64);
+    }
 
-        // R, S 값 추출
-        const BIGNUM *r, *s;
-        ECDSA_SIG_get0(signature, &r, &s);
-
-        // R, S 값을 32바이트 고정 길이로 변환
-        unsigned char rBytes[32] = {0};
-        unsigned char sBytes[32] = {0};
-        BN_bn2binpad(r, rBytes, 32);
-        BN_bn2binpad(s, sBytes, 32);
-
-        // R과 S를 연결하여 64바이트 시그니처 생성
-        std::string signatureHex;
-        signatureHex.reserve(128); // 64바이트 * 2
-        signatureHex += bytesToHex(rBytes, 32);
-        signatureHex += bytesToHex(sBytes, 32);
-
-        ECDSA_SIG_free(signature);
-        BN_free(priv);
-        EC_KEY_free(key);
-
-        return signatureHex;
+    // 서명 (바이트 입출력, 16진수 변환 없음): 32바이트 개인키로 서명해 signature에 r(32) + s(32) 기록
+    static MatterError trySignBytes(const unsigned char *message, size_t len, const unsigned char priv[32],
+                                    unsigned char signature[64]) noexcept
+    {
+        unsigned char hash[32];
+        CryptoBackend::sha256(message, len, hash);
+        return CryptoBackend::sign(priv, hash, signature) ? MatterError::Ok : MatterError::SigningFailed;
     }
 
     // 서명 검증
     static bool verify(const std::string &signatureHex, const std::string &message,
                        const std::string &publicKeyHex)
+    {
+        return tryVerify(signatureHex, message, publicKeyHex).unwrap();
+    }
+
+    // 서명 형식 오류는 오류 코드, 잘못된 공개키와 검증 실패는 false
+    static MatterResult<bool> tryVerify(const std::string &signatureHex, const std::string &message,
+                                        const std::string &publicKeyHex)
     {
         if (signatureHex.length() != 128)
         { // 64바이트 시그니처 (R: 32바이트, S: 32바이트)
-            throw std::runtime_error("Invalid signature length");
+            return MatterError::InvalidSignatureLength;
+        }
+        std::vector<unsigned char> signature;
+        if (decodeHex(signatureHex, signature) != MatterError::Ok)
+        {
+            return MatterError::InvalidHex;
         }
 
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        const EC_GROUP *group = EC_KEY_get0_group(key);
-        EC_POINT *pub = EC_POINT_new(group);
-
-        // 공개키 설정
-        std::vector<unsigned char> publicKeyBytes = hexToBytes(publicKeyHex);
-        EC_POINT_oct2point(group, pub, publicKeyBytes.data(),
-                           publicKeyBytes.size(), nullptr);
-        EC_KEY_set_public_key(key, pub);
+        // 공개키 설정 (잘못된 공개키는 검증 실패)
+        unsigned char pub[65];
+        MatterError error = publicKeyBytes(publicKeyHex, pub);
+        if (error == MatterError::InvalidHex)
+        {
+            return error;
+        }
+        if (error != MatterError::Ok)
+        {
+            return false;
+        }
 
         // 메시지 해시 생성
         unsigned char hash[32];
-        EVP_MD_CTX *mdctx = EVP_MD_CTX_new();
-        EVP_DigestInit_ex(mdctx, EVP_sha256(), nullptr);
-        EVP_DigestUpdate(mdctx, message.c_str(), message.length());
-        EVP_DigestFinal_ex(mdctx, hash, nullptr);
-        EVP_MD_CTX_free(mdctx);
-
-        // R, S 값 추출 및 ECDSA_SIG 구조체 생성
-        std::string rHex = signatureHex.substr(0, 64);
-        std::string sHex = signatureHex.substr(64, 64);
-        std::vector<unsigned char> rBytes = hexToBytes(rHex);
-        std::vector<unsigned char> sBytes = hexToBytes(sHex);
-
-        ECDSA_SIG *signature = ECDSA_SIG_new();
-        BIGNUM *r = BN_new();
-        BIGNUM *s = BN_new();
-        BN_bin2bn(rBytes.data(), rBytes.size(), r);
-        BN_bin2bn(sBytes.data(), sBytes.size(), s);
-        ECDSA_SIG_set0(signature, r, s); // r, s 소유권이 signature로 이전됨
-
-        // 검증
-        int result = ECDSA_do_verify(hash, sizeof(hash), signature, key);
+        sha256(message, hash);
 
-        ECDSA_SIG_free(signature); // 내부적으로 r, s도 해제됨
-        EC_POINT_free(pub);
-        EC_KEY_free(key);
-
-        return result == 1;
+        return CryptoBackend::verify(pub, hash, signature.data());
     }
 
-    // 공유키 생성
-    static std::string getSharedKey(const std::string &secretKeyHex, const std::string &publicKeyHex)
+    // 서명 검증 (바이트 입력): signature는 r(32) + s(32), 공개키는 압축(33) 또는 비압축(65)
+    // 잘못된 공개키와 검증 실패는 false
+    static bool verifyBytes(const unsigned char signature[64], const unsigned char *message, size_t len,
+                            const unsigned char *publicKey, size_t publicKeyLen) noexcept
     {
-        EC_KEY *privateKey = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        if (!privateKey)
-        {
-            throw std::runtime_error("Failed to create EC_KEY for private key");
-        }
-
-        // 개인키 설정
-        BIGNUM *priv = BN_new();
-        std::vector<unsigned char> secretKeyBytes = hexToBytes(secretKeyHex);
-        BN_bin2bn(secretKeyBytes.data(), secretKeyBytes.size(), priv);
-        if (!EC_KEY_set_private_key(privateKey, priv))
+        unsigned char pub[65];
+        if (!CryptoBackend::parsePublicKey(publicKey, publicKeyLen, pub))
         {
-            BN_free(priv);
-            EC_KEY_free(privateKey);
-            throw std::runtime_error("Failed to set private key");
+            return false;
         }
+        unsigned char hash[32];
+        CryptoBackend::sha256(message, len, hash);
+        return CryptoBackend::verify(pub, hash, signature);
+    }
 
-        // 공개키 포인트 생성
-        const EC_GROUP *group = EC_KEY_get0_group(privateKey);
-        EC_POINT *pub = EC_POINT_new(group);
-        std::vector<unsigned char> publicKeyBytes = hexToBytes(publicKeyHex);
+    // 공유키 생성
+    static std::string getSharedKey(const std::string &secretKeyHex, const std::string &publicKeyHex)
+    {
+        return tryGetSharedKey(secretKeyHex, publicKeyHex).unwrap();
+    }
 
-        if (!EC_POINT_oct2point(group, pub, publicKeyBytes.data(), publicKeyBytes.size(), nullptr))
+    static MatterResult<std::string> tryGetSharedKey(const std::string &secretKeyHex,
+                                                     const std::string &publicKeyHex)
+    {
+        unsigned char pub[65];
+        MatterError error = publicKeyBytes(publicKeyHex, pub);
+        if (error != MatterError::Ok)
         {
-            EC_POINT_free(pub);
-            BN_free(priv);
-            EC_KEY_free(privateKey);
-            throw std::runtime_error("Failed to create public key point");
+            return error;
         }
+        return sharedKeyFromBytes(secretKeyHex, pub);
+    }
 
-        // 공유 비밀 계산
-        unsigned char sharedSecret[32];
-        BIGNUM *sharedSecretBN = BN_new();
-        EC_POINT *sharedPoint = EC_POINT_new(group);
-
-        // 공유 포인트 계산: publicKey * privateKey
-        if (!EC_POINT_mul(group, sharedPoint, nullptr, pub, priv, nullptr))
-        {
-            BN_free(sharedSecretBN);
-            EC_POINT_free(sharedPoint);
-            EC_POINT_free(pub);
-            BN_free(priv);
-            EC_KEY_free(privateKey);
-            throw std::runtime_error("Failed to compute shared point");
-        }
+    // 암호화
+    static std::string encrypt(const std::string &key, const std::string &msg)
+    {
+        return tryEncrypt(key, msg).unwrap();
+    }
 
-        // x 좌표만 추출
-        if (!EC_POINT_get_affine_coordinates(group, sharedPoint, sharedSecretBN, nullptr, nullptr))
+    static MatterResult<std::string> tryEncrypt(const std::string &key, const std::string &msg)
+    {
+        MatterResult<std::vector<unsigned char>> result =
+            tryEncryptBytes(key, reinterpret_cast<const unsigned char *>(msg.c_str()), msg.length());
+        if (!result)
         {
-            BN_free(sharedSecretBN);
-            EC_POINT_free(sharedPoint);
-            EC_POINT_free(pub);
-            BN_free(priv);
-            EC_KEY_free(privateKey);
-            throw std::runtime_error("Failed to get shared secret");
+            return result.error();
         }
+        return bytesToHex(result.value().data(), result.value().size());
+    }
 
-        // BIGNUM을 바이트 배열로 변환
-        BN_bn2binpad(sharedSecretBN, sharedSecret, 32);
-
-        // 정리
-        BN_free(sharedSecretBN);
-        EC_POINT_free(sharedPoint);
-        EC_POINT_free(pub);
-        BN_free(priv);
-        EC_KEY_free(privateKey);
-
-        return bytesToHex(sharedSecret, 32);
+    // 암호화 (바이트 입출력): IV(16) + ciphertext
+    static std::vector<unsigned char> encryptBytes(const std::string &key, const unsigned char *msg, size_t len)
+    {
+        return tryEncryptBytes(key, msg, len).unwrap();
     }
 
-    // 암호화
-    static std::string encrypt(const std::string &key, const std::string &msg) {
-        // IV 생성 (16 bytes for AES)
-        unsigned char iv[16];
-        if (RAND_bytes(iv, sizeof(iv)) != 1) {
-            throw std::runtime_error("Failed to generate IV");
+    static MatterResult<std::vector<unsigned char>> tryEncryptBytes(const std::string &key,
+                                                                    const unsigned char *msg, size_t len) {
+        // 결과 버퍼: IV(16) + 암호문 (패딩을 고려하여 msg 길이보다 블록 크기만큼 더 크게)
+        std::vector<unsigned char> result(16 + len + 16);
+        unsigned char *iv = result.data();
+        unsigned char *ciphertext = result.data() + 16;
+        size_t ciphertext_len;
+        size_t final_len;
+
+        // IV 생성 (16 bytes for AES, 스레드별 IV 소스 사용)
+        if (IVSource::fill(iv, 16) != 1) {
+            return MatterError::RandomFailure;
         }
 
         // 키 해시 생성 (SHA-256)
         unsigned char keyHash[32];
-        EVP_MD_CTX *mdctx = EVP_MD_CTX_new();
-        EVP_DigestInit_ex(mdctx, EVP_sha256(), nullptr);
-        EVP_DigestUpdate(mdctx, key.c_str(), key.length());
-        EVP_DigestFinal_ex(mdctx, keyHash, nullptr);
-        EVP_MD_CTX_free(mdctx);
-
-        // 암호문을 저장할 버퍼 (패딩을 고려하여 msg 길이보다 블록 크기만큼 더 크게)
-        std::vector<unsigned char> ciphertext(msg.length() + EVP_MAX_BLOCK_LENGTH);
-        int ciphertext_len;
-        int final_len;
-
-        // CBC 컨텍스트 초기화
-        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-        if (!ctx) {
-            throw std::runtime_error("Failed to create cipher context");
-        }
-
-        // CBC 모드 초기화
-        if (!EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, keyHash, iv)) {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to initialize CBC mode");
+        hashKey(key, keyHash);
+
+        // CBC 모드 초기화, 암호화 수행, 패딩 처리
+        CryptoBackend::Cipher cipher;
+        bool ok = cipher.init(CryptoBackend::Cipher::CBC, true, keyHash, iv);
+        CryptoBackend::cleanse(keyHash, sizeof(keyHash));
+        if (!ok) {
+            return MatterError::CipherInitFailed;
         }
-
-        // 암호화 수행
-        if (!EVP_EncryptUpdate(ctx, ciphertext.data(), &ciphertext_len,
-                              reinterpret_cast<const unsigned char*>(msg.c_str()),
-                              msg.length())) {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to encrypt message");
+        if (!cipher.update(msg, len, ciphertext, ciphertext_len)) {
+            return MatterError::EncryptionFailed;
         }
-
-        // 암호화 종료 및 패딩 처리
-        if (!EVP_EncryptFinal_ex(ctx, ciphertext.data() + ciphertext_len, &final_len)) {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to finalize encryption");
+        if (!cipher.finish(ciphertext + ciphertext_len, final_len)) {
+            return MatterError::EncryptionFinalizeFailed;
         }
 
-        EVP_CIPHER_CTX_free(ctx);
-
-        // IV(16) + ciphertext를 하나의 문자열로 결합
-        std::string result;
-        result.reserve(16 + ciphertext_len + final_len);
-        result.append(reinterpret_cast<char*>(iv), 16);
-        result.append(reinterpret_cast<char*>(ciphertext.data()), ciphertext_len + final_len);
+        result.resize(16 + ciphertext_len + final_len);
+        return result;
+    }
 
-        return bytesToHex(reinterpret_cast<const unsigned char*>(result.c_str()), result.length());
+    // 32바이트 공유키 (AES 키는 16진수 문자열의 SHA-256이므로 내부에서 한 번만 16진수로 변환)
+    static MatterResult<std::vector<unsigned char>> tryEncryptBytes(const unsigned char sharedKey[32],
+                                                                    const unsigned char *msg, size_t len)
+    {
+        std::string key = bytesToHex(sharedKey, 32);
+        MatterResult<std::vector<unsigned char>> result = tryEncryptBytes(key, msg, len);
+        CryptoBackend::cleanse(&key[0], key.length());
+        return result;
     }
 
     // 복호화
-    static std::string decrypt(const std::string &key, const std::string &encryptedHex) {
+    static std::string decrypt(const std::string &key, const std::string &encryptedHex)
+    {
+        return tryDecrypt(key, encryptedHex).unwrap();
+    }
+
+    static MatterResult<std::string> tryDecrypt(const std::string &key, const std::string &encryptedHex) {
         // 16진수 문자열을 바이트로 변환
-        std::vector<unsigned char> encrypted = hexToBytes(encryptedHex);
-        if (encrypted.size() < 16) { // 최소 IV(16) 필요
-            throw std::runtime_error("Invalid encrypted data length");
+        std::vector<unsigned char> encrypted;
+        if (decodeHex(encryptedHex, encrypted) != MatterError::Ok) {
+            return MatterError::InvalidHex;
+        }
+        return tryDecryptBytes(key, encrypted.data(), encrypted.size());
+    }
+
+    // 복호화 (바이트 입력): IV(16) + AES-256-CBC 암호문
+    static std::string decryptBytes(const std::string &key, const unsigned char *encrypted, size_t len)
+    {
+        return tryDecryptBytes(key, encrypted, len).unwrap();
+    }
+
+    // 32바이트 공유키
+    static MatterResult<std::string> tryDecryptBytes(const unsigned char sharedKey[32],
+                                                     const unsigned char *encrypted, size_t len)
+    {
+        std::string key = bytesToHex(sharedKey, 32);
+        MatterResult<std::string> result = tryDecryptBytes(key, encrypted, len);
+        CryptoBackend::cleanse(&key[0], key.length());
+        return result;
+    }
+
+    static MatterResult<std::string> tryDecryptBytes(const std::string &key,
+                                                     const unsigned char *encrypted, size_t len) {
+        if (len < 16) { // 최소 IV(16) 필요
+            return MatterError::InvalidEncryptedLength;
         }
 
-        // 키 해시 생성
+        // 키 해시 생성 (SHA-256)
         unsigned char keyHash[32];
-        EVP_MD_CTX *mdctx = EVP_MD_CTX_new();
-        EVP_DigestInit_ex(mdctx, EVP_sha256(), nullptr);
-        EVP_DigestUpdate(mdctx, key.c_str(), key.length());
-        EVP_DigestFinal_ex(mdctx, keyHash, nullptr);
-        EVP_MD_CTX_free(mdctx);
+        hashKey(key, keyHash);
 
         // IV와 암호문 분리
-        unsigned char *iv = encrypted.data();
-        unsigned char *ciphertext = encrypted.data() + 16;
-        int ciphertext_len = encrypted.size() - 16;
+        const unsigned char *iv = encrypted;
+        const unsigned char *ciphertext = encrypted + 16;
+        size_t ciphertext_len = len - 16;
+
+        // 큰 암호문은 병렬 복호화
+        if (ciphertext_len >= parallelDecryptThreshold_.load()) {
+            std::string result;
+            MatterError error = decryptParallel(keyHash, iv, ciphertext, ciphertext_len, result);
+            CryptoBackend::cleanse(keyHash, sizeof(keyHash));
+            if (error != MatterError::Ok) {
+                return error;
+            }
+            return result;
+        }
 
         // 복호화할 평문 버퍼
-        std::vector<unsigned char> plaintext(ciphertext_len + EVP_MAX_BLOCK_LENGTH);
-        int plaintext_len;
-        int final_len;
-
-        // CBC 컨텍스트 초기화
-        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-        if (!ctx) {
-            throw std::runtime_error("Failed to create cipher context");
-        }
+        std::string plaintext(ciphertext_len + 16, '\0');
+        unsigned char *out = reinterpret_cast<unsigned char *>(&plaintext[0]);
+        size_t plaintext_len = 0;
+        size_t final_len = 0;
 
         // CBC 모드 초기화
-        if (!EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, keyHash, iv)) {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to initialize CBC mode");
+        CryptoBackend::Cipher cipher;
+        bool ok = cipher.init(CryptoBackend::Cipher::CBC, false, keyHash, iv);
+        CryptoBackend::cleanse(keyHash, sizeof(keyHash));
+        if (!ok) {
+            return MatterError::CipherInitFailed;
         }
 
-        // 복호화 수행
-        if (!EVP_DecryptUpdate(ctx, plaintext.data(), &plaintext_len,
-                              ciphertext, ciphertext_len)) {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to decrypt message");
+        // 복호화 수행, 종료 및 패딩 제거
+        if (!cipher.update(ciphertext, ciphertext_len, out, plaintext_len)) {
+            return MatterError::DecryptionUpdateFailed;
         }
-
-        // 복호화 종료 및 패딩 제거
-        if (!EVP_DecryptFinal_ex(ctx, plaintext.data() + plaintext_len, &final_len)) {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to finalize decryption");
+        if (!cipher.finish(out + plaintext_len, final_len)) {
+            return MatterError::DecryptionFailed;
         }
 
-        EVP_CIPHER_CTX_free(ctx);
-
-        return std::string(reinterpret_cast<char*>(plaintext.data()),
-                          plaintext_len + final_len);
+        plaintext.resize(plaintext_len + final_len);
+        return plaintext;
     }
-    // 디바이스 정보 추출
-    static std::string extractDeviceInfo(const std::vector<unsigned char> &data)
-    {
-        if (data.size() < 49)
-        { // 최소 크기: publicKey(33) + passcode(16)
-            throw std::runtime_error("Invalid data size");
-        }
 
-        // 1. Public Key 처리
-        std::vector<unsigned char> compressedKey(data.begin(), data.begin() + 33);
+    // 병렬 CBC 복호화 설정
+    // thresholdBytes 이상인 암호문은 블록 단위 청크로 나눠 여러 스레드에서 복호화 (threads = 0이면 코어 수)
+    static void setParallelDecrypt(size_t thresholdBytes, unsigned threads = 0)
+    {
+        parallelDecryptThreshold_.store(thresholdBytes);
+        parallelDecryptThreads_.store(threads);
+    }
 
-        // compressed public key를 uncompressed form으로 변환
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        const EC_GROUP *group = EC_KEY_get0_group(key);
-        EC_POINT *point = EC_POINT_new(group);
+    // 수신 TX 타임스탬프 허용 범위 (현재 시각 기준 초, 0이면 해당 방향 제한 없음)
+    // 기본값은 제한 없음: 기존 JS 송신측은 32비트 시각을 두 번 기록하므로 켜기 전에 송신측을 확인할 것
+    static void setTimestampWindow(uint64_t maxPastSeconds, uint64_t maxFutureSeconds)
+    {
+        timestampMaxPast_.store(maxPastSeconds);
+        timestampMaxFuture_.store(maxFutureSeconds);
+    }
 
-        if (!EC_POINT_oct2point(group, point, compressedKey.data(), compressedKey.size(), nullptr))
+    // precheckTX 통과/거부 카운터 (extractTXData, openTX 호출 누적)
+    struct PrecheckStats
+    {
+        uint64_t accepted;
+        uint64_t rejectedSize;
+        uint64_t rejectedFormat;    // format 바이트 또는 압축 공개키 prefix/x 좌표
+        uint64_t rejectedFuncName;
+        uint64_t rejectedSignature; // r, s가 0이거나 위수 이상
+        uint64_t rejectedPayload;   // 암호문/인덱스 길이
+        uint64_t rejectedTimestamp;
+
+        uint64_t rejected() const
         {
-            EC_POINT_free(point);
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to decompress public key");
+            return rejectedSize + rejectedFormat + rejectedFuncName + rejectedSignature +
+                   rejectedPayload + rejectedTimestamp;
         }
+    };
 
-        unsigned char uncompressedKey[65];
-        size_t uncompressedLen = EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED,
-                                                    uncompressedKey, 65, nullptr);
+    static PrecheckStats precheckStats() noexcept
+    {
+        PrecheckStats stats;
+        stats.accepted = precheckCounters_[PRECHECK_ACCEPTED].load(std::memory_order_relaxed);
+        stats.rejectedSize = precheckCounters_[PRECHECK_SIZE].load(std::memory_order_relaxed);
+        stats.rejectedFormat = precheckCounters_[PRECHECK_FORMAT].load(std::memory_order_relaxed);
+        stats.rejectedFuncName = precheckCounters_[PRECHECK_FUNC_NAME].load(std::memory_order_relaxed);
+        stats.rejectedSignature = precheckCounters_[PRECHECK_SIGNATURE].load(std::memory_order_relaxed);
+        stats.rejectedPayload = precheckCounters_[PRECHECK_PAYLOAD].load(std::memory_order_relaxed);
+        stats.rejectedTimestamp = precheckCounters_[PRECHECK_TIMESTAMP].load(std::memory_order_relaxed);
+        return stats;
+    }
 
-        // 2. Passcode 처리
-        std::vector<unsigned char> passcode(data.begin() + 33, data.begin() + 49);
+    static void resetPrecheckStats() noexcept
+    {
+        for (auto &counter : precheckCounters_)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
 
-        // 3. Functions 처리
-        std::vector<std::string> functions;
-        size_t pos = 49;
+    // 디바이스 정보 추출
+    static std::string extractDeviceInfo(const std::vector<unsigned char> &data)
+    {
+        return tryExtractDeviceInfo(data).unwrap();
+    }
 
-        while (pos + 20 <= data.size())
+    static MatterResult<std::string> tryExtractDeviceInfo(const std::vector<unsigned char> &data)
+    {
+        MatterResult<DeviceInfo> info = DeviceInfo::tryParse(data.data(), data.size());
+        if (!info)
         {
-            // Function name (18 bytes)
-            std::string funcName;
-            for (size_t i = 0; i < 18; i++)
-            {
-                if (data[pos + i] != 0)
-                {
-                    funcName += static_cast<char>(data[pos + i]);
-                }
-            }
-
-            // Function types (2 bytes)
-            uint16_t types = (data[pos + 18] << 8) | data[pos + 19];
+            return info.error();
+        }
+        return info.value().toJSON();
+    }
 
-            // Function signature 생성
-            std::string funcSig = funcName + "(" + getTypeString(types);
-            functions.push_back(funcSig);
+    // 디바이스 정보를 구조체로 (JSON 대신 타입 코드와 funcName 조회 테이블 포함)
+    static DeviceInfo parseDeviceInfo(const std::vector<unsigned char> &data)
+    {
+        return DeviceInfo::parse(data.data(), data.size());
+    }
 
-            pos += 20;
-        }
+    static MatterResult<DeviceInfo> tryParseDeviceInfo(const std::vector<unsigned char> &data)
+    {
+        return DeviceInfo::tryParse(data.data(), data.size());
+    }
 
-        // JSON 형식의 출력 생성
-        std::stringstream json;
-        json << "{\"publicKey\":\"" << bytesToHex(uncompressedKey, uncompressedLen)
-             << "\",\"passcode\":\"" << bytesToHex(passcode.data(), passcode.size())
-             << "\",\"functions\":[";
+    // 압축 공개키(33바이트)를 비압축 형식(65바이트)으로 변환
+    static size_t decompressPublicKey(const unsigned char *compressed, unsigned char uncompressed[65])
+    {
+        return tryDecompressPublicKey(compressed, uncompressed).unwrap();
+    }
 
-        for (size_t i = 0; i < functions.size(); i++)
+    static MatterResult<size_t> tryDecompressPublicKey(const unsigned char *compressed,
+                                                       unsigned char uncompressed[65])
+    {
+        if (!CryptoBackend::parsePublicKey(compressed, 33, uncompressed))
         {
-            if (i > 0)
-                json << ",";
-            json << "\"" << functions[i] << "\"";
+            return MatterError::InvalidPublicKey;
         }
-        json << "]}";
-
-        EC_POINT_free(point);
-        EC_KEY_free(key);
-
-        return json.str();
+        return size_t(65);
     }
 
     static std::vector<unsigned char> makeTX(const std::string &funcName,
                                              const std::string &src_priv,
                                              const std::string &dest_pub,
-                                             const std::vector<std::string> &data_list)
+                                             const std::vector<std::string> &data_list,
+                                             unsigned char format = TX_FORMAT_LEGACY)
     {
-        std::vector<unsigned char> result;
-
-        // 1. 공유키 생성
-        std::string sharedKey = getSharedKey(src_priv, dest_pub);
-
-        // 2. src_pub 파생
-        std::string src_pub = derivePublicKey(src_priv);
-
-        // 압축된 공개키로 변환 (uncompressed -> compressed)
-        std::vector<unsigned char> uncompressedPubBytes = hexToBytes(src_pub);
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        const EC_GROUP *group = EC_KEY_get0_group(key);
-        EC_POINT *point = EC_POINT_new(group);
-        EC_POINT_oct2point(group, point, uncompressedPubBytes.data(), uncompressedPubBytes.size(), nullptr);
-
-        unsigned char compressedKey[33];
-        EC_POINT_point2oct(group, point, POINT_CONVERSION_COMPRESSED, compressedKey, 33, nullptr);
-
-        // 3. 데이터 직렬화
-        std::vector<unsigned char> serializedData = serializeDataList(data_list);
-
-        // 4. 직렬화된 데이터 암호화
-        std::string encryptedData = encrypt(sharedKey,
-                                            std::string(serializedData.begin(), serializedData.end()));
-        std::vector<unsigned char> encryptedBytes = hexToBytes(encryptedData);
-
-        // 5. 현재 타임스탬프 얻기
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-                             now.time_since_epoch())
-                             .count();
-
-        // 6. TX 데이터 조합
-        // 6.1 Function name (18 bytes)
-        std::string paddedFuncName = funcName;
-        paddedFuncName.resize(18, '\0');
-        result.insert(result.end(), paddedFuncName.begin(), paddedFuncName.end());
-
-        // 6.2 Compressed public key (33 bytes)
-        result.insert(result.end(), compressedKey, compressedKey + 33);
+        return tryMakeTX(funcName, src_priv, dest_pub, data_list, format).unwrap();
+    }
 
-        // 6.3 Timestamp (8 bytes)
-        for (int i = 0; i < 8; i++)
+    static MatterResult<std::vector<unsigned char>> tryMakeTX(const std::string &funcName,
+                                                              const std::string &src_priv,
+                                                              const std::string &dest_pub,
+                                                              const std::vector<std::string> &data_list,
+                                                              unsigned char format = TX_FORMAT_LEGACY)
+    {
+        unsigned char pub[65];
+        MatterError error = publicKeyBytes(dest_pub, pub);
+        if (error != MatterError::Ok)
         {
-            result.push_back(static_cast<unsigned char>((timestamp >> (i * 8)) & 0xFF));
+            return error;
         }
+        unsigned char priv[32];
+        error = privateKeyBytes(src_priv, priv);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        MatterResult<std::vector<unsigned char>> tx = makeTXFromBytes(funcName, priv, pub, data_list, format);
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return tx;
+    }
 
-        // 6.4 Encrypted data
-        result.insert(result.end(), encryptedBytes.begin(), encryptedBytes.end());
-        
-        std::string resultHex = bytesToHex(result.data(), result.size());
+    // TX 생성 (바이트 키): 32바이트 개인키, 압축(33) 또는 비압축(65) 공개키
+    static MatterResult<std::vector<unsigned char>> tryMakeTX(const std::string &funcName,
+                                                              const unsigned char srcPriv[32],
+                                                              const unsigned char *destPub, size_t destPubLen,
+                                                              const std::vector<std::string> &data_list,
+                                                              unsigned char format = TX_FORMAT_LEGACY)
+    {
+        unsigned char pub[65];
+        if (!CryptoBackend::parsePublicKey(destPub, destPubLen, pub))
+        {
+            return MatterError::InvalidPublicKeyPoint;
+        }
+        return makeTXFromBytes(funcName, srcPriv, pub, data_list, format);
+    }
 
-        // 7. 서명 생성 및 추가
-        std::string signature = sign(resultHex, src_priv);
-        std::vector<unsigned char> signatureBytes = hexToBytes(signature);
+    // 등록된 디바이스로 보내는 TX (src_priv는 dest의 공유키를 계산한 게이트웨이 키)
+    static std::vector<unsigned char> makeTX(const std::string &funcName,
+                                             const std::string &src_priv,
+                                             const DeviceEntry &dest,
+                                             const std::vector<std::string> &data_list,
+                                             unsigned char format = TX_FORMAT_LEGACY)
+    {
+        return tryMakeTX(funcName, src_priv, dest, data_list, format).unwrap();
+    }
 
-        // 최종 결과: signature + TX data
-        std::vector<unsigned char> finalResult;
-        finalResult.insert(finalResult.end(), signatureBytes.begin(), signatureBytes.end());
-        finalResult.insert(finalResult.end(), result.begin(), result.end());
+    static MatterResult<std::vector<unsigned char>> tryMakeTX(const std::string &funcName,
+                                                              const std::string &src_priv,
+                                                              const DeviceEntry &dest,
+                                                              const std::vector<std::string> &data_list,
+                                                              unsigned char format = TX_FORMAT_LEGACY)
+    {
+        unsigned char hint[DEST_HINT_SIZE];
+        if (format & TX_FLAG_DEST_HINT)
+        {
+            destHint(dest.info.compressedKey, hint);
+        }
+        return tryBuildTX(funcName, src_priv, dest.sharedKey, data_list, format & ~TX_FLAG_DEST_HINT,
+                          format & TX_FLAG_DEST_HINT ? hint : nullptr);
+    }
 
-        // 정리
-        EC_POINT_free(point);
-        EC_KEY_free(key);
+    // 항목별 선택 복호화가 가능한 TX 생성 (TX_FORMAT_INDEXED)
+    static std::vector<unsigned char> makeIndexedTX(const std::string &funcName,
+                                                    const std::string &src_priv,
+                                                    const std::string &dest_pub,
+                                                    const std::vector<std::string> &data_list)
+    {
+        return tryMakeIndexedTX(funcName, src_priv, dest_pub, data_list).unwrap();
+    }
 
-        return finalResult;
+    static MatterResult<std::vector<unsigned char>> tryMakeIndexedTX(const std::string &funcName,
+                                                                     const std::string &src_priv,
+                                                                     const std::string &dest_pub,
+                                                                     const std::vector<std::string> &data_list)
+    {
+        return tryMakeTX(funcName, src_priv, dest_pub, data_list, TX_FORMAT_INDEXED);
     }
 
     static std::string extractTXData(const std::string &privateKey,
                                      const std::vector<unsigned char> &txBytes)
     {
-        if (txBytes.size() < 71)
-        { // 최소 크기: signature(64) + funcName(18) + compressed pubkey(33) + timestamp(8)
-            throw std::runtime_error("Invalid TX data size");
-        }
-
-        // 1. 서명과 데이터 분리
-        std::vector<unsigned char> signature(txBytes.begin(), txBytes.begin() + 64);
-        std::vector<unsigned char> txData(txBytes.begin() + 64, txBytes.end());
+        return tryExtractTXData(privateKey, txBytes.data(), txBytes.size()).unwrap();
+    }
 
-        // 2. 서명 검증
-        std::string signatureHex = bytesToHex(signature.data(), signature.size());
-        std::string txDataHex = bytesToHex(txData.data(), txData.size());
+    static std::string extractTXData(const std::string &privateKey,
+                                     const unsigned char *txBytes, size_t txLen)
+    {
+        return tryExtractTXData(privateKey, txBytes, txLen).unwrap();
+    }
 
-        // compressed public key 추출 (33바이트)
-        std::vector<unsigned char> compressedPubKey(txData.begin() + 18, txData.begin() + 51);
+    static MatterResult<std::string> tryExtractTXData(const std::string &privateKey,
+                                                      const std::vector<unsigned char> &txBytes)
+    {
+        return tryExtractTXData(privateKey, txBytes.data(), txBytes.size());
+    }
 
-        // compressed public key를 uncompressed form으로 변환
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        const EC_GROUP *group = EC_KEY_get0_group(key);
-        EC_POINT *point = EC_POINT_new(group);
+    // 서명된 TX의 사전 검사 (공개키 복원, 서명 검증 전에 바이트 비교만으로 거부)
+    // 길이, funcName, format/공개키 prefix, r/s 범위, 암호문 길이, 타임스탬프를 확인하고 카운터에 기록한다.
+    static MatterError precheckTX(const unsigned char *txBytes, size_t txLen) noexcept
+    {
+        MatterError error = screenTX(txBytes, txLen);
+        precheckCounters_[precheckCounter(error)].fetch_add(1, std::memory_order_relaxed);
+        return error;
+    }
 
-        if (!EC_POINT_oct2point(group, point, compressedPubKey.data(), compressedPubKey.size(), nullptr))
+    static MatterResult<std::string> tryExtractTXData(const std::string &privateKey,
+                                                      const unsigned char *txBytes, size_t txLen)
+    {
+        // 0. 사전 검사 (최소 크기 포함)
+        MatterError error = precheckTX(txBytes, txLen);
+        if (error != MatterError::Ok)
         {
-            EC_POINT_free(point);
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to decompress public key");
+            return error;
         }
+        return extractCheckedTX(privateKey, txBytes, txLen, nullptr);
+    }
 
-        unsigned char uncompressedKey[65];
-        size_t uncompressedLen = EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED,
-                                                    uncompressedKey, 65, nullptr);
-
-        std::string srcPub = bytesToHex(uncompressedKey, uncompressedLen);
-
-        if (!verify(signatureHex, txDataHex, srcPub))
+    // 32바이트 개인키
+    static MatterResult<std::string> tryExtractTXData(const unsigned char privateKey[32],
+                                                      const unsigned char *txBytes, size_t txLen)
+    {
+        MatterError error = precheckTX(txBytes, txLen);
+        if (error != MatterError::Ok)
         {
-            EC_POINT_free(point);
-            EC_KEY_free(key);
-            throw std::runtime_error("Invalid signature");
+            return error;
         }
+        return extractCheckedTX(privateKey, txBytes, txLen, nullptr);
+    }
 
-        // 3. 데이터 파싱
-        // 3.1 Function name (18바이트)
-        std::string funcName(txData.begin(), txData.begin() + 18);
-        // null 문자 제거
-        funcName = funcName.substr(0, funcName.find('\0'));
+    // 디바이스 함수 테이블(extractDeviceInfo의 시그니처)로 검증하며 추출
+    // funcName 조회와 TX_FORMAT_INDEXED의 항목 개수는 헤더 바이트만으로 확인하므로
+    // 알 수 없는 함수 호출은 공개키 복원, 서명 검증, ECDH, 복호화 전에 거부된다. 인자 타입은 복호화 후 확인한다.
+    static std::string extractTXData(const std::string &privateKey, const std::vector<unsigned char> &txBytes,
+                                     const DeviceInfo &device)
+    {
+        return tryExtractTXData(privateKey, txBytes.data(), txBytes.size(), device).unwrap();
+    }
 
-        // 3.2 Source public key는 이미 추출됨 (33바이트)
+    static MatterResult<std::string> tryExtractTXData(const std::string &privateKey,
+                                                      const std::vector<unsigned char> &txBytes,
+                                                      const DeviceInfo &device)
+    {
+        return tryExtractTXData(privateKey, txBytes.data(), txBytes.size(), device);
+    }
 
-        // 3.3 Timestamp (8바이트)
-        uint64_t timestamp = 0;
+    static MatterResult<std::string> tryExtractTXData(const std::string &privateKey,
+                                                      const unsigned char *txBytes, size_t txLen,
+                                                      const DeviceInfo &device)
+    {
+        const DeviceFunction *function = nullptr;
+        MatterError error = precheckTX(txBytes, txLen);
+        if (error == MatterError::Ok)
+        {
+            error = screenSchema(txBytes, device, function);
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        return extractCheckedTX(privateKey, txBytes, txLen, function);
+    }
+
+    // 등록된 디바이스가 보낸 TX 추출
+    // 헤더의 공개키가 source와 같아야 하며(아니면 PublicKeyMismatch), 캐시된 공개키와 공유키를 쓰므로
+    // 공개키 복원과 ECDH 없이 서명 검증과 복호화만 한다.
+    static std::string extractTXData(const DeviceEntry &source, const std::vector<unsigned char> &txBytes)
+    {
+        return tryExtractTXData(source, txBytes.data(), txBytes.size()).unwrap();
+    }
+
+    static MatterResult<std::string> tryExtractTXData(const DeviceEntry &source, const unsigned char *txBytes,
+                                                      size_t txLen)
+    {
+        MatterError error = precheckTX(txBytes, txLen);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        return extractCheckedTX(nullptr, txBytes, txLen, nullptr, &source);
+    }
+
+    static std::string extractTXDataWithoutSign(const std::string &privateKey, const std::string &txHex)
+    {
+        return tryExtractTXDataWithoutSign(privateKey, txHex).unwrap();
+    }
+
+    static MatterResult<std::string> tryExtractTXDataWithoutSign(const std::string &privateKey,
+                                                                 const std::string &txHex)
+    {
+        // 16진수 문자열을 바이트로 변환
+        std::vector<unsigned char> txData;
+        if (decodeHex(txHex, txData) != MatterError::Ok)
+        {
+            return MatterError::InvalidHex;
+        }
+
+        if (txData.size() < 59)
+        { // 최소 크기: funcName(18) + compressed pubkey(33) + timestamp(8)
+            return MatterError::InvalidTXSize;
+        }
+
+        // 1. 헤더 파싱
+        TXHeader header;
+        MatterError error = parseTXHeader(txData.data(), txData.size(), header);
+
+        // 2. 공유키 생성 및 복호화
+        std::vector<std::string> dataList;
+        if (error == MatterError::Ok)
+        {
+            MatterResult<std::string> sharedKey = sharedKeyFromBytes(privateKey, header.srcPubBytes);
+            error = sharedKey ? decryptTXPayload(sharedKey.value(), header, txData.data(), txData.size(), dataList)
+                              : sharedKey.error();
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+
+        // 3. JSON 형식으로 결과 생성
+        return txToJSON(header, dataList);
+    }
+
+    // 여러 서명을 병렬 검증 (pthreads WASM 빌드에서는 Web Worker 풀에서 실행)
+    // 형식 오류가 있는 항목은 false
+    static std::vector<bool> verifyBatch(const std::vector<std::string> &signatures,
+                                         const std::vector<std::string> &messages,
+                                         const std::vector<std::string> &publicKeys)
+    {
+        if (signatures.size() != messages.size() || signatures.size() != publicKeys.size())
+        {
+            throw std::runtime_error("Batch size mismatch");
+        }
+
+        std::vector<char> valid(signatures.size(), 0);
+        parallelFor(signatures.size(), workerCount(0), [&](size_t i) {
+            MatterResult<bool> result = tryVerify(signatures[i], messages[i], publicKeys[i]);
+            valid[i] = result.ok() && result.value();
+        });
+        return std::vector<bool>(valid.begin(), valid.end());
+    }
+
+    // 바이트 형식 서명 검증 항목 (verifyBytes와 같은 입력, 가리키는 메모리는 호출자 소유)
+    struct SignedMessageView
+    {
+        const unsigned char *signature; // r(32) + s(32)
+        const unsigned char *message;
+        size_t messageLen;
+        const unsigned char *publicKey; // 압축(33) 또는 비압축(65)
+        size_t publicKeyLen;
+    };
+
+    static std::vector<bool> verifyBatch(const std::vector<SignedMessageView> &items)
+    {
+        std::vector<char> valid(items.size(), 0);
+        parallelFor(items.size(), workerCount(0), [&](size_t i) {
+            const SignedMessageView &item = items[i];
+            valid[i] = verifyBytes(item.signature, item.message, item.messageLen, item.publicKey, item.publicKeyLen);
+        });
+        return std::vector<bool>(valid.begin(), valid.end());
+    }
+
+    // 여러 TX를 병렬 디코딩, 실패한 항목은 {"error":"..."}
+    static std::vector<std::string> extractTXDataBatch(const std::string &privateKey,
+                                                       const std::vector<std::vector<unsigned char>> &txs)
+    {
+        std::vector<std::pair<const unsigned char *, size_t>> views;
+        views.reserve(txs.size());
+        for (const auto &tx : txs)
+        {
+            views.emplace_back(tx.data(), tx.size());
+        }
+
+        std::vector<char> ok;
+        std::vector<std::string> results = extractTXDataBatch(privateKey, views, ok);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (!ok[i])
+            {
+                results[i] = "{\"error\":\"" + results[i] + "\"}";
+            }
+        }
+        return results;
+    }
+
+    // 포인터 + 길이 배치 (복사 없음)
+    // 성공한 항목은 ok[i] = 1 이고 결과는 JSON, 실패한 항목은 ok[i] = 0 이고 결과는 오류 메시지
+    static std::vector<std::string> extractTXDataBatch(const std::string &privateKey,
+                                                       const std::vector<std::pair<const unsigned char *, size_t>> &txs,
+                                                       std::vector<char> &ok)
+    {
+        std::vector<std::string> results(txs.size());
+        ok.assign(txs.size(), 0);
+        parallelFor(txs.size(), workerCount(0), [&](size_t i) {
+            MatterResult<std::string> result = tryExtractTXData(privateKey, txs[i].first, txs[i].second);
+            ok[i] = result.ok();
+            results[i] = result.ok() ? std::move(result).value() : std::string(result.message());
+        });
+        return results;
+    }
+
+    // 32바이트 개인키
+    static std::vector<std::string> extractTXDataBatch(const unsigned char privateKey[32],
+                                                       const std::vector<std::pair<const unsigned char *, size_t>> &txs,
+                                                       std::vector<char> &ok)
+    {
+        std::vector<std::string> results(txs.size());
+        ok.assign(txs.size(), 0);
+        parallelFor(txs.size(), workerCount(0), [&](size_t i) {
+            MatterResult<std::string> result = tryExtractTXData(privateKey, txs[i].first, txs[i].second);
+            ok[i] = result.ok();
+            results[i] = result.ok() ? std::move(result).value() : std::string(result.message());
+        });
+        return results;
+    }
+
+private:
+    static MatterResult<std::string> extractCheckedTX(const std::string &privateKey, const unsigned char *txBytes,
+                                                      size_t txLen, const DeviceFunction *function)
+    {
+        unsigned char priv[32];
+        MatterError error = privateKeyBytes(privateKey, priv);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        MatterResult<std::string> result = extractCheckedTX(priv, txBytes, txLen, function);
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return result;
+    }
+
+    // 사전 검사를 통과한 TX의 헤더 파싱, 서명 검증, 복호화 (function이 있으면 인자도 검사)
+    // source가 있으면 그 항목의 공개키와 공유키를 사용 (privateKey는 nullptr)
+    static MatterResult<std::string> extractCheckedTX(const unsigned char *privateKey, const unsigned char *txBytes,
+                                                      size_t txLen, const DeviceFunction *function,
+                                                      const DeviceEntry *source = nullptr)
+    {
+        // 1. 서명과 데이터 분리 및 헤더 파싱
+        const unsigned char *signature = txBytes;
+        const unsigned char *txData = txBytes + 64;
+        size_t txDataLen = txLen - 64;
+        TXHeader header;
+        MatterError error = parseTXHeader(txData, txDataLen, header, source);
+
+        // 2. 서명 검증
+        if (error == MatterError::Ok)
+        {
+            error = checkTXSignature(signature, txData, txDataLen, header.srcPubBytes);
+        }
+
+        // 3. 공유키 생성 및 복호화
+        std::vector<std::string> dataList;
+        if (error == MatterError::Ok && source != nullptr)
+        {
+            error = decryptTXPayload(source->sharedKey, header, txData, txDataLen, dataList);
+        }
+        else if (error == MatterError::Ok)
+        {
+            MatterResult<std::string> sharedKey = sharedKeyFromBytes(privateKey, header.srcPubBytes);
+            error = sharedKey ? decryptTXPayload(sharedKey.value(), header, txData, txDataLen, dataList)
+                              : sharedKey.error();
+        }
+
+        // 4. 인자 개수/타입
+        if (error == MatterError::Ok && function != nullptr)
+        {
+            error = function->checkArgs(dataList);
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+
+        // 5. JSON 형식으로 결과 생성
+        return txToJSON(header, dataList);
+    }
+
+    // 디바이스 함수 테이블 사전 검사 (precheckTX 통과 후, 헤더 바이트만 사용)
+    // funcName 조회, TX_FORMAT_INDEXED면 인덱스 테이블의 항목 개수까지 확인
+    static MatterError screenSchema(const unsigned char *txBytes, const DeviceInfo &device,
+                                    const DeviceFunction *&function)
+    {
+        const char *name = reinterpret_cast<const char *>(txBytes + 64);
+        function = device.function(std::string(name, strnlen(name, 18)));
+        if (function == nullptr)
+        {
+            return MatterError::UnknownFunction;
+        }
+        const unsigned char *txData = txBytes + 64;
+        if (txFormat(txData) == TX_FORMAT_INDEXED)
+        {
+            const unsigned char *payload = txData + txKeyOffset(txData) + 33 + 8;
+            size_t count = payload[16] | (payload[17] << 8);
+            if (count != function->argCount())
+            {
+                return MatterError::InvalidArguments;
+            }
+        }
+        return MatterError::Ok;
+    }
+
+    // 본문(서명 제외)의 압축 공개키 위치 (format 바이트 판별, 알 수 없는 format이면 0)
+    //   기존 형식 18, format 바이트 19, format 바이트 + 수신자 힌트 27
+    static size_t txKeyOffset(const unsigned char *txData) noexcept
+    {
+        switch (txData[18])
+        {
+        case 0x02:
+        case 0x03:
+            return 18;
+        case TX_FORMAT_INDEXED:
+            return 19;
+        case TX_FORMAT_LEGACY | TX_FLAG_DEST_HINT:
+        case TX_FORMAT_INDEXED | TX_FLAG_DEST_HINT:
+            return 19 + DEST_HINT_SIZE;
+        }
+        return 0;
+    }
+
+    // 힌트 플래그를 뺀 payload 형식 (txKeyOffset이 0이 아닐 때만 의미 있음)
+    static unsigned char txFormat(const unsigned char *txData) noexcept
+    {
+        return txData[18] == 0x02 || txData[18] == 0x03 ? TX_FORMAT_LEGACY
+                                                         : static_cast<unsigned char>(txData[18] & ~TX_FLAG_DEST_HINT);
+    }
+
+    // 본문의 수신자 힌트 (없으면 nullptr)
+    static const unsigned char *txDestHint(const unsigned char *txData) noexcept
+    {
+        return txKeyOffset(txData) == 19 + DEST_HINT_SIZE ? txData + 19 : nullptr;
+    }
+
+    static void destHint(const unsigned char compressedKey[33], unsigned char hint[DEST_HINT_SIZE])
+    {
+        unsigned char hash[32];
+        sha256(std::string("matter-dest") + std::string(reinterpret_cast<const char *>(compressedKey), 33), hash);
+        std::memcpy(hint, hash, DEST_HINT_SIZE);
+    }
+
+    // 서명을 제외한 TX 본문의 헤더 (funcName + [format [+ 수신자 힌트]] + compressed pubkey + timestamp)
+    struct TXHeader
+    {
+        std::string funcName;
+        std::string srcPub; // uncompressed 16진수
+        unsigned char srcPubBytes[65];
+        uint64_t timestamp;
+        unsigned char format;
+        size_t payloadOffset; // 본문 내 payload 시작 위치
+    };
+
+    static MatterError derivePublicKeyBytes(const std::string &privateKeyHex, unsigned char pub[65])
+    {
+        unsigned char priv[32];
+        MatterError error = privateKeyBytes(privateKeyHex, priv);
+        if (error == MatterError::Ok && !CryptoBackend::derivePublicKey(priv, pub))
+        {
+            error = MatterError::InvalidPrivateKey; // 0 또는 위수 이상
+        }
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return error;
+    }
+
+    static MatterError signBytes(const std::string &message, const std::string &privateKeyHex,
+                                 unsigned char signature[64])
+    {
+        unsigned char priv[32];
+        MatterError error = privateKeyBytes(privateKeyHex, priv);
+        if (error == MatterError::Ok)
+        {
+            // 메시지 해시 생성 후 서명: R(32) + S(32)
+            error = trySignBytes(reinterpret_cast<const unsigned char *>(message.data()), message.length(), priv,
+                                 signature);
+        }
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return error;
+    }
+
+    // 검증된 비압축 공개키로 공유키 계산 (공유 포인트의 x 좌표)
+    static MatterResult<std::string> sharedKeyFromBytes(const std::string &secretKeyHex,
+                                                        const unsigned char pub[65])
+    {
+        unsigned char priv[32];
+        MatterError error = privateKeyBytes(secretKeyHex, priv);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        MatterResult<std::string> result = sharedKeyFromBytes(priv, pub);
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return result;
+    }
+
+    static MatterResult<std::string> sharedKeyFromBytes(const unsigned char priv[32],
+                                                        const unsigned char pub[65])
+    {
+        unsigned char sharedSecret[32];
+        if (!CryptoBackend::ecdh(priv, pub, sharedSecret))
+        {
+            return MatterError::SharedSecretFailed;
+        }
+
+        std::string result = bytesToHex(sharedSecret, 32);
+        CryptoBackend::cleanse(sharedSecret, sizeof(sharedSecret));
+        return result;
+    }
+
+    // 검증된 비압축 공개키로 TX 생성 (tryMakeTX 공통)
+    static MatterResult<std::vector<unsigned char>> makeTXFromBytes(const std::string &funcName,
+                                                                    const unsigned char priv[32],
+                                                                    const unsigned char pub[65],
+                                                                    const std::vector<std::string> &data_list,
+                                                                    unsigned char format)
+    {
+        // 1. 공유키 생성
+        MatterResult<std::string> sharedKey = sharedKeyFromBytes(priv, pub);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+
+        // 2. 수신자 힌트 (요청한 경우)
+        unsigned char hint[DEST_HINT_SIZE];
+        if (format & TX_FLAG_DEST_HINT)
+        {
+            unsigned char compressed[33];
+            compressPublicKey(pub, compressed);
+            destHint(compressed, hint);
+        }
+
+        // 3. 공유키로 TX 생성
+        return tryBuildTX(funcName, priv, sharedKey.value(), data_list, format & ~TX_FLAG_DEST_HINT,
+                          format & TX_FLAG_DEST_HINT ? hint : nullptr);
+    }
+
+    // 이미 계산된 공유키로 서명된 TX 생성
+    static std::vector<unsigned char> buildTX(const std::string &funcName,
+                                              const std::string &src_priv,
+                                              const std::string &sharedKey,
+                                              const std::vector<std::string> &data_list,
+                                              unsigned char format = TX_FORMAT_LEGACY)
+    {
+        return tryBuildTX(funcName, src_priv, sharedKey, data_list, format).unwrap();
+    }
+
+    static MatterResult<std::vector<unsigned char>> tryBuildTX(const std::string &funcName,
+                                                               const std::string &src_priv,
+                                                               const std::string &sharedKey,
+                                                               const std::vector<std::string> &data_list,
+                                                               unsigned char format,
+                                                               const unsigned char *destHint = nullptr)
+    {
+        unsigned char priv[32];
+        MatterError error = privateKeyBytes(src_priv, priv);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        MatterResult<std::vector<unsigned char>> tx = tryBuildTX(funcName, priv, sharedKey, data_list, format, destHint);
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return tx;
+    }
+
+    static MatterResult<std::vector<unsigned char>> tryBuildTX(const std::string &funcName,
+                                                               const unsigned char src_priv[32],
+                                                               const std::string &sharedKey,
+                                                               const std::vector<std::string> &data_list,
+                                                               unsigned char format,
+                                                               const unsigned char *destHint = nullptr)
+    {
+        // 1. 데이터 직렬화 및 암호화
+        std::vector<unsigned char> serializedData;
+        if (format != TX_FORMAT_INDEXED)
+        {
+            serializedData = serializeDataList(data_list);
+        }
+        MatterResult<std::vector<unsigned char>> encrypted =
+            format == TX_FORMAT_INDEXED ? encryptIndexed(sharedKey, data_list)
+                                        : tryEncryptBytes(sharedKey, serializedData.data(), serializedData.size());
+        if (!encrypted)
+        {
+            return encrypted.error();
+        }
+
+        // 2. 헤더 조합 및 서명
+        return tryAssembleTX(funcName, src_priv, format, encrypted.value(), destHint);
+    }
+
+    // 암호화된 payload 앞에 헤더를 붙이고 서명 (destHint가 있으면 format 뒤에 수신자 힌트)
+    static MatterResult<std::vector<unsigned char>> tryAssembleTX(const std::string &funcName,
+                                                                  const std::string &src_priv,
+                                                                  unsigned char format,
+                                                                  const std::vector<unsigned char> &encryptedBytes,
+                                                                  const unsigned char *destHint = nullptr)
+    {
+        unsigned char priv[32];
+        MatterError error = privateKeyBytes(src_priv, priv);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        MatterResult<std::vector<unsigned char>> tx = tryAssembleTX(funcName, priv, format, encryptedBytes, destHint);
+        CryptoBackend::cleanse(priv, sizeof(priv));
+        return tx;
+    }
+
+    static MatterResult<std::vector<unsigned char>> tryAssembleTX(const std::string &funcName,
+                                                                  const unsigned char src_priv[32],
+                                                                  unsigned char format,
+                                                                  const std::vector<unsigned char> &encryptedBytes,
+                                                                  const unsigned char *destHint = nullptr)
+    {
+        // 1. src_pub 파생
+        unsigned char uncompressedPub[65];
+        if (!CryptoBackend::derivePublicKey(src_priv, uncompressedPub))
+        {
+            return MatterError::InvalidPrivateKey; // 0 또는 위수 이상
+        }
+
+        // 압축된 공개키로 변환
+        unsigned char compressedKey[33];
+        compressPublicKey(uncompressedPub, compressedKey);
+
+        // 2. 현재 타임스탬프 얻기
+        auto now = std::chrono::system_clock::now();
+        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                             now.time_since_epoch())
+                             .count();
+
+        // 3. TX 데이터 조합 (앞의 64바이트는 서명 자리)
+        std::vector<unsigned char> result(64);
+        result.reserve(64 + 18 + 1 + DEST_HINT_SIZE + 33 + 8 + encryptedBytes.size());
+
+        // 3.1 Function name (18 bytes)
+        std::string paddedFuncName = funcName;
+        paddedFuncName.resize(18, '\0');
+        result.insert(result.end(), paddedFuncName.begin(), paddedFuncName.end());
+
+        // 3.1.1 Format (1 byte, 기존 형식은 생략) + 수신자 힌트 (8 bytes)
+        if (destHint != nullptr)
+        {
+            result.push_back(format | TX_FLAG_DEST_HINT);
+            result.insert(result.end(), destHint, destHint + DEST_HINT_SIZE);
+        }
+        else if (format != TX_FORMAT_LEGACY)
+        {
+            result.push_back(format);
+        }
+
+        // 3.2 Compressed public key (33 bytes)
+        result.insert(result.end(), compressedKey, compressedKey + 33);
+
+        // 3.3 Timestamp (8 bytes)
         for (int i = 0; i < 8; i++)
         {
-            timestamp |= static_cast<uint64_t>(txData[51 + i]) << (i * 8);
+            result.push_back(static_cast<unsigned char>((timestamp >> (i * 8)) & 0xFF));
         }
 
-        // 3.4 암호화된 데이터
-        std::vector<unsigned char> encryptedData(txData.begin() + 59, txData.end());
-        std::string encryptedHex = bytesToHex(encryptedData.data(), encryptedData.size());
+        // 3.4 Encrypted data
+        result.insert(result.end(), encryptedBytes.begin(), encryptedBytes.end());
 
-        // 4. 공유키 생성 및 복호화
-        std::string sharedKey = getSharedKey(privateKey, srcPub);
-        std::string decryptedData = decrypt(sharedKey, encryptedHex);
+        std::string resultHex = bytesToHex(result.data() + 64, result.size() - 64);
 
-        // 5. 복호화된 데이터 역직렬화
-        std::vector<std::string> dataList = deserializeDataList(decryptedData);
+        // 4. 서명 생성 후 맨 앞에 기록: signature + TX data
+        MatterError error = trySignBytes(reinterpret_cast<const unsigned char *>(resultHex.data()),
+                                         resultHex.length(), src_priv, result.data());
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        return result;
+    }
 
-        // 6. JSON 형식으로 결과 생성
-        std::stringstream json;
-        json << "{\"funcName\":\"" << funcName << "\","
-             << "\"srcPub\":\"" << srcPub << "\","
-             << "\"timeStamp\":\"" << timestamp << "\","
-             << "\"data\":[";
+    // TX 본문 헤더 파싱 (len >= 59 보장은 호출자 책임)
+    static TXHeader parseTXHeader(const unsigned char *txData, size_t len)
+    {
+        TXHeader header;
+        MatterError error = parseTXHeader(txData, len, header);
+        if (error != MatterError::Ok)
+        {
+            throwMatterError(error);
+        }
+        return header;
+    }
 
-        for (size_t i = 0; i < dataList.size(); i++)
+    // source가 있으면 헤더의 압축 공개키가 같은지만 비교하고 복원된 공개키를 복사
+    static MatterError parseTXHeader(const unsigned char *txData, size_t len, TXHeader &header,
+                                     const DeviceEntry *source = nullptr)
+    {
+        // 1. Function name (18바이트), null 문자 제거
+        const char *name = reinterpret_cast<const char *>(txData);
+        header.funcName.assign(name, strnlen(name, 18));
+
+        // 2. Format 판별 (압축 공개키 prefix면 기존 형식)
+        size_t keyOffset = txKeyOffset(txData);
+        if (keyOffset == 0 || len < keyOffset + 33 + 8)
         {
-            if (i > 0)
-                json << ",";
-            json << "\"" << dataList[i] << "\"";
+            return MatterError::UnsupportedTXFormat;
+        }
+        header.format = txFormat(txData);
+        header.payloadOffset = keyOffset + 33 + 8;
+
+        // 3. compressed public key (33바이트)를 uncompressed form으로 변환
+        if (source != nullptr)
+        {
+            if (std::memcmp(txData + keyOffset, source->info.compressedKey, 33) != 0)
+            {
+                return MatterError::PublicKeyMismatch;
+            }
+            std::memcpy(header.srcPubBytes, source->info.publicKey, 65);
+            header.srcPub = source->publicKeyHex;
+        }
+        else
+        {
+            if (!CryptoBackend::parsePublicKey(txData + keyOffset, 33, header.srcPubBytes))
+            {
+                return MatterError::InvalidPublicKey;
+            }
+            header.srcPub = bytesToHex(header.srcPubBytes, 65);
+        }
+
+        // 4. Timestamp (8바이트)
+        header.timestamp = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            header.timestamp |= static_cast<uint64_t>(txData[keyOffset + 33 + i]) << (i * 8);
         }
-        json << "]}";
 
-        EC_POINT_free(point);
-        EC_KEY_free(key);
+        return MatterError::Ok;
+    }
 
-        return json.str();
+    // TX 서명 검증 (서명은 본문의 16진수 문자열에 대해 생성됨)
+    static void verifyTXSignature(const unsigned char *signature, const unsigned char *txData,
+                                  size_t len, const std::string &srcPub)
+    {
+        unsigned char pub[65];
+        MatterError error = publicKeyBytes(srcPub, pub);
+        if (error == MatterError::Ok)
+        {
+            error = checkTXSignature(signature, txData, len, pub);
+        }
+        if (error != MatterError::Ok)
+        {
+            throwMatterError(error);
+        }
     }
-    
-    static std::string extractTXDataWithoutSign(const std::string &privateKey, const std::string &txHex)
+
+    static MatterError checkTXSignature(const unsigned char *signature, const unsigned char *txData,
+                                        size_t len, const unsigned char srcPub[65])
     {
-        // 16진수 문자열을 바이트로 변환
-        std::vector<unsigned char> txData = hexToBytes(txHex);
-        
-        if (txData.size() < 59) { // 최소 크기: funcName(18) + compressed pubkey(33) + timestamp(8)
-            throw std::runtime_error("Invalid TX data size");
+        unsigned char hash[32];
+        sha256(bytesToHex(txData, len), hash);
+        return CryptoBackend::verify(srcPub, hash, signature) ? MatterError::Ok : MatterError::InvalidSignature;
+    }
+
+    // 복호화된 인자를 문자열로 복사하지 않고 가리키는 뷰 (TypedFunction 디코딩용)
+    // fields는 plain 또는 items를 가리키므로 이 구조체는 채운 뒤 옮기지 않는다.
+    struct TXFields
+    {
+        TXHeader header;
+        std::string sharedKey;          // 응답 키 파생용 (MatterRpc)
+        std::string plain;              // 기존 형식의 복호화된 직렬화 데이터
+        std::vector<std::string> items; // TX_FORMAT_INDEXED 항목
+        std::vector<std::string_view> fields;
+
+        ~TXFields()
+        {
+            CryptoBackend::cleanse(&sharedKey[0], sharedKey.size());
+        }
+    };
+
+    static constexpr size_t ANY_ARG_COUNT = SIZE_MAX;
+
+    // 18바이트 funcName이 일치하고 인자가 argCount개인 TX만 복호화 (funcName이 nullptr이면 이름 무관)
+    // funcName과 (TX_FORMAT_INDEXED의) 항목 개수는 사전 검사 직후, 공개키 복원과 ECDH 전에 확인한다.
+    static MatterError openTXFields(const std::string &privateKey, const unsigned char *txBytes, size_t txLen,
+                                    const char *funcName, size_t argCount, TXFields &out)
+    {
+        MatterError error = precheckTX(txBytes, txLen);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        const unsigned char *txData = txBytes + 64;
+        size_t txDataLen = txLen - 64;
+        if (funcName != nullptr && std::memcmp(txData, funcName, 18) != 0)
+        {
+            return MatterError::UnknownFunction;
+        }
+        if (argCount != ANY_ARG_COUNT && txFormat(txData) == TX_FORMAT_INDEXED)
+        {
+            const unsigned char *payload = txData + txKeyOffset(txData) + 33 + 8;
+            if (static_cast<size_t>(payload[16] | (payload[17] << 8)) != argCount)
+            {
+                return MatterError::InvalidArguments;
+            }
+        }
+
+        error = parseTXHeader(txData, txDataLen, out.header);
+        if (error == MatterError::Ok)
+        {
+            error = checkTXSignature(txBytes, txData, txDataLen, out.header.srcPubBytes);
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        MatterResult<std::string> sharedKey = sharedKeyFromBytes(privateKey, out.header.srcPubBytes);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
         }
+        out.sharedKey = std::move(sharedKey).value();
 
-        // 1. 데이터 파싱
-        // 1.1 Function name (18바이트)
-        std::string funcName(txData.begin(), txData.begin() + 18);
-        // null 문자 제거
-        funcName = funcName.substr(0, funcName.find('\0'));
+        if (out.header.format == TX_FORMAT_INDEXED)
+        {
+            error = decryptTXPayload(out.sharedKey, out.header, txData, txDataLen, out.items);
+            if (error != MatterError::Ok)
+            {
+                return error;
+            }
+            out.fields.assign(out.items.begin(), out.items.end());
+            return MatterError::Ok;
+        }
 
-        // 1.2 Compressed public key 추출 및 변환 (33바이트)
-        std::vector<unsigned char> compressedPubKey(txData.begin() + 18, txData.begin() + 51);
+        MatterResult<std::string> decrypted = tryDecryptBytes(out.sharedKey, txData + out.header.payloadOffset,
+                                                              txDataLen - out.header.payloadOffset);
+        if (!decrypted)
+        {
+            return decrypted.error();
+        }
+        out.plain = std::move(decrypted).value();
 
-        // compressed public key를 uncompressed form으로 변환
-        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
-        const EC_GROUP *group = EC_KEY_get0_group(key);
-        EC_POINT *point = EC_POINT_new(group);
+        // 길이(1바이트) + 데이터 (deserializeDataList와 같은 규칙, 잘린 항목은 무시)
+        if (argCount != ANY_ARG_COUNT)
+        {
+            out.fields.reserve(argCount);
+        }
+        for (size_t pos = 0; pos < out.plain.length();)
+        {
+            size_t length = static_cast<unsigned char>(out.plain[pos++]);
+            if (pos + length > out.plain.length())
+            {
+                break;
+            }
+            out.fields.emplace_back(out.plain.data() + pos, length);
+            pos += length;
+        }
+        return argCount == ANY_ARG_COUNT || out.fields.size() == argCount ? MatterError::Ok
+                                                                            : MatterError::InvalidArguments;
+    }
 
-        if (!EC_POINT_oct2point(group, point, compressedPubKey.data(), compressedPubKey.size(), nullptr)) {
-            EC_POINT_free(point);
-            EC_KEY_free(key);
-            throw std::runtime_error("Failed to decompress public key");
+    // 병렬 CBC 복호화
+    // 평문 블록 P[i] = D(C[i]) ^ C[i-1] 이므로 청크마다 직전 암호문 블록을 IV로 두고 독립적으로 복호화한다.
+    // 패딩은 청크 복호화 후 마지막 블록에서 직접 검증/제거한다.
+    static MatterError decryptParallel(const unsigned char keyHash[32], const unsigned char *iv,
+                                       const unsigned char *ciphertext, size_t len,
+                                       std::string &plaintext)
+    {
+        if (len == 0 || len % 16 != 0) {
+            return MatterError::DecryptionFailed;
         }
 
-        unsigned char uncompressedKey[65];
-        size_t uncompressedLen = EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED,
-                                                    uncompressedKey, 65, nullptr);
+        size_t blocks = len / 16;
+        size_t threads = std::min<size_t>(workerCount(parallelDecryptThreads_.load()), blocks);
+        size_t blocksPerChunk = (blocks + threads - 1) / threads;
+        // 올림 때문에 threads개보다 적은 청크로 끝날 수 있음 (예: 19블록, 8스레드 -> 3블록씩 7청크)
+        size_t chunks = (blocks + blocksPerChunk - 1) / blocksPerChunk;
+
+        plaintext.assign(len, '\0');
+        std::vector<char> chunkOk(chunks, 0);
+
+        auto decryptChunk = [&](size_t chunk) {
+            size_t first = chunk * blocksPerChunk;
+            if (first >= blocks) {
+                chunkOk[chunk] = 1;
+                return;
+            }
+            size_t count = std::min(blocksPerChunk, blocks - first);
+            const unsigned char *chunkIV = first == 0 ? iv : ciphertext + (first - 1) * 16;
+
+            CryptoBackend::Cipher cipher;
+            size_t outLen = 0;
+            chunkOk[chunk] = cipher.init(CryptoBackend::Cipher::CBC_NO_PADDING, false, keyHash, chunkIV) &&
+                             cipher.update(ciphertext + first * 16, count * 16,
+                                           reinterpret_cast<unsigned char *>(&plaintext[first * 16]), outLen);
+        };
 
-        std::string srcPub = bytesToHex(uncompressedKey, uncompressedLen);
+        parallelFor(chunks, threads, decryptChunk);
 
-        // 1.3 Timestamp (8바이트)
-        uint64_t timestamp = 0;
-        for (int i = 0; i < 8; i++) {
-            timestamp |= static_cast<uint64_t>(txData[51 + i]) << (i * 8);
+        for (char ok : chunkOk) {
+            if (!ok) {
+                return MatterError::DecryptionFailed;
+            }
         }
 
-        // 1.4 암호화된 데이터
-        std::vector<unsigned char> encryptedData(txData.begin() + 59, txData.end());
-        std::string encryptedHex = bytesToHex(encryptedData.data(), encryptedData.size());
+        // PKCS#7 패딩 검증 및 제거
+        unsigned char pad = static_cast<unsigned char>(plaintext[len - 1]);
+        bool padOk = pad >= 1 && pad <= 16;
+        for (size_t i = 0; padOk && i < pad; i++) {
+            padOk = static_cast<unsigned char>(plaintext[len - 1 - i]) == pad;
+        }
+        if (!padOk) {
+            return MatterError::DecryptionFailed;
+        }
+        plaintext.resize(len - pad);
 
-        // 2. 공유키 생성 및 복호화
-        std::string sharedKey = getSharedKey(privateKey, srcPub);
-        std::string decryptedData = decrypt(sharedKey, encryptedHex);
+        return MatterError::Ok;
+    }
+
+    // 사용할 스레드 수 (requested = 0이면 코어 수, 단일 스레드 WASM 빌드는 항상 1)
+    static size_t workerCount(unsigned requested) noexcept
+    {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        (void)requested;
+        return 1;
+#else
+        return requested != 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+#endif
+    }
+
+    // fn(0..count-1)을 threads개 스레드로 나눠 실행 (호출 스레드도 참여)
+    template <typename F>
+    static void parallelFor(size_t count, size_t threads, F &&fn)
+    {
+        threads = std::min(threads, count);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; i++) {
+                fn(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (size_t i = 1; i < threads; i++) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto &w : workers) {
+            w.join();
+        }
+    }
+
+    static inline std::atomic<size_t> parallelDecryptThreshold_{1 << 20};
+    static inline std::atomic<unsigned> parallelDecryptThreads_{0};
+
+    // P-256 위수 n과 소수 p (빅엔디안)
+    static constexpr unsigned char CURVE_ORDER[32] = {
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51};
+    static constexpr unsigned char CURVE_PRIME[32] = {
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+
+    // 32바이트 빅엔디안 정수가 0 < v < bound 인지
+    static bool inRange(const unsigned char *v, const unsigned char bound[32]) noexcept
+    {
+        unsigned char any = 0;
+        for (int i = 0; i < 32; i++)
+        {
+            any |= v[i];
+        }
+        return any != 0 && std::memcmp(v, bound, 32) < 0;
+    }
+
+    // precheckTX 본체: signature(64) + funcName(18) + [format [+ 수신자 힌트]] + compressed pubkey(33) + timestamp(8) + payload
+    static MatterError screenTX(const unsigned char *txBytes, size_t txLen) noexcept
+    {
+        if (txLen < 64 + 59)
+        {
+            return MatterError::InvalidTXSize;
+        }
+        const unsigned char *txData = txBytes + 64;
+        size_t txDataLen = txLen - 64;
+
+        // format 바이트와 압축 공개키 prefix, x < p
+        size_t keyOffset = txKeyOffset(txData);
+        if (keyOffset == 0)
+        {
+            return MatterError::UnsupportedTXFormat;
+        }
+        if (txDataLen < keyOffset + 41)
+        {
+            return MatterError::InvalidTXSize;
+        }
+        const unsigned char *key = txData + keyOffset;
+        if ((key[0] != 0x02 && key[0] != 0x03) || std::memcmp(key + 1, CURVE_PRIME, 32) >= 0)
+        {
+            return MatterError::InvalidPublicKey;
+        }
+
+        // funcName: 출력 가능한 ASCII (JSON에 그대로 들어가므로 '"', '\\' 제외) 뒤 0 패딩
+        size_t nameLen = 0;
+        while (nameLen < 18 && txData[nameLen] != 0)
+        {
+            unsigned char c = txData[nameLen++];
+            if (c < 0x20 || c > 0x7e || c == '"' || c == '\\')
+            {
+                return MatterError::InvalidFuncName;
+            }
+        }
+        for (size_t i = nameLen; i < 18; i++)
+        {
+            if (txData[i] != 0)
+            {
+                return MatterError::InvalidFuncName;
+            }
+        }
+        if (nameLen == 0)
+        {
+            return MatterError::InvalidFuncName;
+        }
+
+        // 서명 r, s는 [1, n-1]
+        if (!inRange(txBytes, CURVE_ORDER) || !inRange(txBytes + 32, CURVE_ORDER))
+        {
+            return MatterError::InvalidSignature;
+        }
+
+        // payload 길이
+        const unsigned char *payload = key + 41;
+        size_t payloadLen = txDataLen - (keyOffset + 41);
+        if (txFormat(txData) == TX_FORMAT_LEGACY)
+        {
+            // IV(16) + CBC 암호문 (패딩 때문에 최소 1블록)
+            if (payloadLen < 32 || payloadLen % 16 != 0)
+            {
+                return MatterError::InvalidEncryptedLength;
+            }
+        }
+        else
+        {
+            // IV(16) + count(2) + length(4) * count + 항목 길이 합만큼의 암호문
+            if (payloadLen < 18)
+            {
+                return MatterError::InvalidIndexedPayload;
+            }
+            size_t count = payload[16] | (payload[17] << 8);
+            size_t indexEnd = 18 + count * 4;
+            if (indexEnd > payloadLen)
+            {
+                return MatterError::InvalidIndexedPayload;
+            }
+            uint64_t total = 0;
+            for (const unsigned char *p = payload + 18; p < payload + indexEnd; p += 4)
+            {
+                total += static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            }
+            if (total != payloadLen - indexEnd)
+            {
+                return MatterError::InvalidIndexedPayload;
+            }
+        }
+
+        // 타임스탬프 허용 범위
+        uint64_t maxPast = timestampMaxPast_.load(std::memory_order_relaxed);
+        uint64_t maxFuture = timestampMaxFuture_.load(std::memory_order_relaxed);
+        if (maxPast != 0 || maxFuture != 0)
+        {
+            uint64_t timestamp = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                timestamp |= static_cast<uint64_t>(key[33 + i]) << (i * 8);
+            }
+            uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+                                                     std::chrono::system_clock::now().time_since_epoch())
+                                                     .count());
+            if ((maxPast != 0 && timestamp < now && now - timestamp > maxPast) ||
+                (maxFuture != 0 && timestamp > now && timestamp - now > maxFuture))
+            {
+                return MatterError::InvalidTimestamp;
+            }
+        }
+
+        return MatterError::Ok;
+    }
+
+    enum PrecheckCounter
+    {
+        PRECHECK_ACCEPTED,
+        PRECHECK_SIZE,
+        PRECHECK_FORMAT,
+        PRECHECK_FUNC_NAME,
+        PRECHECK_SIGNATURE,
+        PRECHECK_PAYLOAD,
+        PRECHECK_TIMESTAMP,
+        PRECHECK_COUNTERS,
+    };
+
+    static PrecheckCounter precheckCounter(MatterError error) noexcept
+    {
+        switch (error)
+        {
+        case MatterError::Ok:
+            return PRECHECK_ACCEPTED;
+        case MatterError::InvalidTXSize:
+            return PRECHECK_SIZE;
+        case MatterError::UnsupportedTXFormat:
+        case MatterError::InvalidPublicKey:
+            return PRECHECK_FORMAT;
+        case MatterError::InvalidFuncName:
+            return PRECHECK_FUNC_NAME;
+        case MatterError::InvalidSignature:
+            return PRECHECK_SIGNATURE;
+        case MatterError::InvalidTimestamp:
+            return PRECHECK_TIMESTAMP;
+        default:
+            return PRECHECK_PAYLOAD;
+        }
+    }
+
+    static inline std::atomic<uint64_t> precheckCounters_[PRECHECK_COUNTERS] = {};
+    static inline std::atomic<uint64_t> timestampMaxPast_{0};
+    static inline std::atomic<uint64_t> timestampMaxFuture_{0};
+
+    // 암호화된 payload 복호화 후 역직렬화
+    static std::vector<std::string> decryptTXPayload(const std::string &sharedKey, const TXHeader &header,
+                                                     const unsigned char *txData, size_t len)
+    {
+        std::vector<std::string> dataList;
+        MatterError error = decryptTXPayload(sharedKey, header, txData, len, dataList);
+        if (error != MatterError::Ok)
+        {
+            throwMatterError(error);
+        }
+        return dataList;
+    }
+
+    static MatterError decryptTXPayload(const std::string &sharedKey, const TXHeader &header,
+                                        const unsigned char *txData, size_t len,
+                                        std::vector<std::string> &dataList)
+    {
+        const unsigned char *encrypted = txData + header.payloadOffset;
+        size_t encryptedLen = len - header.payloadOffset;
+
+        if (header.format == TX_FORMAT_INDEXED)
+        {
+            IndexedPayload payload;
+            MatterError error = parseIndexed(encrypted, encryptedLen, payload);
+            if (error != MatterError::Ok)
+            {
+                return error;
+            }
+            unsigned char keyHash[32];
+            hashKey(sharedKey, keyHash);
+
+            dataList.assign(payload.lengths.size(), std::string());
+            for (size_t i = 0; i < payload.lengths.size() && error == MatterError::Ok; i++)
+            {
+                error = decryptIndexedItem(keyHash, encrypted, payload, i, dataList[i]);
+            }
+            CryptoBackend::cleanse(keyHash, sizeof(keyHash));
+            return error;
+        }
+
+        MatterResult<std::string> decryptedData = tryDecryptBytes(sharedKey, encrypted, encryptedLen);
+        if (!decryptedData)
+        {
+            return decryptedData.error();
+        }
+        dataList = deserializeDataList(decryptedData.value());
+        return MatterError::Ok;
+    }
+
+    // TX_FORMAT_INDEXED payload: IV(16) + count(2) + length(4) * count + AES-256-CTR(항목들 연결)
+    // 인덱스는 평문이지만 TX 서명 범위에 포함되어 인증된다.
+    struct IndexedPayload
+    {
+        size_t cipherOffset; // payload 내 암호문 시작 위치 (IV는 payload 맨 앞)
+        std::vector<uint32_t> lengths;
+        std::vector<size_t> offsets; // 각 항목의 암호문 내 시작 위치
+    };
 
-        // 3. 복호화된 데이터 역직렬화
-        std::vector<std::string> dataList = deserializeDataList(decryptedData);
+    static MatterResult<std::vector<unsigned char>> encryptIndexed(const std::string &sharedKey,
+                                                                   const std::vector<std::string> &data_list)
+    {
+        if (data_list.size() > 0xFFFF)
+        {
+            return MatterError::TooManyItems;
+        }
+
+        std::vector<unsigned char> result(16);
+        if (IVSource::fill(result.data(), 16) != 1)
+        {
+            return MatterError::RandomFailure;
+        }
+
+        // 인덱스
+        result.push_back(static_cast<unsigned char>(data_list.size() & 0xFF));
+        result.push_back(static_cast<unsigned char>((data_list.size() >> 8) & 0xFF));
+        size_t total = 0;
+        for (const auto &data : data_list)
+        {
+            if (data.length() > 0xFFFFFFFFULL)
+            {
+                return MatterError::DataItemTooLarge;
+            }
+            for (int i = 0; i < 4; i++)
+            {
+                result.push_back(static_cast<unsigned char>((data.length() >> (i * 8)) & 0xFF));
+            }
+            total += data.length();
+        }
+
+        // 항목들을 하나의 CTR 스트림으로 암호화
+        unsigned char keyHash[32];
+        hashKey(sharedKey, keyHash);
+
+        CryptoBackend::Cipher cipher;
+        bool ok = cipher.init(CryptoBackend::Cipher::CTR, true, keyHash, result.data());
+        CryptoBackend::cleanse(keyHash, sizeof(keyHash));
+
+        size_t pos = result.size();
+        result.resize(pos + total);
+        for (size_t i = 0; ok && i < data_list.size(); i++)
+        {
+            size_t outLen = 0;
+            ok = cipher.update(reinterpret_cast<const unsigned char *>(data_list[i].data()), data_list[i].length(),
+                               result.data() + pos, outLen);
+            pos += outLen;
+        }
+        if (!ok)
+        {
+            return MatterError::EncryptionFailed;
+        }
+
+        return result;
+    }
+
+    static MatterError parseIndexed(const unsigned char *data, size_t len, IndexedPayload &payload)
+    {
+        if (len < 18)
+        {
+            return MatterError::InvalidIndexedPayload;
+        }
+
+        size_t count = data[16] | (data[17] << 8);
+        size_t indexEnd = 18 + count * 4;
+        if (indexEnd > len)
+        {
+            return MatterError::InvalidIndexedPayload;
+        }
 
-        // 4. JSON 형식으로 결과 생성
-        std::stringstream json;
-        json << "{\"funcName\":\"" << funcName << "\","
-             << "\"srcPub\":\"" << srcPub << "\","
-             << "\"timeStamp\":\"" << timestamp << "\","
-             << "\"data\":[";
+        // 32비트 size_t(wasm32)에서도 합이 넘치지 않도록 64비트로 누적
+        uint64_t offset = 0;
+        uint64_t cipherLen = len - indexEnd;
+        payload.lengths.clear();
+        payload.offsets.clear();
+        payload.lengths.reserve(count);
+        payload.offsets.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const unsigned char *p = data + 18 + i * 4;
+            uint32_t itemLen = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+            payload.lengths.push_back(itemLen);
+            payload.offsets.push_back(static_cast<size_t>(offset));
+            offset += itemLen;
+            if (offset > cipherLen)
+            {
+                return MatterError::InvalidIndexedPayload;
+            }
+        }
+
+        if (offset != cipherLen)
+        {
+            return MatterError::InvalidIndexedPayload;
+        }
+        payload.cipherOffset = indexEnd;
+        return MatterError::Ok;
+    }
 
-        for (size_t i = 0; i < dataList.size(); i++) {
+    // 항목 k만 복호화: 카운터 블록을 offset/16 만큼 진행한 뒤 offset%16 바이트를 건너뜀
+    static MatterError decryptIndexedItem(const unsigned char keyHash[32], const unsigned char *data,
+                                          const IndexedPayload &payload, size_t k, std::string &result)
+    {
+        size_t offset = payload.offsets[k];
+        size_t itemLen = payload.lengths[k];
+
+        unsigned char counter[16];
+        std::memcpy(counter, data, 16);
+        uint64_t carry = offset / 16;
+        for (int i = 15; i >= 0 && carry > 0; i--)
+        {
+            carry += counter[i];
+            counter[i] = static_cast<unsigned char>(carry & 0xFF);
+            carry >>= 8;
+        }
+
+        CryptoBackend::Cipher cipher;
+        unsigned char skip[16] = {0};
+        result.assign(itemLen, '\0');
+        size_t outLen = 0;
+        bool ok = cipher.init(CryptoBackend::Cipher::CTR, false, keyHash, counter) &&
+                  cipher.update(skip, offset % 16, skip, outLen) &&
+                  cipher.update(data + payload.cipherOffset + offset, itemLen,
+                                reinterpret_cast<unsigned char *>(&result[0]), outLen);
+        return ok ? MatterError::Ok : MatterError::DecryptionUpdateFailed;
+    }
+
+    // 디코딩된 TX를 JSON 문자열로 변환
+    // (stringstream 대신 크기를 미리 계산해 한 번에 할당)
+    static std::string txToJSON(const TXHeader &header, const std::vector<std::string> &dataList)
+    {
+        std::string timestamp = std::to_string(header.timestamp);
+
+        size_t total = 64 + header.funcName.length() + header.srcPub.length() + timestamp.length();
+        for (const auto &data : dataList)
+        {
+            total += data.length() + 3;
+        }
+
+        std::string json;
+        json.reserve(total);
+        json.append("{\"funcName\":\"").append(header.funcName);
+        json.append("\",\"srcPub\":\"").append(header.srcPub);
+        json.append("\",\"timeStamp\":\"").append(timestamp);
+        json.append("\",\"data\":[");
+
+        for (size_t i = 0; i < dataList.size(); i++)
+        {
             if (i > 0)
-                json << ",";
-            json << "\"" << dataList[i] << "\"";
+                json += ',';
+            json.append(1, '"').append(dataList[i]).append(1, '"');
+        }
+        json.append("]}");
+
+        return json;
+    }
+
+public:
+    // 디코딩된 TX 레코드
+    // TX_FORMAT_INDEXED는 item(k) 호출 시 해당 항목만 복호화하고, 기존 형식은 열 때 전체를 복호화한다.
+    class TXRecord
+    {
+    public:
+        const std::string &funcName() const { return header_.funcName; }
+        const std::string &srcPub() const { return header_.srcPub; }
+        const unsigned char *srcPubBytes() const { return header_.srcPubBytes; } // uncompressed 65바이트
+        uint64_t timestamp() const { return header_.timestamp; }
+
+        size_t size() const
+        {
+            return header_.format == TX_FORMAT_INDEXED ? index_.lengths.size() : dataList_.size();
+        }
+
+        std::string item(size_t k) const
+        {
+            if (k >= size())
+            {
+                throw std::out_of_range("Invalid data item index");
+            }
+            return tryItem(k).unwrap();
+        }
+
+        MatterResult<std::string> tryItem(size_t k) const
+        {
+            if (k >= size())
+            {
+                return MatterError::InvalidIndexedPayload;
+            }
+            if (header_.format == TX_FORMAT_INDEXED)
+            {
+                std::string result;
+                MatterError error = decryptIndexedItem(keyHash_, payload_.data(), index_, k, result);
+                if (error == MatterError::Ok && k < 7 && !valueMatchesType(itemTypes_[k], result))
+                {
+                    error = MatterError::InvalidArguments;
+                }
+                if (error != MatterError::Ok)
+                {
+                    return error;
+                }
+                return result;
+            }
+            return dataList_[k];
+        }
+
+        std::vector<std::string> items() const
+        {
+            std::vector<std::string> result;
+            result.reserve(size());
+            for (size_t i = 0; i < size(); i++)
+            {
+                result.push_back(item(i));
+            }
+            return result;
+        }
+
+        ~TXRecord()
+        {
+            CryptoBackend::cleanse(keyHash_, sizeof(keyHash_));
+        }
+
+    private:
+        friend class MatterTunnel;
+
+        TXHeader header_;
+        unsigned char keyHash_[32] = {0};
+        std::vector<unsigned char> payload_; // TX_FORMAT_INDEXED payload 사본
+        IndexedPayload index_;
+        std::vector<std::string> dataList_; // 기존 형식의 복호화된 항목
+        // TX_FORMAT_INDEXED 항목 타입 (디바이스 함수 테이블로 연 경우, 아니면 모두 String = 검사 안 함)
+        ValueType itemTypes_[7] = {ValueType::String, ValueType::String, ValueType::String, ValueType::String,
+                                   ValueType::String, ValueType::String, ValueType::String};
+    };
+
+    // 서명 검증 및 공유키 계산까지만 수행하고 레코드 반환 (항목 복호화는 지연)
+    static TXRecord openTX(const std::string &privateKey, const std::vector<unsigned char> &txBytes)
+    {
+        return tryOpenTX(privateKey, txBytes).unwrap();
+    }
+
+    static MatterResult<TXRecord> tryOpenTX(const std::string &privateKey,
+                                            const std::vector<unsigned char> &txBytes)
+    {
+        MatterError error = precheckTX(txBytes.data(), txBytes.size());
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        return openCheckedTX(privateKey, txBytes, nullptr);
+    }
+
+    // 디바이스 함수 테이블로 검증하며 열기 (extractTXData와 같은 순서로 검사)
+    // TX_FORMAT_INDEXED 항목의 타입은 item(k)로 복호화할 때 확인한다.
+    static TXRecord openTX(const std::string &privateKey, const std::vector<unsigned char> &txBytes,
+                           const DeviceInfo &device)
+    {
+        return tryOpenTX(privateKey, txBytes, device).unwrap();
+    }
+
+    static MatterResult<TXRecord> tryOpenTX(const std::string &privateKey, const std::vector<unsigned char> &txBytes,
+                                            const DeviceInfo &device)
+    {
+        const DeviceFunction *function = nullptr;
+        MatterError error = precheckTX(txBytes.data(), txBytes.size());
+        if (error == MatterError::Ok)
+        {
+            error = screenSchema(txBytes.data(), device, function);
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
         }
-        json << "]}";
+        return openCheckedTX(privateKey, txBytes, function);
+    }
 
-        EC_POINT_free(point);
-        EC_KEY_free(key);
+private:
+    static MatterResult<TXRecord> openCheckedTX(const std::string &privateKey, const std::vector<unsigned char> &txBytes,
+                                                const DeviceFunction *function)
+    {
+        const unsigned char *txData = txBytes.data() + 64;
+        size_t txDataLen = txBytes.size() - 64;
 
-        return json.str();
+        TXRecord record;
+        MatterError error = parseTXHeader(txData, txDataLen, record.header_);
+        if (error == MatterError::Ok)
+        {
+            error = checkTXSignature(txBytes.data(), txData, txDataLen, record.header_.srcPubBytes);
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+
+        MatterResult<std::string> sharedKey = sharedKeyFromBytes(privateKey, record.header_.srcPubBytes);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+        if (record.header_.format == TX_FORMAT_INDEXED)
+        {
+            record.payload_.assign(txData + record.header_.payloadOffset, txData + txDataLen);
+            error = parseIndexed(record.payload_.data(), record.payload_.size(), record.index_);
+            hashKey(sharedKey.value(), record.keyHash_);
+        }
+        else
+        {
+            error = decryptTXPayload(sharedKey.value(), record.header_, txData, txDataLen, record.dataList_);
+            if (error == MatterError::Ok && function != nullptr)
+            {
+                error = function->checkArgs(record.dataList_);
+            }
+        }
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+        if (function != nullptr)
+        {
+            std::copy(function->argTypes, function->argTypes + 7, record.itemTypes_);
+        }
+        return record;
     }
 };
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include <openssl/bn.h>
+#include <cstddef>
+
+// OpenSSL 백엔드 (기본)
+// 키/서명은 고정 길이 바이트: 개인키 32, 공개키 65(비압축), 서명 r(32) + s(32)
+class OpenSSLCrypto
+{
+public:
+    static bool randomBytes(unsigned char *out, size_t len)
+    {
+        return RAND_bytes(out, static_cast<int>(len)) == 1;
+    }
+
+    static void cleanse(void *ptr, size_t len)
+    {
+        OPENSSL_cleanse(ptr, len);
+    }
+
+    static void sha256(const unsigned char *data, size_t len, unsigned char out[32])
+    {
+        EVP_MD_CTX *mdctx = EVP_MD_CTX_new();
+        EVP_DigestInit_ex(mdctx, EVP_sha256(), nullptr);
+        EVP_DigestUpdate(mdctx, data, len);
+        EVP_DigestFinal_ex(mdctx, out, nullptr);
+        EVP_MD_CTX_free(mdctx);
+    }
+
+    // 개인키만 생성 (공개키 계산 없음): [1, n-1] 범위의 난수
+    static bool generatePrivateKey(unsigned char priv[32])
+    {
+        const EC_GROUP *group = baseGroup();
+        BIGNUM *d = BN_new();
+        bool ok = group && d && BN_priv_rand_range(d, EC_GROUP_get0_order(group)) && !BN_is_zero(d) &&
+                  BN_bn2binpad(d, priv, 32) == 32;
+        BN_clear_free(d);
+        return ok;
+    }
+
+    // 개인키와 공개키를 한 번에 생성 (생성점 곱셈 1회)
+    static bool generateKeyPair(unsigned char priv[32], unsigned char pub[65])
+    {
+        return generatePrivateKey(priv) && derivePublicKey(priv, pub);
+    }
+
+    static bool derivePublicKey(const unsigned char priv[32], unsigned char pub[65])
+    {
+        const EC_GROUP *group = baseGroup();
+        BIGNUM *d = BN_bin2bn(priv, 32, nullptr);
+        EC_POINT *point = group ? EC_POINT_new(group) : nullptr;
+
+        bool ok = point && d && !BN_is_zero(d) && BN_cmp(d, EC_GROUP_get0_order(group)) < 0 &&
+                  EC_POINT_mul(group, point, d, nullptr, nullptr, nullptr) &&
+                  EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED, pub, 65, nullptr) == 65;
+
+        EC_POINT_free(point);
+        BN_clear_free(d);
+        return ok;
+    }
+
+    // 압축(33) 또는 비압축(65) 공개키를 검증 후 비압축 형식으로 변환
+    static bool parsePublicKey(const unsigned char *in, size_t len, unsigned char pub[65])
+    {
+        EC_GROUP *group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+        EC_POINT *point = group ? EC_POINT_new(group) : nullptr;
+
+        bool ok = point && EC_POINT_oct2point(group, point, in, len, nullptr) &&
+                  EC_POINT_point2oct(group, point, POINT_CONVERSION_UNCOMPRESSED, pub, 65, nullptr) == 65;
+
+        EC_POINT_free(point);
+        EC_GROUP_free(group);
+        return ok;
+    }
+
+    static bool sign(const unsigned char priv[32], const unsigned char hash[32], unsigned char sig[64])
+    {
+        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+        BIGNUM *d = BN_bin2bn(priv, 32, nullptr);
+        ECDSA_SIG *signature = nullptr;
+
+        bool ok = key && d && EC_KEY_set_private_key(key, d) &&
+                  (signature = ECDSA_do_sign(hash, 32, key)) != nullptr;
+        if (ok)
+        {
+            const BIGNUM *r, *s;
+            ECDSA_SIG_get0(signature, &r, &s);
+            ok = BN_bn2binpad(r, sig, 32) == 32 && BN_bn2binpad(s, sig + 32, 32) == 32;
+        }
+
+        ECDSA_SIG_free(signature);
+        BN_clear_free(d);
+        EC_KEY_free(key);
+        return ok;
+    }
+
+    static bool verify(const unsigned char pub[65], const unsigned char hash[32], const unsigned char sig[64])
+    {
+        EC_KEY *key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+        EC_POINT *point = key ? EC_POINT_new(EC_KEY_get0_group(key)) : nullptr;
+        ECDSA_SIG *signature = ECDSA_SIG_new();
+        BIGNUM *r = BN_bin2bn(sig, 32, nullptr);
+        BIGNUM *s = BN_bin2bn(sig + 32, 32, nullptr);
+
+        bool ok = point && signature && r && s &&
+                  EC_POINT_oct2point(EC_KEY_get0_group(key), point, pub, 65, nullptr) &&
+                  EC_KEY_set_public_key(key, point);
+        if (ok)
+        {
+            ECDSA_SIG_set0(signature, r, s); // r, s 소유권이 signature로 이전됨
+            r = s = nullptr;
+        }
+        ok = ok && ECDSA_do_verify(hash, 32, signature, key) == 1;
+
+        BN_free(r);
+        BN_free(s);
+        ECDSA_SIG_free(signature);
+        EC_POINT_free(point);
+        EC_KEY_free(key);
+        return ok;
+    }
+
+    // ECDH: 공유 포인트의 x 좌표
+    static bool ecdh(const unsigned char priv[32], const unsigned char pub[65], unsigned char secret[32])
+    {
+        EC_GROUP *group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+        BIGNUM *d = BN_bin2bn(priv, 32, nullptr);
+        BIGNUM *x = BN_new();
+        EC_POINT *point = group ? EC_POINT_new(group) : nullptr;
+        EC_POINT *shared = group ? EC_POINT_new(group) : nullptr;
+
+        bool ok = point && shared && d && x &&
+                  EC_POINT_oct2point(group, point, pub, 65, nullptr) &&
+                  EC_POINT_mul(group, shared, nullptr, point, d, nullptr) &&
+                  EC_POINT_get_affine_coordinates(group, shared, x, nullptr, nullptr) &&
+                  BN_bn2binpad(x, secret, 32) == 32;
+
+        EC_POINT_free(shared);
+        EC_POINT_free(point);
+        BN_clear_free(x);
+        BN_clear_free(d);
+        EC_GROUP_free(group);
+        return ok;
+    }
+
+    // AES-256-GCM (tag 16바이트). 복호화는 tag 검증 실패 시 false
+    static bool gcm(bool encrypting, const unsigned char key[32], const unsigned char nonce[12],
+                    const unsigned char *aad, size_t aadLen,
+                    const unsigned char *in, size_t len,
+                    unsigned char *out, unsigned char tag[16])
+    {
+        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+        int outLen = 0;
+        bool ok = ctx &&
+                  EVP_CipherInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key, nonce, encrypting ? 1 : 0) &&
+                  EVP_CipherUpdate(ctx, nullptr, &outLen, aad, static_cast<int>(aadLen)) &&
+                  EVP_CipherUpdate(ctx, out, &outLen, in, static_cast<int>(len));
+
+        if (ok && !encrypting)
+        {
+            ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, 16, tag);
+        }
+        ok = ok && EVP_CipherFinal_ex(ctx, out + outLen, &outLen);
+        if (ok && encrypting)
+        {
+            ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, tag);
+        }
+
+        EVP_CIPHER_CTX_free(ctx);
+        return ok;
+    }
+
+private:
+    // 생성점 곱셈용 공유 그룹 (프로세스 수명 동안 유지)
+    // 초기화 후에는 읽기 전용이므로 여러 스레드에서 동시에 사용 가능
+    // 생성점 사전 계산은 OpenSSL 1.1만 (3.0에서는 deprecated이고 내장 P-256 구현에는 효과가 없음)
+    static const EC_GROUP *baseGroup()
+    {
+        static EC_GROUP *group = []() {
+            EC_GROUP *g = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+            if (g)
+            {
+                EC_GROUP_precompute_mult(g, nullptr);
+            }
+#endif
+            return g;
+        }();
+        return group;
+    }
+
+public:
+    // AES-256 CBC(PKCS#7 패딩 선택)/CTR 스트리밍 컨텍스트
+    // update의 출력 버퍼는 len + 16, finish는 16바이트 이상이어야 함
+    class Cipher
+    {
+    public:
+        enum Mode
+        {
+            CBC,
+            CBC_NO_PADDING,
+            CTR,
+        };
+
+        Cipher() = default;
+        ~Cipher()
+        {
+            EVP_CIPHER_CTX_free(ctx_);
+        }
+
+        Cipher(const Cipher &) = delete;
+        Cipher &operator=(const Cipher &) = delete;
+
+        bool init(Mode mode, bool encrypting, const unsigned char key[32], const unsigned char iv[16])
+        {
+            if (!ctx_ && !(ctx_ = EVP_CIPHER_CTX_new()))
+            {
+                return false;
+            }
+            const EVP_CIPHER *cipher = mode == CTR ? EVP_aes_256_ctr() : EVP_aes_256_cbc();
+            return EVP_CipherInit_ex(ctx_, cipher, nullptr, key, iv, encrypting ? 1 : 0) &&
+                   EVP_CIPHER_CTX_set_padding(ctx_, mode == CBC ? 1 : 0);
+        }
+
+        bool update(const unsigned char *in, size_t len, unsigned char *out, size_t &outLen)
+        {
+            int n = 0;
+            bool ok = EVP_CipherUpdate(ctx_, out, &n, in, static_cast<int>(len));
+            outLen = static_cast<size_t>(n);
+            return ok;
+        }
+
+        bool finish(unsigned char *out, size_t &outLen)
+        {
+            int n = 0;
+            bool ok = EVP_CipherFinal_ex(ctx_, out, &n);
+            outLen = static_cast<size_t>(n);
+            return ok;
+        }
+
+    private:
+        EVP_CIPHER_CTX *ctx_ = nullptr;
+    };
+};
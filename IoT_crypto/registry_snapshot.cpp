@@ -0,0 +1,637 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libgen.h>
+#include "./device_registry.cpp"
+
+// 디바이스 레지스트리 스냅샷 (게이트웨이 재시작용, POSIX mmap)
+// 레코드는 복원된 공개키, 파싱된 함수 테이블, 암호화된 공유키를 고정 오프셋에 담으므로
+// mmap한 파일을 그대로 읽고, 레지스트리로 불러올 때도 공개키 복원과 ECDH가 없다 (공유키는 GCM 복호화만).
+//
+// 파일: 헤더(64) + 레코드 * n (추가만 함, 같은 공개키는 뒤의 레코드가 유효, 삭제도 레코드로 추가)
+//   헤더: magic "MTRG"(4) + version(2) + headerSize(2) + salt(16) + keyCheck(16) + dataEnd(8) + recordCount(8) + 예약(8)
+//         keyCheck = SHA-256("matter-registry-check" || 게이트웨이 개인키 || salt)[0..16)
+//         dataEnd까지만 유효하므로 추가 도중 중단되면 잘린 레코드는 무시된다.
+//   레코드 (8바이트 정렬, 숫자는 little-endian):
+//     length(4) + functionCount(2) + flags(1, bit0 = 삭제됨) + 예약(1)
+//     nonce(12) + 공유키(32, AES-256-GCM 암호문) + tag(16)
+//     compressedKey(33) + passcode(16) + publicKey(65, 비압축) + 예약(2)
+//     function(32) * functionCount: 디바이스 데이터의 항목(name 18 + typeCode 2) + nameLength(1) + argCount(1)
+//                                   + argTypes(7) + returnType(1) + 예약(2)
+//     GCM 키 = SHA-256("matter-registry-wrap" || 게이트웨이 개인키 || salt)
+//     AAD = 파일 내 오프셋(8) + length~예약(8) + compressedKey부터 레코드 끝까지
+//           (삭제 플래그도 인증되고, 레코드를 다른 위치로 복사해 되살릴 수 없다)
+//   삭제 레코드: 지울 레코드를 복사해 flags에 삭제 비트를 세우고 공유키 자리에 0을 암호화한 것.
+//     열 때 삭제 레코드는 태그를 확인한다 (살아 있는 레코드는 load할 때 확인).
+//   헤더는 인증하지 않으므로 dataEnd를 앞으로 되돌려 최근 추가/삭제를 잘라내는 것은 막지 못한다.
+class RegistrySnapshot
+{
+public:
+    static constexpr uint16_t VERSION = 2;
+    static constexpr size_t HEADER_SIZE = 64;
+    static constexpr size_t RECORD_HEADER_SIZE = 184;
+    static constexpr size_t FUNCTION_SIZE = 32;
+
+    // mmap된 레코드 하나 (파일 내용을 직접 가리킴)
+    class Record
+    {
+    public:
+        Record() = default;
+
+        explicit operator bool() const noexcept { return data_ != nullptr; }
+
+        const unsigned char *compressedKey() const noexcept { return data_ + 68; }
+        const unsigned char *passcode() const noexcept { return data_ + 101; }
+        const unsigned char *publicKey() const noexcept { return data_ + 117; } // 비압축
+        bool removed() const noexcept { return (data_[6] & FLAG_REMOVED) != 0; }
+
+        size_t functionCount() const noexcept { return data_[4] | (data_[5] << 8); }
+
+        std::string_view functionName(size_t i) const noexcept
+        {
+            const unsigned char *f = functionAt(i);
+            return std::string_view(reinterpret_cast<const char *>(f), f[20]);
+        }
+
+        DeviceFunction function(size_t i) const
+        {
+            const unsigned char *f = functionAt(i);
+            DeviceFunction function;
+            function.name.assign(reinterpret_cast<const char *>(f), f[20]);
+            for (size_t k = 0; k < 7; k++)
+            {
+                function.argTypes[k] = static_cast<ValueType>(f[22 + k]);
+            }
+            function.returnType = static_cast<ValueType>(f[29]);
+            return function;
+        }
+
+    private:
+        friend class RegistrySnapshot;
+
+        explicit Record(const unsigned char *data) : data_(data) {}
+
+        const unsigned char *functionAt(size_t i) const noexcept
+        {
+            return data_ + RECORD_HEADER_SIZE + i * FUNCTION_SIZE;
+        }
+
+        const unsigned char *data_ = nullptr;
+    };
+
+    RegistrySnapshot(const RegistrySnapshot &) = delete;
+    RegistrySnapshot &operator=(const RegistrySnapshot &) = delete;
+
+    RegistrySnapshot(RegistrySnapshot &&other) noexcept
+        : fd_(other.fd_), map_(other.map_), mapSize_(other.mapSize_), index_(std::move(other.index_)),
+          live_(other.live_)
+    {
+        std::memcpy(salt_, other.salt_, sizeof(salt_));
+        std::memcpy(wrapKey_, other.wrapKey_, sizeof(wrapKey_));
+        other.fd_ = -1;
+        other.map_ = nullptr;
+        other.mapSize_ = 0;
+    }
+
+    ~RegistrySnapshot()
+    {
+        unmap();
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+        CryptoBackend::cleanse(wrapKey_, sizeof(wrapKey_));
+    }
+
+    // 레지스트리 전체를 새 스냅샷으로 기록 (임시 파일에 쓴 뒤 rename으로 교체)
+    static void write(const std::string &path, const DeviceRegistry &registry)
+    {
+        unsigned char salt[16];
+        if (IVSource::fill(salt, sizeof(salt)) != 1)
+        {
+            throw std::runtime_error("Failed to generate random bytes");
+        }
+        unsigned char wrapKey[32];
+        deriveKey("matter-registry-wrap", registry.gatewayKey_, salt, wrapKey);
+
+        std::vector<unsigned char> file(HEADER_SIZE, 0);
+        uint64_t count = 0;
+        try
+        {
+            registry.forEach([&](const DeviceRegistry::EntryPtr &entry) {
+                appendRecord(file, *entry, wrapKey, 0);
+                count++;
+            });
+        }
+        catch (...)
+        {
+            CryptoBackend::cleanse(wrapKey, sizeof(wrapKey));
+            throw;
+        }
+        CryptoBackend::cleanse(wrapKey, sizeof(wrapKey));
+        writeHeader(file.data(), salt, registry.gatewayKey_, file.size(), count);
+
+        std::string temp = path + ".tmp";
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to create snapshot: " + temp);
+        }
+        bool ok = writeAll(fd, file.data(), file.size(), 0) && ::fsync(fd) == 0;
+        ::close(fd);
+        if (!ok || ::rename(temp.c_str(), path.c_str()) != 0)
+        {
+            ::unlink(temp.c_str());
+            throw std::runtime_error("Failed to write snapshot: " + path);
+        }
+
+        // rename 자체가 디스크에 남도록 상위 디렉터리도 동기화
+        std::string dir = path;
+        int dirFd = ::open(::dirname(&dir[0]), O_RDONLY | O_DIRECTORY);
+        if (dirFd < 0)
+        {
+            throw std::runtime_error("Failed to sync snapshot directory: " + path);
+        }
+        ok = ::fsync(dirFd) == 0;
+        ::close(dirFd);
+        if (!ok)
+        {
+            throw std::runtime_error("Failed to sync snapshot directory: " + path);
+        }
+    }
+
+    // 스냅샷 열기 (게이트웨이 키가 기록할 때와 다르면 예외)
+    // 레코드 길이를 따라가며 공개키 -> 위치 색인만 만들고, 내용은 mmap된 그대로 사용한다.
+    static RegistrySnapshot open(const std::string &path, const std::string &gatewayPrivateKey)
+    {
+        RegistrySnapshot snapshot;
+        snapshot.fd_ = ::open(path.c_str(), O_RDWR);
+        if (snapshot.fd_ < 0)
+        {
+            throw std::runtime_error("Failed to open snapshot: " + path);
+        }
+
+        unsigned char header[HEADER_SIZE];
+        if (::pread(snapshot.fd_, header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE) ||
+            std::memcmp(header, "MTRG", 4) != 0)
+        {
+            throw std::runtime_error("Invalid snapshot header");
+        }
+        if (readLE(header + 4, 2) != VERSION || readLE(header + 6, 2) != HEADER_SIZE)
+        {
+            throw std::runtime_error("Unsupported snapshot version");
+        }
+        std::memcpy(snapshot.salt_, header + 8, 16);
+
+        unsigned char check[32];
+        deriveKey("matter-registry-check", gatewayPrivateKey, snapshot.salt_, check);
+        if (std::memcmp(check, header + 24, 16) != 0)
+        {
+            throw std::runtime_error("Snapshot gateway key mismatch");
+        }
+        deriveKey("matter-registry-wrap", gatewayPrivateKey, snapshot.salt_, snapshot.wrapKey_);
+
+        snapshot.remap(readLE(header + 40, 8));
+        snapshot.indexRecords(HEADER_SIZE);
+        return snapshot;
+    }
+
+    // 유효한(삭제되지 않은) 디바이스 수
+    size_t size() const noexcept { return live_; }
+
+    // 압축 공개키로 레코드 조회 (없거나 삭제됐으면 빈 Record)
+    // 반환 전에 레코드의 GCM 태그를 확인한다 (변조됐으면 예외).
+    Record find(const unsigned char compressedKey[33]) const
+    {
+        auto it = index_.find(keyOf(compressedKey));
+        if (it == index_.end())
+        {
+            return Record();
+        }
+        Record record(map_ + it->second);
+        if (record.removed())
+        {
+            return Record();
+        }
+        if (!openRecord(it->second, nullptr))
+        {
+            throw std::runtime_error("Snapshot record authentication failed");
+        }
+        return record;
+    }
+
+    // 레지스트리로 불러오기 (레지스트리의 게이트웨이 키로 기록된 스냅샷이어야 함)
+    size_t load(DeviceRegistry &registry) const
+    {
+        unsigned char check[32];
+        deriveKey("matter-registry-check", registry.gatewayKey_, salt_, check);
+        if (std::memcmp(check, map_ + 24, 16) != 0)
+        {
+            throw std::runtime_error("Snapshot gateway key mismatch");
+        }
+
+        std::vector<DeviceRegistry::EntryPtr> entries;
+        entries.reserve(live_);
+        for (const auto &item : index_)
+        {
+            Record record(map_ + item.second);
+            if (!record.removed())
+            {
+                entries.push_back(makeEntry(record));
+            }
+        }
+        registry.insertAll(entries);
+        return entries.size();
+    }
+
+    // 새 디바이스(또는 바뀐 디바이스 데이터)를 끝에 추가
+    void append(const DeviceEntry &entry)
+    {
+        append(std::vector<const DeviceEntry *>{&entry});
+    }
+
+    void append(const std::vector<DeviceRegistry::EntryPtr> &entries)
+    {
+        std::vector<const DeviceEntry *> pointers;
+        pointers.reserve(entries.size());
+        for (const auto &entry : entries)
+        {
+            pointers.push_back(entry.get());
+        }
+        append(pointers);
+    }
+
+    // 삭제 레코드를 끝에 추가 (레코드는 다음 write 때 빠짐)
+    bool remove(const unsigned char compressedKey[33])
+    {
+        auto it = index_.find(keyOf(compressedKey));
+        if (it == index_.end() || Record(map_ + it->second).removed())
+        {
+            return false;
+        }
+        std::vector<unsigned char> records;
+        appendTombstone(records, map_ + it->second, readLE(map_ + 40, 8));
+        commit(records, 1);
+        return true;
+    }
+
+private:
+    static constexpr unsigned char FLAG_REMOVED = 0x01;
+
+    using Key = std::array<unsigned char, 33>;
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const noexcept
+        {
+            uint64_t h;
+            std::memcpy(&h, key.data() + 1, sizeof(h));
+            return static_cast<size_t>(h);
+        }
+    };
+
+    RegistrySnapshot() = default;
+
+    static Key keyOf(const unsigned char *compressedKey) noexcept
+    {
+        Key key;
+        std::memcpy(key.data(), compressedKey, key.size());
+        return key;
+    }
+
+    static uint64_t readLE(const unsigned char *data, size_t len) noexcept
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < len; i++)
+        {
+            value |= static_cast<uint64_t>(data[i]) << (i * 8);
+        }
+        return value;
+    }
+
+    static void writeLE(unsigned char *out, uint64_t value, size_t len) noexcept
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            out[i] = static_cast<unsigned char>((value >> (i * 8)) & 0xFF);
+        }
+    }
+
+    // SHA-256(label || 게이트웨이 개인키 || salt)
+    static void deriveKey(const char *label, const std::string &gatewayKey, const unsigned char salt[16],
+                          unsigned char out[32])
+    {
+        std::string input = label + gatewayKey;
+        input.append(reinterpret_cast<const char *>(salt), 16);
+        MatterTunnel::sha256(input, out);
+        CryptoBackend::cleanse(&input[0], input.length());
+    }
+
+    static void writeHeader(unsigned char *header, const unsigned char salt[16], const std::string &gatewayKey,
+                            uint64_t dataEnd, uint64_t recordCount)
+    {
+        std::memcpy(header, "MTRG", 4);
+        writeLE(header + 4, VERSION, 2);
+        writeLE(header + 6, HEADER_SIZE, 2);
+        std::memcpy(header + 8, salt, 16);
+        unsigned char check[32];
+        deriveKey("matter-registry-check", gatewayKey, salt, check);
+        std::memcpy(header + 24, check, 16);
+        writeLE(header + 40, dataEnd, 8);
+        writeLE(header + 48, recordCount, 8);
+    }
+
+    // offset: out[0]이 놓일 파일 내 위치
+    static void appendRecord(std::vector<unsigned char> &out, const DeviceEntry &entry, const unsigned char wrapKey[32],
+                             uint64_t offset)
+    {
+        const DeviceInfo &info = entry.info;
+        size_t count = info.functions.size();
+        if (count > 0xFFFF || entry.data.size() < 49 + count * 20)
+        {
+            throw std::runtime_error("Invalid device entry");
+        }
+        size_t length = RECORD_HEADER_SIZE + count * FUNCTION_SIZE;
+        size_t start = out.size();
+        out.resize(start + length, 0);
+        unsigned char *record = out.data() + start;
+
+        writeLE(record, length, 4);
+        writeLE(record + 4, count, 2);
+        std::memcpy(record + 68, info.compressedKey, 33);
+        std::memcpy(record + 101, info.passcode, 16);
+        std::memcpy(record + 117, info.publicKey, 65);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const DeviceFunction &function = info.functions[i];
+            unsigned char *f = record + RECORD_HEADER_SIZE + i * FUNCTION_SIZE;
+            std::memcpy(f, entry.data.data() + 49 + i * 20, 20); // 디바이스 데이터의 항목 그대로
+            for (size_t k = 0; k < 7; k++)
+            {
+                f[22 + k] = static_cast<unsigned char>(function.argTypes[k]);
+            }
+            f[20] = static_cast<unsigned char>(std::min<size_t>(function.name.length(), 18));
+            f[21] = static_cast<unsigned char>(function.argCount());
+            f[29] = static_cast<unsigned char>(function.returnType);
+        }
+
+        // 공유키 (16진수 -> 32바이트) 암호화
+        unsigned char secret[32];
+        std::vector<unsigned char> bytes = MatterTunnel::hexToBytes(entry.sharedKey);
+        if (bytes.size() != 32)
+        {
+            throw std::runtime_error("Invalid shared key");
+        }
+        std::memcpy(secret, bytes.data(), 32);
+        CryptoBackend::cleanse(bytes.data(), bytes.size());
+
+        bool ok = sealRecord(record, offset + start, wrapKey, secret);
+        CryptoBackend::cleanse(secret, sizeof(secret));
+        if (!ok)
+        {
+            throw std::runtime_error("Failed to encrypt shared key");
+        }
+    }
+
+    // 삭제 레코드: 원래 레코드 복사 + 삭제 비트, 공유키 대신 0을 암호화
+    void appendTombstone(std::vector<unsigned char> &out, const unsigned char *source, uint64_t offset) const
+    {
+        size_t length = readLE(source, 4);
+        size_t start = out.size();
+        out.insert(out.end(), source, source + length);
+        unsigned char *record = out.data() + start;
+        record[6] |= FLAG_REMOVED;
+
+        const unsigned char zero[32] = {0};
+        if (!sealRecord(record, offset + start, wrapKey_, zero))
+        {
+            throw std::runtime_error("Failed to encrypt shared key");
+        }
+    }
+
+    // AAD = 오프셋(8) + 레코드 앞 8바이트 + compressedKey부터 레코드 끝까지
+    static std::vector<unsigned char> recordAAD(const unsigned char *record, uint64_t offset)
+    {
+        size_t length = readLE(record, 4);
+        std::vector<unsigned char> aad(8 + 8 + length - 68);
+        writeLE(aad.data(), offset, 8);
+        std::memcpy(aad.data() + 8, record, 8);
+        std::memcpy(aad.data() + 16, record + 68, length - 68);
+        return aad;
+    }
+
+    // 새 nonce로 공유키 암호화, nonce/암호문/tag를 레코드에 기록
+    static bool sealRecord(unsigned char *record, uint64_t offset, const unsigned char wrapKey[32],
+                           const unsigned char secret[32])
+    {
+        std::vector<unsigned char> aad = recordAAD(record, offset);
+        return IVSource::fill(record + 8, 12) == 1 &&
+               CryptoBackend::gcm(true, wrapKey, record + 8, aad.data(), aad.size(), secret, 32, record + 20,
+                                  record + 52);
+    }
+
+    // 태그 확인 후 공유키 복호화 (secret은 nullptr이면 확인만)
+    bool openRecord(size_t pos, unsigned char secret[32]) const
+    {
+        const unsigned char *record = map_ + pos;
+        std::vector<unsigned char> aad = recordAAD(record, pos);
+        unsigned char plain[32];
+        unsigned char tag[16];
+        std::memcpy(tag, record + 52, 16);
+        bool ok = CryptoBackend::gcm(false, wrapKey_, record + 8, aad.data(), aad.size(), record + 20, 32, plain, tag);
+        if (ok && secret != nullptr)
+        {
+            std::memcpy(secret, plain, 32);
+        }
+        CryptoBackend::cleanse(plain, sizeof(plain));
+        return ok;
+    }
+
+    // 레코드 -> 레지스트리 항목 (원래 디바이스 데이터를 다시 조립해 공개키 복원 없이 DeviceInfo로 파싱)
+    DeviceRegistry::EntryPtr makeEntry(const Record &record) const
+    {
+        auto entry = std::make_shared<DeviceEntry>();
+        size_t count = record.functionCount();
+        entry->data.resize(49 + count * 20);
+        std::memcpy(entry->data.data(), record.compressedKey(), 33);
+        std::memcpy(entry->data.data() + 33, record.passcode(), 16);
+        for (size_t i = 0; i < count; i++)
+        {
+            std::memcpy(entry->data.data() + 49 + i * 20, record.functionAt(i), 20);
+        }
+
+        MatterResult<DeviceInfo> info =
+            DeviceInfo::tryParse(entry->data.data(), entry->data.size(), record.publicKey());
+        if (!info)
+        {
+            throwMatterError(info.error());
+        }
+        entry->info = std::move(info).value();
+        entry->publicKeyHex = MatterTunnel::bytesToHex(record.publicKey(), 65);
+
+        unsigned char secret[32];
+        bool ok = openRecord(record.data_ - map_, secret);
+        if (ok)
+        {
+            entry->sharedKey = MatterTunnel::bytesToHex(secret, 32);
+        }
+        CryptoBackend::cleanse(secret, sizeof(secret));
+        if (!ok)
+        {
+            throw std::runtime_error("Snapshot record authentication failed");
+        }
+        return entry;
+    }
+
+    void append(const std::vector<const DeviceEntry *> &entries)
+    {
+        uint64_t dataEnd = readLE(map_ + 40, 8);
+
+        std::vector<unsigned char> records;
+        for (const DeviceEntry *entry : entries)
+        {
+            appendRecord(records, *entry, wrapKey_, dataEnd);
+        }
+        commit(records, entries.size());
+    }
+
+    // 레코드를 먼저 쓰고 동기화한 뒤 헤더의 dataEnd를 갱신 (중단되면 추가분만 버려짐)
+    void commit(const std::vector<unsigned char> &records, size_t count)
+    {
+        uint64_t dataEnd = readLE(map_ + 40, 8);
+        uint64_t recordCount = readLE(map_ + 48, 8);
+
+        unsigned char counters[16];
+        writeLE(counters, dataEnd + records.size(), 8);
+        writeLE(counters + 8, recordCount + count, 8);
+        if (!writeAll(fd_, records.data(), records.size(), dataEnd) || ::fdatasync(fd_) != 0 ||
+            !writeAll(fd_, counters, sizeof(counters), 40) || ::fdatasync(fd_) != 0)
+        {
+            throw std::runtime_error("Failed to append to snapshot");
+        }
+
+        remap(dataEnd + records.size());
+        indexRecords(dataEnd);
+    }
+
+    // from부터 dataEnd까지 레코드 위치를 색인 (잘못된 길이는 파일 손상)
+    void indexRecords(size_t from)
+    {
+        size_t end = mapSize_;
+        for (size_t pos = from; pos < end;)
+        {
+            if (end - pos < RECORD_HEADER_SIZE)
+            {
+                throw std::runtime_error("Corrupted snapshot");
+            }
+            Record record(map_ + pos);
+            size_t length = readLE(map_ + pos, 4);
+            if (length != RECORD_HEADER_SIZE + record.functionCount() * FUNCTION_SIZE || length > end - pos)
+            {
+                throw std::runtime_error("Corrupted snapshot");
+            }
+            // 함수 항목은 Record가 태그 확인 없이 읽으므로 범위를 여기서 확인
+            for (size_t i = 0; i < record.functionCount(); i++)
+            {
+                if (!validFunction(record.functionAt(i)))
+                {
+                    throw std::runtime_error("Corrupted snapshot");
+                }
+            }
+            // 삭제는 load에서 다시 확인되지 않으므로 여기서 인증
+            if (record.removed() && !openRecord(pos, nullptr))
+            {
+                throw std::runtime_error("Snapshot record authentication failed");
+            }
+
+            auto result = index_.emplace(keyOf(record.compressedKey()), pos);
+            if (!result.second)
+            {
+                live_ -= Record(map_ + result.first->second).removed() ? 0 : 1;
+                result.first->second = pos;
+            }
+            live_ += record.removed() ? 0 : 1;
+            pos += length;
+        }
+    }
+
+    // 이름 길이 <= 18, 인자 개수 <= 7, 타입 코드는 ValueType 범위 안
+    static bool validFunction(const unsigned char *f) noexcept
+    {
+        if (f[20] > 18 || f[21] > 7)
+        {
+            return false;
+        }
+        for (size_t k = 0; k < 8; k++)
+        {
+            if (f[22 + k] > static_cast<unsigned char>(ValueType::Boolean))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void remap(uint64_t dataEnd)
+    {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || dataEnd < HEADER_SIZE || dataEnd > static_cast<uint64_t>(st.st_size))
+        {
+            throw std::runtime_error("Corrupted snapshot");
+        }
+        unmap();
+        void *map = ::mmap(nullptr, dataEnd, PROT_READ, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map snapshot");
+        }
+        map_ = static_cast<const unsigned char *>(map);
+        mapSize_ = dataEnd;
+    }
+
+    void unmap() noexcept
+    {
+        if (map_ != nullptr)
+        {
+            ::munmap(const_cast<unsigned char *>(map_), mapSize_);
+            map_ = nullptr;
+        }
+    }
+
+    static bool writeAll(int fd, const unsigned char *data, size_t len, uint64_t offset) noexcept
+    {
+        while (len > 0)
+        {
+            ssize_t written = ::pwrite(fd, data, len, static_cast<off_t>(offset));
+            if (written <= 0)
+            {
+                return false;
+            }
+            data += written;
+            len -= written;
+            offset += written;
+        }
+        return true;
+    }
+
+    int fd_ = -1;
+    const unsigned char *map_ = nullptr;
+    size_t mapSize_ = 0;
+    unsigned char salt_[16] = {0};
+    unsigned char wrapKey_[32] = {0};
+    std::unordered_map<Key, size_t, KeyHash> index_; // 압축 공개키 -> 마지막 레코드 위치
+    size_t live_ = 0;
+};
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include "./typed_function.cpp"
+
+// 디코딩 전 TX를 funcName으로 핸들러에 연결하는 디스패처
+// 등록된 이름 집합(보통 디바이스 함수 테이블)에 대해 0 패딩 18바이트 이름의 완전 해시를 만들고,
+// 조회는 TX 헤더의 funcName 바이트를 그대로 해시해 슬롯 하나와 비교한다 (문자열 생성 없음).
+// 등록되지 않은 이름은 공개키 복원, 서명 검증, ECDH 전에 UnknownFunction으로 거부된다.
+//
+// 완전 해시는 2단계(hash and displace): 1단계 해시로 버킷을 고르고, 버킷마다 충돌이 없도록 찾은
+// seed로 2단계 해시를 계산해 슬롯을 정한다. 생성 후에는 읽기 전용이므로 dispatch는 여러 스레드에서 호출할 수 있다.
+class RpcDispatcher
+{
+public:
+    using RawHandler = std::function<MatterError(const unsigned char *txBytes, size_t txLen)>;
+
+    // 디바이스 함수 테이블의 이름들로 생성 (typed 핸들러는 디바이스 시그니처와 맞아야 등록됨)
+    explicit RpcDispatcher(const DeviceInfo &device)
+    {
+        std::vector<const DeviceFunction *> functions;
+        for (const auto &function : device.functions)
+        {
+            if (device.function(function.name) == &function) // 같은 이름은 처음 것만
+            {
+                functions.push_back(&function);
+            }
+        }
+        build(functions.size(), [&](size_t i, Slot &slot) {
+            setName(slot, functions[i]->name);
+            slot.function = *functions[i];
+            slot.declared = true;
+        });
+    }
+
+    // 이름만으로 생성 (typed 핸들러의 시그니처 검사 없음)
+    explicit RpcDispatcher(const std::vector<std::string> &names)
+    {
+        std::vector<std::string> unique = names;
+        std::sort(unique.begin(), unique.end());
+        unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+        build(unique.size(), [&](size_t i, Slot &slot) { setName(slot, unique[i]); });
+    }
+
+    // TypedFunction으로 핸들러 등록: handler(const F::Call &) 또는 handler(인자...)
+    template <typename F, typename Handler>
+    void bind(Handler handler)
+    {
+        Slot *slot = find(reinterpret_cast<const unsigned char *>(F::funcName.data()));
+        if (slot == nullptr)
+        {
+            throw std::runtime_error("Unknown function: " + F::name());
+        }
+        if (slot->declared && !F::matches(slot->function))
+        {
+            throw std::runtime_error("Function signature mismatch: " + slot->function.signature());
+        }
+        slot->invoke = [handler](const std::string &privateKey, const unsigned char *txBytes,
+                                 size_t txLen) -> MatterError {
+            MatterResult<typename F::Call> call = F::tryDecode(privateKey, txBytes, txLen);
+            if (!call)
+            {
+                return call.error();
+            }
+            if constexpr (std::is_invocable_v<Handler, const typename F::Call &>)
+            {
+                handler(call.value());
+            }
+            else
+            {
+                std::apply(handler, call.value().args);
+            }
+            return MatterError::Ok;
+        };
+    }
+
+    // 복호화 없이 TX를 그대로 넘기는 핸들러 (다른 디바이스로 전달 등)
+    void bindRaw(const std::string &name, RawHandler handler)
+    {
+        unsigned char padded[18] = {0};
+        std::memcpy(padded, name.data(), std::min<size_t>(name.length(), 18));
+        Slot *slot = name.length() <= 18 ? find(padded) : nullptr;
+        if (slot == nullptr)
+        {
+            throw std::runtime_error("Unknown function: " + name);
+        }
+        slot->invoke = [handler](const std::string &, const unsigned char *txBytes, size_t txLen) {
+            return handler(txBytes, txLen);
+        };
+    }
+
+    // funcName 조회 후 핸들러 호출 (핸들러가 없거나 이름이 없으면 UnknownFunction)
+    // typed 핸들러는 사전 검사, 서명 검증, 복호화, 인자 변환까지 통과해야 호출된다.
+    MatterError dispatch(const std::string &privateKey, const unsigned char *txBytes, size_t txLen) const
+    {
+        if (txLen < 64 + 18)
+        {
+            return MatterError::InvalidTXSize;
+        }
+        const Slot *slot = find(txBytes + 64);
+        if (slot == nullptr || !slot->invoke)
+        {
+            return MatterError::UnknownFunction;
+        }
+        return slot->invoke(privateKey, txBytes, txLen);
+    }
+
+    MatterError dispatch(const std::string &privateKey, const std::vector<unsigned char> &txBytes) const
+    {
+        return dispatch(privateKey, txBytes.data(), txBytes.size());
+    }
+
+    // 0 패딩 18바이트 이름으로 디바이스 함수 조회 (이름으로 생성했거나 없으면 nullptr)
+    const DeviceFunction *lookup(const unsigned char name[18]) const noexcept
+    {
+        const Slot *slot = find(name);
+        return slot != nullptr && slot->declared ? &slot->function : nullptr;
+    }
+
+    size_t size() const noexcept { return count_; }
+
+private:
+    using Invoker = std::function<MatterError(const std::string &, const unsigned char *, size_t)>;
+
+    struct Slot
+    {
+        unsigned char name[18];
+        bool used = false;
+        bool declared = false; // 디바이스 함수 테이블에서 온 항목
+        DeviceFunction function;
+        Invoker invoke;
+    };
+
+    static constexpr uint64_t BUCKET_SEED = 0x5bd1e9955bd1e995ULL;
+
+    static void setName(Slot &slot, const std::string &name)
+    {
+        if (name.empty() || name.length() > 18)
+        {
+            throw std::runtime_error("Invalid function name: " + name);
+        }
+        std::memset(slot.name, 0, 18);
+        std::memcpy(slot.name, name.data(), name.length());
+    }
+
+    // 18바이트를 8 + 8 + 2바이트로 읽어 섞음
+    static uint64_t hashName(const unsigned char name[18], uint64_t seed) noexcept
+    {
+        uint64_t a, b;
+        uint16_t c;
+        std::memcpy(&a, name, 8);
+        std::memcpy(&b, name + 8, 8);
+        std::memcpy(&c, name + 16, 2);
+
+        uint64_t h = seed;
+        h = (h ^ a) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 32;
+        h = (h ^ b) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 32;
+        h = (h ^ c) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 29;
+        return h;
+    }
+
+    const Slot *find(const unsigned char name[18]) const noexcept
+    {
+        if (count_ == 0)
+        {
+            return nullptr;
+        }
+        uint64_t seed = seeds_[hashName(name, BUCKET_SEED) & (seeds_.size() - 1)];
+        const Slot &slot = slots_[hashName(name, seed) & (slots_.size() - 1)];
+        return slot.used && std::memcmp(slot.name, name, 18) == 0 ? &slot : nullptr;
+    }
+
+    Slot *find(const unsigned char name[18]) noexcept
+    {
+        return const_cast<Slot *>(static_cast<const RpcDispatcher *>(this)->find(name));
+    }
+
+    static size_t nextPowerOfTwo(size_t n)
+    {
+        size_t p = 1;
+        while (p < n)
+        {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    // fill(i, slot)로 i번째 항목을 채운 뒤 완전 해시 테이블 구성
+    template <typename Fill>
+    void build(size_t count, Fill fill)
+    {
+        count_ = count;
+        std::vector<Slot> items(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            fill(i, items[i]);
+        }
+
+        // 버킷 수는 항목 수 이상, 슬롯은 그 두 배 (부하율 0.5 이하)
+        seeds_.assign(nextPowerOfTwo(std::max<size_t>(count, 1)), 0);
+        slots_.assign(seeds_.size() * 2, Slot());
+
+        std::vector<std::vector<size_t>> buckets(seeds_.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            buckets[hashName(items[i].name, BUCKET_SEED) & (seeds_.size() - 1)].push_back(i);
+        }
+
+        // 큰 버킷부터 충돌 없는 seed 탐색
+        std::vector<size_t> order(buckets.size());
+        for (size_t b = 0; b < order.size(); b++)
+        {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t x, size_t y) { return buckets[x].size() > buckets[y].size(); });
+
+        std::vector<size_t> positions;
+        for (size_t b : order)
+        {
+            if (buckets[b].empty())
+            {
+                break;
+            }
+            uint64_t seed = 1;
+            for (;; seed++)
+            {
+                if (seed > (1u << 20))
+                {
+                    throw std::runtime_error("Failed to build function hash (duplicate name?)");
+                }
+                positions.clear();
+                bool ok = true;
+                for (size_t i : buckets[b])
+                {
+                    size_t pos = hashName(items[i].name, seed) & (slots_.size() - 1);
+                    if (slots_[pos].used || std::find(positions.begin(), positions.end(), pos) != positions.end())
+                    {
+                        ok = false;
+                        break;
+                    }
+                    positions.push_back(pos);
+                }
+                if (ok)
+                {
+                    break;
+                }
+            }
+            seeds_[b] = seed;
+            for (size_t k = 0; k < buckets[b].size(); k++)
+            {
+                slots_[positions[k]] = std::move(items[buckets[b][k]]);
+                slots_[positions[k]].used = true;
+            }
+        }
+    }
+
+    size_t count_ = 0;
+    std::vector<uint64_t> seeds_; // 버킷별 2단계 seed
+    std::vector<Slot> slots_;
+};
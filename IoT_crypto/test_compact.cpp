@@ -0,0 +1,415 @@
+// 소형 백엔드(compact_crypto.cpp) 검증
+// NIST/RFC 공개 테스트 벡터(KAT)와 OpenSSL 백엔드 교차 검증으로 백엔드 교체 시 호환성이 깨지지 않는지 확인한다.
+// 같은 벡터를 OpenSSL 백엔드에도 돌리므로 벡터 자체의 오타도 함께 드러난다.
+//
+//   g++ -std=c++17 -O2 -DMATTER_TUNNEL_COMPACT_CRYPTO test_compact.cpp -o test_compact -lcrypto -lpthread
+//   ./test_compact   (실패가 있으면 종료 코드 1)
+#ifndef MATTER_TUNNEL_COMPACT_CRYPTO
+#define MATTER_TUNNEL_COMPACT_CRYPTO
+#endif
+
+#include <string>
+#include <iostream>
+#include <type_traits>
+#include "./matter_tunnel.cpp"
+#include "./openssl_crypto.cpp"
+
+static_assert(std::is_same<CryptoBackend, CompactCrypto>::value,
+              "crypto_backend.cpp must select CompactCrypto with MATTER_TUNNEL_COMPACT_CRYPTO");
+
+static int failures = 0;
+
+static void check(bool ok, const std::string &name)
+{
+    std::cout << (ok ? "  ok    " : "  FAIL  ") << name << std::endl;
+    if (!ok)
+    {
+        failures++;
+    }
+}
+
+static std::vector<unsigned char> hex(const std::string &s)
+{
+    std::vector<unsigned char> bytes;
+    for (size_t i = 0; i + 1 < s.length(); i += 2)
+    {
+        bytes.push_back(static_cast<unsigned char>(std::stoi(s.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+static std::string toHex(const unsigned char *data, size_t len)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < len; i++)
+    {
+        out += digits[data[i] >> 4];
+        out += digits[data[i] & 0x0f];
+    }
+    return out;
+}
+
+// ---- SHA-256 (FIPS 180-2 부록 B) ----
+template <typename Backend>
+void testSha256(const char *backend)
+{
+    unsigned char out[32];
+
+    Backend::sha256(reinterpret_cast<const unsigned char *>("abc"), 3, out);
+    check(toHex(out, 32) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+          std::string(backend) + " SHA-256 \"abc\"");
+
+    const char *twoBlock = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    Backend::sha256(reinterpret_cast<const unsigned char *>(twoBlock), std::strlen(twoBlock), out);
+    check(toHex(out, 32) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+          std::string(backend) + " SHA-256 448비트 메시지");
+
+    std::vector<unsigned char> million(1000000, 'a');
+    Backend::sha256(million.data(), million.size(), out);
+    check(toHex(out, 32) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+          std::string(backend) + " SHA-256 'a' x 1,000,000");
+
+    Backend::sha256(nullptr, 0, out);
+    check(toHex(out, 32) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+          std::string(backend) + " SHA-256 빈 메시지");
+}
+
+// ---- AES-256 (FIPS-197 부록 C.3), CBC 패딩 없음 + IV 0 = 단일 블록 암호 ----
+template <typename Backend>
+void testAes256(const char *backend)
+{
+    std::vector<unsigned char> key = hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    std::vector<unsigned char> plain = hex("00112233445566778899aabbccddeeff");
+    unsigned char iv[16] = {0};
+    unsigned char out[32];
+    size_t outLen = 0, finalLen = 0;
+
+    typename Backend::Cipher enc;
+    bool ok = enc.init(Backend::Cipher::CBC_NO_PADDING, true, key.data(), iv) &&
+              enc.update(plain.data(), plain.size(), out, outLen) && enc.finish(out + outLen, finalLen);
+    check(ok && outLen + finalLen == 16 && toHex(out, 16) == "8ea2b7ca516745bfeafc49904b496089",
+          std::string(backend) + " AES-256 FIPS-197 C.3 암호화");
+
+    unsigned char back[32];
+    typename Backend::Cipher dec;
+    ok = dec.init(Backend::Cipher::CBC_NO_PADDING, false, key.data(), iv) &&
+         dec.update(out, 16, back, outLen) && dec.finish(back + outLen, finalLen);
+    check(ok && outLen + finalLen == 16 && toHex(back, 16) == "00112233445566778899aabbccddeeff",
+          std::string(backend) + " AES-256 FIPS-197 C.3 복호화");
+}
+
+// ---- AES-256-GCM (McGrew/Viega GCM 명세 Test Case 13-16) ----
+struct GcmVector
+{
+    const char *name;
+    const char *key;
+    const char *iv;
+    const char *aad;
+    const char *plain;
+    const char *cipher;
+    const char *tag;
+};
+
+static const GcmVector GCM_VECTORS[] = {
+    {"GCM Test Case 13",
+     "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000",
+     "", "", "", "530f8afbc74536b9a963b4f1c4cb738b"},
+    {"GCM Test Case 14",
+     "0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000",
+     "", "00000000000000000000000000000000", "cea7403d4d606b6e074ec5d3baf39d18",
+     "d0d1c8a799996bf0265b98b5d48ab919"},
+    {"GCM Test Case 15",
+     "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "",
+     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+     "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+     "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+     "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+     "b094dac5d93471bdec1a502270e3cc6c"},
+    {"GCM Test Case 16",
+     "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+     "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+     "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+     "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+     "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+     "76fc6ece0f4e1768cddf8853bb2d551b"},
+};
+
+template <typename Backend>
+void testGcm(const char *backend)
+{
+    for (const GcmVector &v : GCM_VECTORS)
+    {
+        std::vector<unsigned char> key = hex(v.key), iv = hex(v.iv), aad = hex(v.aad);
+        std::vector<unsigned char> plain = hex(v.plain), cipher = hex(v.cipher);
+        std::vector<unsigned char> out(plain.size() + 1);
+        unsigned char tag[16];
+
+        bool ok = Backend::gcm(true, key.data(), iv.data(), aad.data(), aad.size(),
+                               plain.data(), plain.size(), out.data(), tag);
+        check(ok && toHex(out.data(), plain.size()) == v.cipher && toHex(tag, 16) == v.tag,
+              std::string(backend) + " " + v.name + " 암호화");
+
+        ok = Backend::gcm(false, key.data(), iv.data(), aad.data(), aad.size(),
+                          cipher.data(), cipher.size(), out.data(), tag);
+        check(ok && toHex(out.data(), cipher.size()) == v.plain,
+              std::string(backend) + " " + v.name + " 복호화");
+
+        tag[0] ^= 0x01;
+        ok = Backend::gcm(false, key.data(), iv.data(), aad.data(), aad.size(),
+                          cipher.data(), cipher.size(), out.data(), tag);
+        check(!ok, std::string(backend) + " " + v.name + " 변조된 tag 거부");
+    }
+}
+
+// ---- P-256 ECDH (NIST CAVP KAS ECC CDH primitive, P-256 COUNT = 0) ----
+template <typename Backend>
+void testEcdh(const char *backend)
+{
+    std::vector<unsigned char> peer = hex("04"
+                                          "700c48f77f56584c5cc632ca65640db91b6bacce3a4df6b42ce7cc838833d287"
+                                          "db71e509e3fd9b060ddb20ba5c51dcc5948d46fbf640dfe0441782cab85fa4ac");
+    std::vector<unsigned char> priv = hex("7d7dc5f71eb29ddaf80d6214632eeae03d9058af1fb6d22ed80badb62bc1a534");
+
+    unsigned char pub[65];
+    check(Backend::derivePublicKey(priv.data(), pub) &&
+              toHex(pub, 65) == "04"
+                                "ead218590119e8876b29146ff89ca61770c4edbbf97d38ce385ed281d8a6b230"
+                                "28af61281fd35e2fa7002523acc85a429cb06ee6648325389f59edfce1405141",
+          std::string(backend) + " P-256 CAVP CDH 공개키 파생");
+
+    unsigned char secret[32];
+    check(Backend::ecdh(priv.data(), peer.data(), secret) &&
+              toHex(secret, 32) == "46fc62106420ff012e54a434fbdd2d25ccc5852060561e68040dd7778997bd7b",
+          std::string(backend) + " P-256 CAVP CDH 공유 비밀");
+
+    // 곡선 위에 없는 상대 공개키 (y 마지막 비트 변경)
+    peer[64] ^= 0x01;
+    check(!Backend::ecdh(priv.data(), peer.data(), secret), std::string(backend) + " ECDH 곡선 밖의 점 거부");
+}
+
+// ---- ECDSA P-256/SHA-256 검증 (RFC 6979 A.2.5, 메시지 "sample", "test") ----
+template <typename Backend>
+void testEcdsaVerify(const char *backend)
+{
+    std::vector<unsigned char> pub = hex("04"
+                                         "60fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6"
+                                         "7903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299");
+    std::vector<unsigned char> priv = hex("c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721");
+
+    unsigned char derived[65];
+    check(Backend::derivePublicKey(priv.data(), derived) && std::memcmp(derived, pub.data(), 65) == 0,
+          std::string(backend) + " RFC 6979 공개키 파생");
+
+    struct
+    {
+        const char *message;
+        const char *sig;
+    } vectors[] = {
+        {"sample", "efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716"
+                   "f7cb1c942d657c41d436c7a1b6e29f65f3e900dbb9aff4064dc4ab2f843acda8"},
+        {"test", "f1abb023518351cd71d881567b1ea663ed3efcf6c5132b354f28d3b0b7d38367"
+                 "019f4113742a2b14bd25926b49c649155f267e60d3814b4c0cc84250e46f0083"},
+    };
+
+    for (const auto &v : vectors)
+    {
+        unsigned char hash[32];
+        Backend::sha256(reinterpret_cast<const unsigned char *>(v.message), std::strlen(v.message), hash);
+        std::vector<unsigned char> sig = hex(v.sig);
+        std::string name = std::string(backend) + " ECDSA 검증 \"" + v.message + "\"";
+
+        check(Backend::verify(pub.data(), hash, sig.data()), name);
+
+        std::vector<unsigned char> bad = sig;
+        bad[63] ^= 0x01;
+        check(!Backend::verify(pub.data(), hash, bad.data()), name + " 변조된 s 거부");
+
+        hash[0] ^= 0x01;
+        check(!Backend::verify(pub.data(), hash, sig.data()), name + " 다른 메시지 거부");
+    }
+
+    // r = 0, s = n 은 범위 밖
+    unsigned char hash[32] = {0};
+    std::vector<unsigned char> zeroR = hex(std::string(64, '0') + "01" + std::string(62, '0'));
+    check(!Backend::verify(pub.data(), hash, zeroR.data()), std::string(backend) + " ECDSA r = 0 거부");
+    std::vector<unsigned char> orderS = hex("01" + std::string(62, '0') +
+                                            "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551");
+    check(!Backend::verify(pub.data(), hash, orderS.data()), std::string(backend) + " ECDSA s = n 거부");
+}
+
+// ---- 압축 공개키 복원 경계 조건 ----
+template <typename Backend>
+void testDecompression(const char *backend)
+{
+    const std::string gx = "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296";
+    const std::string gy = "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5";
+    const std::string negGy = "b01cbd1c01e58065711814b583f061e9d431cca994cea1313449bf97c840ae0a";
+    const std::string p = "ffffffff00000001000000000000000000000000ffffffffffffffffffffffff";
+    std::string name = std::string(backend) + " 공개키 복원 ";
+    unsigned char out[65];
+
+    // 생성점 G (y 홀수 -> 0x03), -G (y 짝수 -> 0x02)
+    std::vector<unsigned char> in = hex("03" + gx);
+    check(Backend::parsePublicKey(in.data(), in.size(), out) && toHex(out, 65) == "04" + gx + gy, name + "G");
+    in = hex("02" + gx);
+    check(Backend::parsePublicKey(in.data(), in.size(), out) && toHex(out, 65) == "04" + gx + negGy, name + "-G");
+
+    // x = p, x > p
+    in = hex("02" + p);
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "x = p 거부");
+    in = hex("03" + std::string(64, 'f'));
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "x > p 거부");
+
+    // 잘못된 prefix/길이, 무한원점
+    in = hex("04" + gx);
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "33바이트 0x04 거부");
+    in = hex("05" + gx);
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "prefix 0x05 거부");
+    in = hex("00");
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "무한원점 거부");
+    in = hex("02" + gx + gy);
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "65바이트 0x02 거부");
+
+    // 비압축: y = p + y 형태(범위 밖), 곡선 밖
+    in = hex("04" + gx + p);
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "비압축 y = p 거부");
+    in = hex("04" + gx + negGy);
+    in[64] ^= 0x02;
+    check(!Backend::parsePublicKey(in.data(), in.size(), out), name + "비압축 곡선 밖 거부");
+}
+
+// ---- OpenSSL 백엔드와 교차 검증 ----
+void crossCheck()
+{
+    const int ROUNDS = 32;
+    bool pubOk = true, signOk = true, ecdhOk = true, decompressOk = true, gcmOk = true, cipherOk = true;
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        unsigned char privA[32], privB[32], pubA[65], pubB[65], pubCheck[65];
+        OpenSSLCrypto::generatePrivateKey(privA);
+        CompactCrypto::generatePrivateKey(privB);
+
+        // 공개키 파생
+        pubOk &= CompactCrypto::derivePublicKey(privA, pubA) && OpenSSLCrypto::derivePublicKey(privA, pubCheck) &&
+                 std::memcmp(pubA, pubCheck, 65) == 0;
+        pubOk &= OpenSSLCrypto::derivePublicKey(privB, pubB) && CompactCrypto::derivePublicKey(privB, pubCheck) &&
+                 std::memcmp(pubB, pubCheck, 65) == 0;
+
+        // 서명: 한쪽에서 만든 서명을 다른 쪽에서 검증
+        unsigned char hash[32], sig[64];
+        CompactCrypto::randomBytes(hash, sizeof(hash));
+        signOk &= CompactCrypto::sign(privA, hash, sig) && OpenSSLCrypto::verify(pubA, hash, sig);
+        signOk &= OpenSSLCrypto::sign(privB, hash, sig) && CompactCrypto::verify(pubB, hash, sig);
+
+        // ECDH
+        unsigned char s1[32], s2[32];
+        ecdhOk &= CompactCrypto::ecdh(privA, pubB, s1) && OpenSSLCrypto::ecdh(privB, pubA, s2) &&
+                  std::memcmp(s1, s2, 32) == 0;
+
+        // 압축 공개키 복원: 임의 x에 대해 수락 여부와 결과가 같아야 함
+        unsigned char compressed[33], c1[65], c2[65];
+        CompactCrypto::randomBytes(compressed, sizeof(compressed));
+        compressed[0] = 0x02 | (compressed[0] & 1);
+        bool a = CompactCrypto::parsePublicKey(compressed, 33, c1);
+        bool b = OpenSSLCrypto::parsePublicKey(compressed, 33, c2);
+        decompressOk &= a == b && (!a || std::memcmp(c1, c2, 65) == 0);
+        compressed[0] = pubA[64] & 1 ? 0x03 : 0x02;
+        std::memcpy(compressed + 1, pubA + 1, 32);
+        decompressOk &= CompactCrypto::parsePublicKey(compressed, 33, c1) && std::memcmp(c1, pubA, 65) == 0;
+
+        // GCM / CBC / CTR: 임의 길이 입력
+        unsigned char key[32], nonce[16];
+        CompactCrypto::randomBytes(key, sizeof(key));
+        CompactCrypto::randomBytes(nonce, sizeof(nonce));
+        std::vector<unsigned char> plain(round * 37 + 1), aad(round * 3);
+        CompactCrypto::randomBytes(plain.data(), plain.size());
+        CompactCrypto::randomBytes(aad.data(), aad.size());
+
+        std::vector<unsigned char> o1(plain.size() + 32), o2(plain.size() + 32);
+        unsigned char t1[16], t2[16];
+        gcmOk &= CompactCrypto::gcm(true, key, nonce, aad.data(), aad.size(), plain.data(), plain.size(),
+                                    o1.data(), t1) &&
+                 OpenSSLCrypto::gcm(true, key, nonce, aad.data(), aad.size(), plain.data(), plain.size(),
+                                    o2.data(), t2) &&
+                 std::memcmp(o1.data(), o2.data(), plain.size()) == 0 && std::memcmp(t1, t2, 16) == 0;
+
+        for (auto mode : {CompactCrypto::Cipher::CBC, CompactCrypto::Cipher::CTR})
+        {
+            CompactCrypto::Cipher compact;
+            OpenSSLCrypto::Cipher openssl;
+            auto opensslMode = mode == CompactCrypto::Cipher::CBC ? OpenSSLCrypto::Cipher::CBC
+                                                                  : OpenSSLCrypto::Cipher::CTR;
+            size_t n1 = 0, f1 = 0, n2 = 0, f2 = 0;
+            cipherOk &= compact.init(mode, true, key, nonce) && openssl.init(opensslMode, true, key, nonce) &&
+                        compact.update(plain.data(), plain.size(), o1.data(), n1) &&
+                        compact.finish(o1.data() + n1, f1) &&
+                        openssl.update(plain.data(), plain.size(), o2.data(), n2) &&
+                        openssl.finish(o2.data() + n2, f2) &&
+                        n1 + f1 == n2 + f2 && std::memcmp(o1.data(), o2.data(), n1 + f1) == 0;
+        }
+    }
+
+    check(pubOk, "교차 검증: 공개키 파생");
+    check(signOk, "교차 검증: 서명 생성/검증");
+    check(ecdhOk, "교차 검증: ECDH");
+    check(decompressOk, "교차 검증: 압축 공개키 복원");
+    check(gcmOk, "교차 검증: AES-256-GCM");
+    check(cipherOk, "교차 검증: AES-256-CBC/CTR");
+}
+
+// ---- 소형 백엔드로 빌드한 MatterTunnel과 OpenSSL 백엔드 사이의 상호 운용 ----
+void tunnelInterop()
+{
+    std::string priv = MatterTunnel::generatePrivateKey();
+    std::vector<unsigned char> privBytes = hex(priv);
+    std::vector<unsigned char> pub = hex(MatterTunnel::derivePublicKey(priv));
+
+    unsigned char opensslPub[65];
+    check(OpenSSLCrypto::derivePublicKey(privBytes.data(), opensslPub) &&
+              std::memcmp(opensslPub, pub.data(), 65) == 0,
+          "MatterTunnel: 공개키가 OpenSSL과 같음");
+
+    std::string message = "Hello, World!!!!!!!!";
+    std::vector<unsigned char> sig = hex(MatterTunnel::sign(message, priv));
+    unsigned char hash[32];
+    OpenSSLCrypto::sha256(reinterpret_cast<const unsigned char *>(message.data()), message.length(), hash);
+    check(OpenSSLCrypto::verify(pub.data(), hash, sig.data()), "MatterTunnel: 서명을 OpenSSL이 검증");
+
+    unsigned char otherPriv[32], otherPub[65], secret[32];
+    OpenSSLCrypto::generateKeyPair(otherPriv, otherPub);
+    OpenSSLCrypto::ecdh(otherPriv, pub.data(), secret);
+    check(MatterTunnel::getSharedKey(priv, toHex(otherPub, 65)) == toHex(secret, 32),
+          "MatterTunnel: 공유키가 OpenSSL과 같음");
+
+    std::string sharedKey = toHex(secret, 32);
+    std::vector<unsigned char> tx = MatterTunnel::makeTX("setLED", priv, toHex(otherPub, 65), {"1", "true"});
+    std::string json = MatterTunnel::extractTXData(toHex(otherPriv, 32), tx);
+    check(json.find("\"data\":[\"1\",\"true\"]") != std::string::npos, "MatterTunnel: TX 왕복");
+}
+
+int main()
+{
+    std::cout << "KAT" << std::endl;
+    testSha256<CompactCrypto>("compact");
+    testSha256<OpenSSLCrypto>("openssl");
+    testAes256<CompactCrypto>("compact");
+    testAes256<OpenSSLCrypto>("openssl");
+    testGcm<CompactCrypto>("compact");
+    testGcm<OpenSSLCrypto>("openssl");
+    testEcdh<CompactCrypto>("compact");
+    testEcdh<OpenSSLCrypto>("openssl");
+    testEcdsaVerify<CompactCrypto>("compact");
+    testEcdsaVerify<OpenSSLCrypto>("openssl");
+    testDecompression<CompactCrypto>("compact");
+    testDecompression<OpenSSLCrypto>("openssl");
+
+    std::cout << "OpenSSL 교차 검증" << std::endl;
+    crossCheck();
+    tunnelInterop();
+
+    std::cout << (failures == 0 ? "모두 통과" : std::to_string(failures) + "개 실패") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <type_traits>
+#include "./matter_tunnel.cpp"
+
+// 컴파일 타임 함수 시그니처
+//
+//   C++20:  using SetLED = Fn<"setLED", void(double, bool)>;
+//   C++17:  struct SetLEDName { static constexpr const char *value = "setLED"; };
+//           using SetLED = TypedFunction<SetLEDName, void(double, bool)>;
+//
+//   auto tx = SetLED::makeTX(srcPriv, destPub, 1.5, true);
+//   auto call = SetLED::decode(destPriv, tx);   // std::get<0>(call.args) == 1.5
+//
+// 타입 코드(인자 2비트 * 7 + 반환 2비트)와 디바이스 데이터의 20바이트 항목은 constexpr로 계산된다.
+// 전송 형식은 기존과 같은 문자열 목록이며(JS 송수신측 호환), 인자를 직렬화 버퍼에 바로 쓰고
+// 복호화된 버퍼에서 바로 읽으므로 std::vector<std::string>을 거치지 않는다.
+
+// 직렬화 항목 하나: 길이(1바이트) + 데이터
+inline bool appendField(std::vector<unsigned char> &out, std::string_view text)
+{
+    if (text.length() > 255)
+    {
+        return false;
+    }
+    out.push_back(static_cast<unsigned char>(text.length()));
+    out.insert(out.end(), text.begin(), text.end());
+    return true;
+}
+
+// C++ 타입 -> ValueType 및 인자 하나의 인코딩/디코딩
+template <typename T, typename = void>
+struct ValueTraits;
+
+template <>
+struct ValueTraits<void>
+{
+    static constexpr ValueType type = ValueType::Void;
+};
+
+template <>
+struct ValueTraits<bool>
+{
+    static constexpr ValueType type = ValueType::Boolean;
+
+    static bool encode(bool value, std::vector<unsigned char> &out)
+    {
+        return appendField(out, value ? "true" : "false");
+    }
+
+    static bool decode(std::string_view field, bool &value) noexcept
+    {
+        value = field == "true";
+        return value || field == "false";
+    }
+};
+
+template <>
+struct ValueTraits<std::string>
+{
+    static constexpr ValueType type = ValueType::String;
+
+    static bool encode(const std::string &value, std::vector<unsigned char> &out)
+    {
+        return appendField(out, value);
+    }
+
+    static bool decode(std::string_view field, std::string &value)
+    {
+        value.assign(field.data(), field.length());
+        return true;
+    }
+};
+
+// number: 정수와 부동소수점 모두 JS number 문자열로
+template <typename T>
+struct ValueTraits<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+{
+    static constexpr ValueType type = ValueType::Number;
+
+    static bool encode(T value, std::vector<unsigned char> &out)
+    {
+        char buffer[32];
+        size_t length = 0;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (std::isnan(value))
+                return appendField(out, "NaN");
+            if (std::isinf(value))
+                return appendField(out, value > 0 ? "Infinity" : "-Infinity");
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+            length = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(value)).ptr - buffer;
+#else
+            length = std::snprintf(buffer, sizeof(buffer), "%.17g", static_cast<double>(value));
+#endif
+        }
+        else
+        {
+            length = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr - buffer;
+        }
+        return appendField(out, std::string_view(buffer, length));
+    }
+
+    // 정수 타입은 값이 정수이고 범위 안일 때만
+    static bool decode(std::string_view field, T &value) noexcept
+    {
+        double number;
+        if (field == "NaN")
+            number = std::numeric_limits<double>::quiet_NaN();
+        else if (field == "Infinity" || field == "-Infinity")
+            number = field[0] == '-' ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        else if (!parseNumber(field, number))
+            return false;
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            value = static_cast<T>(number);
+            return true;
+        }
+        else
+        {
+            // max()는 64비트에서 double로 올림되므로(2^63, 2^64) 상한은 2^digits 미만으로 비교
+            if (!(number >= static_cast<double>(std::numeric_limits<T>::lowest()) &&
+                  number < std::ldexp(1.0, std::numeric_limits<T>::digits)) ||
+                std::trunc(number) != number)
+            {
+                return false;
+            }
+            value = static_cast<T>(number);
+            return true;
+        }
+    }
+
+    static bool parseNumber(std::string_view field, double &number) noexcept
+    {
+        if (!valueMatchesType(ValueType::Number, field))
+        {
+            return false;
+        }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::from_chars(field.data(), field.data() + field.length(), number).ec == std::errc();
+#else
+        char buffer[256];
+        std::memcpy(buffer, field.data(), field.length());
+        buffer[field.length()] = '\0';
+        number = std::strtod(buffer, nullptr);
+        return true;
+#endif
+    }
+};
+
+template <typename Name, typename Signature>
+struct TypedFunction;
+
+template <typename Name, typename R, typename... A>
+struct TypedFunction<Name, R(A...)>
+{
+    static_assert(sizeof...(A) <= 7, "Too many arguments (max 7)");
+    static_assert(((ValueTraits<std::decay_t<A>>::type != ValueType::Void) && ...), "void argument");
+
+    using Args = std::tuple<std::decay_t<A>...>;
+    using Result = R;
+
+    static constexpr size_t argCount = sizeof...(A);
+
+    static constexpr size_t nameLength()
+    {
+        size_t length = 0;
+        while (Name::value[length] != '\0')
+        {
+            length++;
+        }
+        return length;
+    }
+    static_assert(nameLength() >= 1 && nameLength() <= 18, "Function name must be 1-18 characters");
+
+    // 인자는 상위 비트부터 2비트씩, 반환은 하위 2비트
+    static constexpr uint16_t typeCode = [] {
+        constexpr ValueType args[] = {ValueTraits<std::decay_t<A>>::type..., ValueType::Void};
+        uint16_t code = static_cast<uint16_t>(ValueTraits<std::decay_t<R>>::type);
+        for (size_t i = 0; i < argCount; i++)
+        {
+            code |= static_cast<uint16_t>(args[i]) << (14 - i * 2);
+        }
+        return code;
+    }();
+
+    // TX의 funcName 필드 (0 패딩 18바이트)
+    static constexpr std::array<char, 18> funcName = [] {
+        std::array<char, 18> name{};
+        for (size_t i = 0; i < nameLength(); i++)
+        {
+            name[i] = Name::value[i];
+        }
+        return name;
+    }();
+
+    // 디바이스 데이터의 function 항목 (이름 18바이트 + 타입 2바이트, big-endian)
+    static constexpr std::array<unsigned char, 20> functionData = [] {
+        std::array<unsigned char, 20> data{};
+        for (size_t i = 0; i < 18; i++)
+        {
+            data[i] = static_cast<unsigned char>(funcName[i]);
+        }
+        data[18] = static_cast<unsigned char>(typeCode >> 8);
+        data[19] = static_cast<unsigned char>(typeCode & 0xFF);
+        return data;
+    }();
+
+    static std::string name() { return std::string(Name::value, nameLength()); }
+
+    // 디바이스가 같은 이름과 타입으로 이 함수를 선언했는지
+    static bool matches(const DeviceFunction &function) noexcept
+    {
+        constexpr ValueType args[] = {ValueTraits<std::decay_t<A>>::type..., ValueType::Void};
+        if (function.name.length() != nameLength() ||
+            std::memcmp(function.name.data(), Name::value, nameLength()) != 0 ||
+            function.returnType != ValueTraits<std::decay_t<R>>::type || function.argCount() != argCount)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < argCount; i++)
+        {
+            if (function.argTypes[i] != args[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 디코딩된 호출
+    struct Call
+    {
+        Args args;
+        unsigned char srcPub[65]; // uncompressed
+        uint64_t timestamp;
+    };
+
+    static std::vector<unsigned char> makeTX(const std::string &src_priv, const std::string &dest_pub,
+                                             const std::decay_t<A> &...args)
+    {
+        return tryMakeTX(src_priv, dest_pub, args...).unwrap();
+    }
+
+    static MatterResult<std::vector<unsigned char>> tryMakeTX(const std::string &src_priv, const std::string &dest_pub,
+                                                              const std::decay_t<A> &...args)
+    {
+        MatterResult<std::string> sharedKey = MatterTunnel::tryGetSharedKey(src_priv, dest_pub);
+        if (!sharedKey)
+        {
+            return sharedKey.error();
+        }
+        return tryBuildTX(sharedKey.value(), src_priv, args...);
+    }
+
+    // 이미 계산한 공유키로 TX 생성 (MatterRpc는 같은 공유키로 응답 키를 파생)
+    static MatterResult<std::vector<unsigned char>> tryBuildTX(const std::string &sharedKey, const std::string &src_priv,
+                                                               const std::decay_t<A> &...args)
+    {
+        std::vector<unsigned char> serialized;
+        serialized.reserve(argCount * 8);
+        if (!(ValueTraits<std::decay_t<A>>::encode(args, serialized) && ...))
+        {
+            return MatterError::DataItemTooLarge;
+        }
+
+        MatterResult<std::vector<unsigned char>> encrypted =
+            MatterTunnel::tryEncryptBytes(sharedKey, serialized.data(), serialized.size());
+        CryptoBackend::cleanse(serialized.data(), serialized.size());
+        if (!encrypted)
+        {
+            return encrypted.error();
+        }
+        return MatterTunnel::tryAssembleTX(name(), src_priv, MatterTunnel::TX_FORMAT_LEGACY, encrypted.value());
+    }
+
+    static Call decode(const std::string &privateKey, const std::vector<unsigned char> &txBytes)
+    {
+        return tryDecode(privateKey, txBytes.data(), txBytes.size()).unwrap();
+    }
+
+    static MatterResult<Call> tryDecode(const std::string &privateKey, const std::vector<unsigned char> &txBytes)
+    {
+        return tryDecode(privateKey, txBytes.data(), txBytes.size());
+    }
+
+    // 다른 funcName은 UnknownFunction, 인자 개수/형식이 다르면 InvalidArguments
+    static MatterResult<Call> tryDecode(const std::string &privateKey, const unsigned char *txBytes,
+                                        size_t txLen)
+    {
+        MatterTunnel::TXFields fields;
+        MatterError error = MatterTunnel::openTXFields(privateKey, txBytes, txLen, funcName.data(), argCount, fields);
+        if (error != MatterError::Ok)
+        {
+            return error;
+        }
+
+        Call call;
+        if (!decodeFields(fields.fields, call.args))
+        {
+            return MatterError::InvalidArguments;
+        }
+        std::memcpy(call.srcPub, fields.header.srcPubBytes, 65);
+        call.timestamp = fields.header.timestamp;
+        return call;
+    }
+
+    // 복호화된 필드(인자 수만큼)를 타입별로 변환
+    static bool decodeFields(const std::vector<std::string_view> &fields, Args &args)
+    {
+        return fields.size() == argCount && decodeArgs(fields, args, std::index_sequence_for<A...>{});
+    }
+
+private:
+    template <size_t... I>
+    static bool decodeArgs(const std::vector<std::string_view> &fields, Args &args, std::index_sequence<I...>)
+    {
+        return (ValueTraits<std::tuple_element_t<I, Args>>::decode(fields[I], std::get<I>(args)) && ...);
+    }
+};
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// 문자열 리터럴 템플릿 인자 (C++20)
+template <size_t N>
+struct FnName
+{
+    char value[N];
+
+    constexpr FnName(const char (&name)[N])
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            value[i] = name[i];
+        }
+    }
+};
+
+template <FnName Name>
+struct FnNameTag
+{
+    static constexpr const char *value = Name.value;
+};
+
+template <FnName Name, typename Signature>
+struct Fn : TypedFunction<FnNameTag<Name>, Signature>
+{
+};
+#endif
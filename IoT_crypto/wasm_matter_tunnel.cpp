@@ -1,3 +1,4 @@
+#include <emscripten.h>
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include <string>
@@ -6,21 +7,142 @@
 #include <iomanip>
 #include <iostream>
 #include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include "./matter_tunnel.cpp"
+#include "./matter_stream.cpp"
 
 using namespace emscripten;
 
-// JavaScript에 전달할 수 있는 형태로 vector<uint8_t>를 변환
-val uint8ArrayToJS(const std::vector<unsigned char>& data) {
-    return val(typed_memory_view(data.size(), data.data()));
+// WASM 힙에 상주하는 재사용 버퍼
+// JS에는 이 버퍼를 가리키는 Uint8Array 뷰만 넘긴다 (복사 없음).
+// 뷰는 같은 버퍼를 다시 쓰는 다음 호출 전까지만 유효하며, 보관하려면 JS에서 slice()로 복사해야 한다.
+// WASM 메모리가 늘어나면(ALLOW_MEMORY_GROWTH) 기존 뷰는 분리되므로 호출마다 새 뷰를 받아 써야 한다.
+class WasmBuffer {
+public:
+    // length 크기로 맞춘 뒤 뷰 반환 (용량 이하로 줄이는 것은 재할당 없음)
+    val view(size_t length) {
+        data_.resize(length);
+        return val(typed_memory_view(data_.size(), data_.data()));
+    }
+
+    val view() const {
+        return val(typed_memory_view(data_.size(), data_.data()));
+    }
+
+    // 결과 벡터를 복사 없이 버퍼로 넘겨받음
+    val adopt(std::vector<unsigned char>&& data) {
+        data_.swap(data);
+        return view();
+    }
+
+    const std::vector<unsigned char>& data() const { return data_; }
+
+private:
+    std::vector<unsigned char> data_;
+};
+
+// 입력 버퍼: JS가 inputBuffer(length)로 받은 뷰에 직접 쓴 뒤 *FromInput 함수 호출
+static WasmBuffer inputArena;
+// 결과 버퍼: makeTX 등 바이트 결과를 담음
+static WasmBuffer resultArena;
+// 디코딩 버퍼: *Object 함수가 반환하는 객체의 Uint8Array 필드가 가리킴
+static WasmBuffer decodeArena;
+
+// 디코딩된 TX를 JS 객체로 변환
+// { funcName, srcPub: Uint8Array(65), timeStamp: number, data: Uint8Array[] }
+static val txRecordToJS(const MatterTunnel::TXRecord& record) {
+    std::vector<std::string> items = record.items();
+
+    // 공개키와 항목들을 decodeArena 하나에 연속 배치
+    size_t total = 65;
+    for (const auto& item : items) {
+        total += item.length();
+    }
+    std::vector<unsigned char> buffer;
+    buffer.reserve(total);
+    buffer.insert(buffer.end(), record.srcPubBytes(), record.srcPubBytes() + 65);
+    for (const auto& item : items) {
+        buffer.insert(buffer.end(), item.begin(), item.end());
+    }
+    decodeArena.adopt(std::move(buffer));
+    const unsigned char* base = decodeArena.data().data();
+
+    val obj = val::object();
+    obj.set("funcName", record.funcName());
+    obj.set("srcPub", val(typed_memory_view(65, base)));
+    obj.set("timeStamp", static_cast<double>(record.timestamp()));
+
+    val data = val::array();
+    size_t offset = 65;
+    for (size_t i = 0; i < items.size(); i++) {
+        data.set(i, val(typed_memory_view(items[i].length(), base + offset)));
+        offset += items[i].length();
+    }
+    obj.set("data", data);
+    return obj;
 }
 
-// JavaScript Uint8Array를 C++ vector<uint8_t>로 변환
-std::vector<unsigned char> jsArrayToVector(const val& array) {
+// 디바이스 정보를 JS 객체로 변환
+// { publicKey: Uint8Array(65), passcode: Uint8Array(16),
+//   functions: [{ name, argTypes: string[], returnType, types: number }] }
+static val deviceInfoToJS(const unsigned char* data, size_t length) {
+    DeviceInfo info = DeviceInfo::tryParse(data, length).unwrap();
+
+    std::vector<unsigned char> buffer(65 + 16);
+    std::copy(info.publicKey, info.publicKey + 65, buffer.begin());
+    std::copy(info.passcode, info.passcode + 16, buffer.begin() + 65);
+    decodeArena.adopt(std::move(buffer));
+    const unsigned char* base = decodeArena.data().data();
+
+    val obj = val::object();
+    obj.set("publicKey", val(typed_memory_view(65, base)));
+    obj.set("passcode", val(typed_memory_view(16, base + 65)));
+
+    val functions = val::array();
+    for (size_t i = 0; i < info.functions.size(); i++) {
+        const DeviceFunction& function = info.functions[i];
+
+        val argTypes = val::array();
+        for (size_t j = 0; j < function.argCount(); j++) {
+            argTypes.set(j, val(valueTypeName(function.argTypes[j])));
+        }
+
+        // types: 디바이스 데이터에 기록된 원본 비트 (20바이트 항목의 마지막 2바이트)
+        const unsigned char* entry = data + 49 + i * 20;
+        uint16_t types = (entry[18] << 8) | entry[19];
+
+        val fn = val::object();
+        fn.set("name", function.name);
+        fn.set("argTypes", argTypes);
+        fn.set("returnType", val(valueTypeName(function.returnType)));
+        fn.set("types", types);
+        functions.set(i, fn);
+    }
+    obj.set("functions", functions);
+    return obj;
+}
+
+// JavaScript에 전달할 수 있는 형태로 vector<uint8_t>를 변환 (resultArena가 소유)
+val uint8ArrayToJS(std::vector<unsigned char>&& data) {
+    return resultArena.adopt(std::move(data));
+}
+
+// JavaScript Uint8Array를 기존 vector에 복사 (용량 재사용)
+void jsArrayInto(const val& array, std::vector<unsigned char>& out) {
     const auto length = array["length"].as<unsigned>();
-    std::vector<unsigned char> result(length);
-    val memoryView = val::global("Uint8Array").new_(typed_memory_view(length, result.data()));
+    out.resize(length);
+    val memoryView = val::global("Uint8Array").new_(typed_memory_view(length, out.data()));
     memoryView.call<void>("set", array);
+}
+
+// JavaScript Uint8Array를 C++ vector<uint8_t>로 변환
+// 의도된 복사 1회 (JS 힙 -> WASM 힙). 반복 호출 시에는 inputBuffer를 사용할 것
+std::vector<unsigned char> jsArrayToVector(const val& array) {
+    std::vector<unsigned char> result;
+    jsArrayInto(array, result);
     return result;
 }
 
@@ -44,6 +166,15 @@ public:
         return MatterTunnel::generatePrivateKey();
     }
 
+    // 키 쌍 생성 ({ privateKey, publicKey } 16진수)
+    static val generateKeyPair() {
+        MatterTunnel::KeyPair pair = MatterTunnel::generateKeyPair();
+        val obj = val::object();
+        obj.set("privateKey", pair.privateKey);
+        obj.set("publicKey", pair.publicKey);
+        return obj;
+    }
+
     // 공개키 파생
     static std::string derivePublicKey(const std::string& privateKey) {
         return MatterTunnel::derivePublicKey(privateKey);
@@ -87,7 +218,7 @@ public:
                      const val& dataList) {
         std::vector<std::string> vecDataList = jsStringArrayToVector(dataList);
         std::vector<unsigned char> result = MatterTunnel::makeTX(funcName, srcPriv, destPub, vecDataList);
-        return uint8ArrayToJS(result);
+        return uint8ArrayToJS(std::move(result));
     }
 
     // TX 데이터 추출 (Uint8Array를 입력으로 받음)
@@ -95,12 +226,349 @@ public:
         std::vector<unsigned char> vecTxData = jsArrayToVector(txData);
         return MatterTunnel::extractTXData(privateKey, vecTxData);
     }
+
+    // 입력 버퍼 뷰 (length 바이트). JS는 여기에 직접 쓴 뒤 *FromInput 함수를 호출
+    static val inputBuffer(size_t length) {
+        return inputArena.view(length);
+    }
+
+    // 입력 버퍼의 TX 데이터 추출 (복사 없음)
+    static std::string extractTXDataFromInput(const std::string& privateKey) {
+        return MatterTunnel::extractTXData(privateKey, inputArena.data());
+    }
+
+    // 입력 버퍼의 디바이스 정보 추출 (복사 없음)
+    static std::string extractDeviceInfoFromInput() {
+        return MatterTunnel::extractDeviceInfo(inputArena.data());
+    }
+
+    // JSON 대신 JS 객체로 반환하는 디코딩 함수들
+    // Uint8Array 필드는 다음 *Object 호출 전까지 유효한 WASM 힙 뷰
+    static val extractTXDataObject(const std::string& privateKey, const val& txData) {
+        std::vector<unsigned char> vecTxData = jsArrayToVector(txData);
+        return txRecordToJS(MatterTunnel::openTX(privateKey, vecTxData));
+    }
+
+    static val extractTXDataObjectFromInput(const std::string& privateKey) {
+        return txRecordToJS(MatterTunnel::openTX(privateKey, inputArena.data()));
+    }
+
+    static val extractDeviceInfoObject(const val& data) {
+        std::vector<unsigned char> vecData = jsArrayToVector(data);
+        return deviceInfoToJS(vecData.data(), vecData.size());
+    }
+
+    static val extractDeviceInfoObjectFromInput() {
+        return deviceInfoToJS(inputArena.data().data(), inputArena.data().size());
+    }
+
+    // 배치 서명 검증 (Array<boolean> 반환)
+    // pthreads 빌드에서는 워커 풀에서 병렬로 처리됨
+    static val verifyBatch(const val& signatures, const val& messages, const val& publicKeys) {
+        std::vector<bool> valid = MatterTunnel::verifyBatch(jsStringArrayToVector(signatures),
+                                                            jsStringArrayToVector(messages),
+                                                            jsStringArrayToVector(publicKeys));
+        val result = val::array();
+        for (size_t i = 0; i < valid.size(); ++i) {
+            result.set(i, static_cast<bool>(valid[i]));
+        }
+        return result;
+    }
+
+    // 배치 TX 디코딩 (Array<Uint8Array> -> Array<string>, 실패 항목은 {"error":...} JSON)
+    static val extractTXDataBatch(const std::string& privateKey, const val& txs) {
+        const auto length = txs["length"].as<unsigned>();
+        std::vector<std::vector<unsigned char>> vecTxs;
+        vecTxs.reserve(length);
+        for (unsigned i = 0; i < length; ++i) {
+            vecTxs.push_back(jsArrayToVector(txs[i]));
+        }
+
+        std::vector<std::string> decoded = MatterTunnel::extractTXDataBatch(privateKey, vecTxs);
+        val result = val::array();
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            result.set(i, decoded[i]);
+        }
+        return result;
+    }
+
+    // 수신 TX 타임스탬프 허용 범위 (초, 0이면 제한 없음)
+    static void setTimestampWindow(double maxPastSeconds, double maxFutureSeconds) {
+        MatterTunnel::setTimestampWindow(static_cast<uint64_t>(maxPastSeconds),
+                                         static_cast<uint64_t>(maxFutureSeconds));
+    }
+
+    // 사전 검사 카운터 { accepted, rejected, rejectedSize, rejectedFormat, ... }
+    static val precheckStats() {
+        MatterTunnel::PrecheckStats stats = MatterTunnel::precheckStats();
+        val obj = val::object();
+        obj.set("accepted", static_cast<double>(stats.accepted));
+        obj.set("rejected", static_cast<double>(stats.rejected()));
+        obj.set("rejectedSize", static_cast<double>(stats.rejectedSize));
+        obj.set("rejectedFormat", static_cast<double>(stats.rejectedFormat));
+        obj.set("rejectedFuncName", static_cast<double>(stats.rejectedFuncName));
+        obj.set("rejectedSignature", static_cast<double>(stats.rejectedSignature));
+        obj.set("rejectedPayload", static_cast<double>(stats.rejectedPayload));
+        obj.set("rejectedTimestamp", static_cast<double>(stats.rejectedTimestamp));
+        return obj;
+    }
+
+    static void resetPrecheckStats() {
+        MatterTunnel::resetPrecheckStats();
+    }
+};
+
+// 스트리밍 암호화/복호화 상태 객체 (js/matter_tunnel_streams.mjs의 TransformStream에서 사용)
+// 청크 단위로 처리하므로 WASM 힙에는 청크 하나 크기의 입력/출력 버퍼만 유지된다.
+// 반환된 Uint8Array는 같은 객체의 다음 호출 전까지만 유효하며, 사용이 끝나면 JS에서 delete() 호출.
+class WasmEncryptor {
+public:
+    explicit WasmEncryptor(const std::string& key) : encryptor_(key) {}
+
+    // 청크 암호화 (첫 출력에는 IV 포함)
+    val update(const val& chunk) {
+        jsArrayInto(chunk, input_);
+        output_.clear();
+        encryptor_.update(input_.data(), input_.size(), output_);
+        return val(typed_memory_view(output_.size(), output_.data()));
+    }
+
+    // 마지막 블록 (패딩 포함)
+    val finalize() {
+        output_.clear();
+        encryptor_.finalize(output_);
+        return val(typed_memory_view(output_.size(), output_.data()));
+    }
+
+private:
+    MatterTunnel::Encryptor encryptor_;
+    std::vector<unsigned char> input_;
+    std::vector<unsigned char> output_;
 };
 
+class WasmDecryptor {
+public:
+    explicit WasmDecryptor(const std::string& key) : decryptor_(key) {}
+
+    // 청크 복호화 (encrypt 결과 바이트 또는 Encryptor 출력을 임의 크기로 나눠 입력)
+    val update(const val& chunk) {
+        jsArrayInto(chunk, input_);
+        output_.clear();
+        decryptor_.update(input_.data(), input_.size(), output_);
+        return val(typed_memory_view(output_.size(), output_.data()));
+    }
+
+    // 패딩 검증 및 마지막 평문
+    val finalize() {
+        output_.clear();
+        decryptor_.finalize(output_);
+        return val(typed_memory_view(output_.size(), output_.data()));
+    }
+
+private:
+    MatterTunnel::Decryptor decryptor_;
+    std::vector<unsigned char> input_;
+    std::vector<unsigned char> output_;
+};
+
+// embind를 거치지 않는 raw export (matter_tunnel_raw.js에서 사용)
+// 입력은 WASM 힙 포인터 + 길이, 키는 바이트 형식 (개인키 32, 공유키 32, 공개키 33/65).
+// 가변 길이 결과는 resultArena에 담고 길이를 반환하며, 포인터는 mt_result()로 얻는다.
+// 반환값이 음수이면 실패 (MT_ERR_*). MatterTunnel의 바이트 입력 API를 사용하므로 키/서명의 16진수 변환이 없다.
+enum : int {
+    MT_ERR_INVALID_ARGUMENT = -1,
+    MT_ERR_FAILED = -2,
+};
+
+static uint32_t readLE32(const unsigned char* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static void appendLE32(std::vector<unsigned char>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+// 배치 결과를 길이(4바이트 LE) + 데이터의 연속으로 묶음
+static std::vector<unsigned char> packResults(const std::vector<std::string>& results) {
+    size_t total = 0;
+    for (const auto& r : results) {
+        total += 4 + r.length();
+    }
+    std::vector<unsigned char> packed;
+    packed.reserve(total);
+    for (const auto& r : results) {
+        appendLE32(packed, static_cast<uint32_t>(r.length()));
+        packed.insert(packed.end(), r.begin(), r.end());
+    }
+    return packed;
+}
+
+static int setRawResult(std::vector<unsigned char>&& data) {
+    resultArena.adopt(std::move(data));
+    return static_cast<int>(resultArena.data().size());
+}
+
+extern "C" {
+
+EMSCRIPTEN_KEEPALIVE unsigned char* mt_alloc(size_t length) {
+    return static_cast<unsigned char*>(malloc(length));
+}
+
+EMSCRIPTEN_KEEPALIVE void mt_free(unsigned char* ptr) {
+    free(ptr);
+}
+
+EMSCRIPTEN_KEEPALIVE const unsigned char* mt_result() {
+    return resultArena.data().data();
+}
+
+// 서명: sigOut에 r(32) + s(32) 기록
+EMSCRIPTEN_KEEPALIVE int mt_sign(const unsigned char* msg, size_t msgLen,
+                                 const unsigned char* priv, unsigned char* sigOut) {
+    if (MatterTunnel::trySignBytes(msg, msgLen, priv, sigOut) != MatterError::Ok) {
+        return MT_ERR_FAILED;
+    }
+    return 64;
+}
+
+// 서명 검증: 1 유효, 0 무효
+EMSCRIPTEN_KEEPALIVE int mt_verify(const unsigned char* sig, const unsigned char* msg, size_t msgLen,
+                                   const unsigned char* pub, size_t pubLen) {
+    return MatterTunnel::verifyBytes(sig, msg, msgLen, pub, pubLen) ? 1 : 0;
+}
+
+// 암호화: 결과 IV(16) + ciphertext
+EMSCRIPTEN_KEEPALIVE int mt_encrypt(const unsigned char* sharedKey, const unsigned char* msg, size_t msgLen) {
+    MatterResult<std::vector<unsigned char>> encrypted =
+        MatterTunnel::tryEncryptBytes(sharedKey, msg, msgLen);
+    return encrypted ? setRawResult(std::move(encrypted).value()) : MT_ERR_FAILED;
+}
+
+// 복호화: 결과 평문
+EMSCRIPTEN_KEEPALIVE int mt_decrypt(const unsigned char* sharedKey, const unsigned char* encrypted, size_t len) {
+    MatterResult<std::string> plain = MatterTunnel::tryDecryptBytes(sharedKey, encrypted, len);
+    if (!plain) {
+        return MT_ERR_FAILED;
+    }
+    return setRawResult(std::vector<unsigned char>(plain.value().begin(), plain.value().end()));
+}
+
+// TX 생성: dataList는 TX payload와 같은 직렬화 형식 (길이 1바이트 + 데이터)의 연속
+EMSCRIPTEN_KEEPALIVE int mt_makeTX(const char* funcName, size_t funcNameLen,
+                                   const unsigned char* srcPriv,
+                                   const unsigned char* destPub, size_t destPubLen,
+                                   const unsigned char* dataList, size_t dataListLen) {
+    std::vector<std::string> items;
+    size_t pos = 0;
+    while (pos < dataListLen) {
+        size_t length = dataList[pos++];
+        if (pos + length > dataListLen) {
+            return MT_ERR_INVALID_ARGUMENT;
+        }
+        items.emplace_back(reinterpret_cast<const char*>(dataList + pos), length);
+        pos += length;
+    }
+
+    MatterResult<std::vector<unsigned char>> tx =
+        MatterTunnel::tryMakeTX(std::string(funcName, funcNameLen), srcPriv, destPub, destPubLen, items);
+    return tx ? setRawResult(std::move(tx).value()) : MT_ERR_FAILED;
+}
+
+// TX 데이터 추출: 결과 JSON (UTF-8)
+EMSCRIPTEN_KEEPALIVE int mt_extractTXData(const unsigned char* privateKey, const unsigned char* tx, size_t txLen) {
+    MatterResult<std::string> json = MatterTunnel::tryExtractTXData(privateKey, tx, txLen);
+    if (!json) {
+        return MT_ERR_FAILED;
+    }
+    return setRawResult(std::vector<unsigned char>(json.value().begin(), json.value().end()));
+}
+
+// 배치 TX 데이터 추출
+// packed: [길이(4바이트 LE) + TX] x count
+// 결과: [길이(4바이트 LE) + JSON 또는 오류 메시지] x count, statusOut[i]는 0 성공 / MT_ERR_FAILED
+// 반환값은 결과 길이 (입력 형식 오류면 MT_ERR_INVALID_ARGUMENT)
+EMSCRIPTEN_KEEPALIVE int mt_extractTXDataBatch(const unsigned char* privateKey,
+                                               const unsigned char* packed, size_t packedLen,
+                                               size_t count, int32_t* statusOut) {
+    std::vector<std::pair<const unsigned char*, size_t>> txs;
+    txs.reserve(count);
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (pos + 4 > packedLen) {
+            return MT_ERR_INVALID_ARGUMENT;
+        }
+        size_t length = readLE32(packed + pos);
+        pos += 4;
+        if (length > packedLen - pos) {
+            return MT_ERR_INVALID_ARGUMENT;
+        }
+        txs.emplace_back(packed + pos, length);
+        pos += length;
+    }
+    if (pos != packedLen) {
+        return MT_ERR_INVALID_ARGUMENT;
+    }
+
+    std::vector<char> ok;
+    std::vector<std::string> results = MatterTunnel::extractTXDataBatch(privateKey, txs, ok);
+    for (size_t i = 0; i < count; i++) {
+        statusOut[i] = ok[i] ? 0 : MT_ERR_FAILED;
+    }
+    return setRawResult(packResults(results));
+}
+
+// 배치 서명 검증
+// packed: [서명(64) + 공개키 길이(1) + 공개키 + 메시지 길이(4바이트 LE) + 메시지] x count
+// statusOut[i]는 1 유효 / 0 무효, 반환값은 유효한 서명 수 (입력 형식 오류면 MT_ERR_INVALID_ARGUMENT)
+EMSCRIPTEN_KEEPALIVE int mt_verifyBatch(const unsigned char* packed, size_t packedLen,
+                                        size_t count, int32_t* statusOut) {
+    std::vector<MatterTunnel::SignedMessageView> items;
+    items.reserve(count);
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (pos + 65 > packedLen) {
+            return MT_ERR_INVALID_ARGUMENT;
+        }
+        MatterTunnel::SignedMessageView item;
+        item.signature = packed + pos;
+        item.publicKeyLen = packed[pos + 64];
+        pos += 65;
+        if (item.publicKeyLen + 4 > packedLen - pos) {
+            return MT_ERR_INVALID_ARGUMENT;
+        }
+        item.publicKey = packed + pos;
+        pos += item.publicKeyLen;
+        item.messageLen = readLE32(packed + pos);
+        pos += 4;
+        if (item.messageLen > packedLen - pos) {
+            return MT_ERR_INVALID_ARGUMENT;
+        }
+        item.message = packed + pos;
+        pos += item.messageLen;
+        items.push_back(item);
+    }
+    if (pos != packedLen) {
+        return MT_ERR_INVALID_ARGUMENT;
+    }
+
+    std::vector<bool> valid = MatterTunnel::verifyBatch(items);
+    int validCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        statusOut[i] = valid[i] ? 1 : 0;
+        validCount += valid[i];
+    }
+    return validCount;
+}
+
+}
+
 // WASM 바인딩 설정
 EMSCRIPTEN_BINDINGS(matter_tunnel) {
     class_<WasmMatterTunnel>("MatterTunnel")
         .class_function("generatePrivateKey", &WasmMatterTunnel::generatePrivateKey)
+        .class_function("generateKeyPair", &WasmMatterTunnel::generateKeyPair)
         .class_function("derivePublicKey", &WasmMatterTunnel::derivePublicKey)
         .class_function("sign", &WasmMatterTunnel::sign)
         .class_function("verify", &WasmMatterTunnel::verify)
@@ -109,5 +577,27 @@ EMSCRIPTEN_BINDINGS(matter_tunnel) {
         .class_function("decrypt", &WasmMatterTunnel::decrypt)
         .class_function("extractDeviceInfo", &WasmMatterTunnel::extractDeviceInfo)
         .class_function("makeTX", &WasmMatterTunnel::makeTX)
-        .class_function("extractTXData", &WasmMatterTunnel::extractTXData);
+        .class_function("extractTXData", &WasmMatterTunnel::extractTXData)
+        .class_function("inputBuffer", &WasmMatterTunnel::inputBuffer)
+        .class_function("extractTXDataFromInput", &WasmMatterTunnel::extractTXDataFromInput)
+        .class_function("extractDeviceInfoFromInput", &WasmMatterTunnel::extractDeviceInfoFromInput)
+        .class_function("extractTXDataObject", &WasmMatterTunnel::extractTXDataObject)
+        .class_function("extractTXDataObjectFromInput", &WasmMatterTunnel::extractTXDataObjectFromInput)
+        .class_function("extractDeviceInfoObject", &WasmMatterTunnel::extractDeviceInfoObject)
+        .class_function("extractDeviceInfoObjectFromInput", &WasmMatterTunnel::extractDeviceInfoObjectFromInput)
+        .class_function("verifyBatch", &WasmMatterTunnel::verifyBatch)
+        .class_function("extractTXDataBatch", &WasmMatterTunnel::extractTXDataBatch)
+        .class_function("setTimestampWindow", &WasmMatterTunnel::setTimestampWindow)
+        .class_function("precheckStats", &WasmMatterTunnel::precheckStats)
+        .class_function("resetPrecheckStats", &WasmMatterTunnel::resetPrecheckStats);
+
+    class_<WasmEncryptor>("Encryptor")
+        .constructor<std::string>()
+        .function("update", &WasmEncryptor::update)
+        .function("finalize", &WasmEncryptor::finalize);
+
+    class_<WasmDecryptor>("Decryptor")
+        .constructor<std::string>()
+        .function("update", &WasmDecryptor::update)
+        .function("finalize", &WasmDecryptor::finalize);
 }
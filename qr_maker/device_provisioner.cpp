@@ -0,0 +1,279 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include "../IoT_crypto/matter_tunnel.cpp"
+
+// 디바이스 대량 프로비저닝 (qr_maker.py DeviceDataGenerator의 C++ 구현)
+// 디바이스 데이터: compressed pubkey(33) + passcode(16) + function(20) * n
+// function: 이름(18, 0 패딩) + 타입(2, big-endian: 인자 2비트 * 7 (상위부터) + 반환 2비트)
+class DeviceProvisioner
+{
+public:
+    // 생성된 디바이스 한 대
+    struct DeviceRecord
+    {
+        std::vector<unsigned char> deviceData;
+        unsigned char privateKey[32];
+        unsigned char publicKey[65]; // 비압축
+        unsigned char passcode[16];
+    };
+
+    // "setLED(number,boolean) -> void" 형식의 시그니처를 20바이트로 변환
+    static std::vector<unsigned char> functionData(const std::string &signature)
+    {
+        size_t open = signature.find('(');
+        size_t close = signature.find(')', open);
+        size_t arrow = signature.find("->", close);
+        if (open == std::string::npos || close == std::string::npos || arrow == std::string::npos)
+        {
+            throw std::runtime_error("Invalid function signature: " + signature);
+        }
+
+        std::string name = trim(signature.substr(0, open));
+        if (name.empty() || name.length() > 18)
+        {
+            throw std::runtime_error("Invalid function name: " + signature);
+        }
+        for (char c : name)
+        {
+            if (!isWordChar(c))
+            {
+                throw std::runtime_error("Invalid function name: " + signature);
+            }
+        }
+
+        // 인자 타입 (최대 7개)
+        std::vector<uint16_t> args;
+        std::string argList = trim(signature.substr(open + 1, close - open - 1));
+        size_t pos = 0;
+        while (!argList.empty() && pos <= argList.length())
+        {
+            size_t comma = argList.find(',', pos);
+            if (comma == std::string::npos)
+            {
+                comma = argList.length();
+            }
+            uint16_t type = typeCode(trim(argList.substr(pos, comma - pos)));
+            if (type == 0x00)
+            {
+                throw std::runtime_error("Invalid argument type: " + signature);
+            }
+            args.push_back(type);
+            pos = comma + 1;
+        }
+        if (args.size() > 7)
+        {
+            throw std::runtime_error("Too many arguments: " + signature);
+        }
+
+        std::string returnType = trim(signature.substr(arrow + 2));
+        if (returnType != "void" && typeCode(returnType) == 0x00)
+        {
+            throw std::runtime_error("Invalid return type: " + signature);
+        }
+
+        uint16_t types = typeCode(returnType);
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            types |= args[i] << (14 - i * 2);
+        }
+
+        std::vector<unsigned char> data(20, 0);
+        std::memcpy(data.data(), name.data(), name.length());
+        data[18] = static_cast<unsigned char>(types >> 8);
+        data[19] = static_cast<unsigned char>(types & 0xFF);
+        return data;
+    }
+
+    // 매니페스트: 한 줄에 시그니처 하나, 빈 줄과 '#' 주석은 무시
+    static std::vector<std::string> loadManifest(std::istream &in)
+    {
+        std::vector<std::string> functions;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            line = trim(line.substr(0, line.find('#')));
+            if (!line.empty())
+            {
+                functions.push_back(line);
+            }
+        }
+        return functions;
+    }
+
+    static std::vector<std::string> loadManifest(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("Failed to open manifest: " + path);
+        }
+        return loadManifest(in);
+    }
+
+    explicit DeviceProvisioner(const std::vector<std::string> &functions, unsigned threads = 0)
+        : threads_(threads)
+    {
+        for (const auto &function : functions)
+        {
+            std::vector<unsigned char> data = functionData(function);
+            functionBlock_.insert(functionBlock_.end(), data.begin(), data.end());
+        }
+    }
+
+    size_t deviceDataSize() const { return 33 + 16 + functionBlock_.size(); }
+
+    // count대를 batchSize 단위로 생성해 sink(records)로 넘김
+    // 키 쌍은 배치마다 여러 스레드에서 생성하고, 넘긴 뒤에는 배치 버퍼의 개인키를 지운다.
+    template <typename Sink>
+    void generate(size_t count, Sink &&sink, size_t batchSize = 4096)
+    {
+        std::vector<MatterTunnel::RawKeyPair> pairs;
+        std::vector<unsigned char> passcodes;
+        std::vector<DeviceRecord> records;
+
+        for (size_t done = 0; done < count;)
+        {
+            size_t n = std::min(batchSize, count - done);
+            pairs.resize(n);
+            passcodes.resize(n * 16);
+            records.resize(n);
+
+            MatterError error = MatterTunnel::tryGenerateKeyPairs(pairs.data(), n, threads_);
+            if (error == MatterError::Ok && !CryptoBackend::randomBytes(passcodes.data(), passcodes.size()))
+            {
+                error = MatterError::RandomFailure;
+            }
+            if (error != MatterError::Ok)
+            {
+                wipe(pairs, passcodes, records);
+                throwMatterError(error);
+            }
+
+            for (size_t i = 0; i < n; i++)
+            {
+                DeviceRecord &record = records[i];
+                std::memcpy(record.privateKey, pairs[i].privateKey, 32);
+                std::memcpy(record.publicKey, pairs[i].publicKey, 65);
+                std::memcpy(record.passcode, passcodes.data() + i * 16, 16);
+
+                record.deviceData.resize(deviceDataSize());
+                MatterTunnel::compressPublicKey(record.publicKey, record.deviceData.data());
+                std::memcpy(record.deviceData.data() + 33, record.passcode, 16);
+                std::copy(functionBlock_.begin(), functionBlock_.end(), record.deviceData.begin() + 49);
+            }
+
+            sink(records);
+            wipe(pairs, passcodes, records);
+            done += n;
+        }
+    }
+
+    // CSV: device_data,private_key,public_key,passcode (16진수, qr_maker.py 반환 순서)
+    static void writeCSVHeader(std::ostream &out)
+    {
+        out << "device_data,private_key,public_key,passcode\n";
+    }
+
+    static void writeCSV(std::ostream &out, const std::vector<DeviceRecord> &records)
+    {
+        std::string line;
+        for (const auto &record : records)
+        {
+            line.clear();
+            appendHex(line, record.deviceData.data(), record.deviceData.size());
+            line += ',';
+            appendHex(line, record.privateKey, 32);
+            line += ',';
+            appendHex(line, record.publicKey, 65);
+            line += ',';
+            appendHex(line, record.passcode, 16);
+            line += '\n';
+            out.write(line.data(), line.size());
+        }
+        CryptoBackend::cleanse(&line[0], line.size());
+    }
+
+    // 바이너리: 헤더 "MTDP" + version(1) + device data 길이(2, LE) + reserved(1)
+    //           이후 레코드마다 device data + private key(32) + public key(65) + passcode(16)
+    static constexpr unsigned char BINARY_VERSION = 1;
+
+    void writeBinaryHeader(std::ostream &out) const
+    {
+        size_t dataSize = deviceDataSize();
+        unsigned char header[8] = {'M', 'T', 'D', 'P', BINARY_VERSION,
+                                   static_cast<unsigned char>(dataSize & 0xFF),
+                                   static_cast<unsigned char>(dataSize >> 8), 0};
+        out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+
+    static void writeBinary(std::ostream &out, const std::vector<DeviceRecord> &records)
+    {
+        for (const auto &record : records)
+        {
+            out.write(reinterpret_cast<const char *>(record.deviceData.data()), record.deviceData.size());
+            out.write(reinterpret_cast<const char *>(record.privateKey), 32);
+            out.write(reinterpret_cast<const char *>(record.publicKey), 65);
+            out.write(reinterpret_cast<const char *>(record.passcode), 16);
+        }
+    }
+
+private:
+    static uint16_t typeCode(const std::string &type)
+    {
+        if (type == "string")
+            return 0x01;
+        if (type == "number")
+            return 0x02;
+        if (type == "boolean")
+            return 0x03;
+        return 0x00;
+    }
+
+    static bool isWordChar(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    static std::string trim(const std::string &s)
+    {
+        size_t begin = s.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos)
+        {
+            return "";
+        }
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    static void appendHex(std::string &out, const unsigned char *data, size_t len)
+    {
+        static const char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < len; i++)
+        {
+            out += digits[data[i] >> 4];
+            out += digits[data[i] & 0x0f];
+        }
+    }
+
+    static void wipe(std::vector<MatterTunnel::RawKeyPair> &pairs, std::vector<unsigned char> &passcodes,
+                     std::vector<DeviceRecord> &records)
+    {
+        CryptoBackend::cleanse(pairs.data(), pairs.size() * sizeof(MatterTunnel::RawKeyPair));
+        CryptoBackend::cleanse(passcodes.data(), passcodes.size());
+        for (auto &record : records)
+        {
+            CryptoBackend::cleanse(record.privateKey, sizeof(record.privateKey));
+            CryptoBackend::cleanse(record.passcode, sizeof(record.passcode));
+        }
+    }
+
+    unsigned threads_;
+    std::vector<unsigned char> functionBlock_; // 모든 디바이스에 공통인 function 데이터
+};
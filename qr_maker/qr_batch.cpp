@@ -0,0 +1,216 @@
+// 디바이스 QR 코드 일괄 생성 도구
+//
+//   g++ -std=c++17 -O2 -pthread qr_batch.cpp -o qr_batch
+//
+//   ./qr_batch <input> <out_dir> [--format png|pbm] [--ecc L|M|Q|H] [--scale N] [--border N] [--threads N]
+//
+// input은 provision 출력 (바이너리 "MTDP" 또는 CSV). device data만 읽고 개인키는 읽은 즉시 지운다.
+// device data를 바이트 모드로 그대로 담아 디바이스마다 out_dir/device_000000.png 형식으로 저장한다.
+// 버전은 들어가는 가장 작은 것으로, 오류 정정 레벨은 --ecc 이상에서 같은 버전에 들어가는 가장 높은 것으로 정한다.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <filesystem>
+#include <cstring>
+#include "./qr_encoder.cpp"
+
+static int usage()
+{
+    std::cerr << "usage: qr_batch <input> <out_dir> [--format png|pbm] [--ecc L|M|Q|H] [--scale N] [--border N] [--threads N]"
+              << std::endl;
+    return 2;
+}
+
+// provision 바이너리 출력: 헤더(8) + (device data + private key(32) + public key(65) + passcode(16)) * n
+static std::vector<std::vector<unsigned char>> readBinary(std::istream &in)
+{
+    unsigned char header[8];
+    if (!in.read(reinterpret_cast<char *>(header), sizeof(header)) || std::memcmp(header, "MTDP", 4) != 0 ||
+        header[4] != 1)
+    {
+        throw std::runtime_error("Invalid provisioning file header");
+    }
+    size_t dataSize = header[5] | (header[6] << 8);
+
+    std::vector<std::vector<unsigned char>> blobs;
+    std::vector<unsigned char> record(dataSize + 32 + 65 + 16);
+    while (in.read(reinterpret_cast<char *>(record.data()), record.size()))
+    {
+        blobs.emplace_back(record.begin(), record.begin() + dataSize);
+    }
+    std::fill(record.begin(), record.end(), 0);
+    if (in.gcount() != 0)
+    {
+        throw std::runtime_error("Truncated provisioning file");
+    }
+    return blobs;
+}
+
+// provision CSV 출력: 첫 열(device data 16진수)만 사용
+static std::vector<std::vector<unsigned char>> readCSV(std::istream &in)
+{
+    std::vector<std::vector<unsigned char>> blobs;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::string hex = line.substr(0, line.find(','));
+        std::fill(line.begin(), line.end(), '\0');
+        if (hex.empty() || hex == "device_data")
+        {
+            continue;
+        }
+        if (hex.length() % 2 != 0 || hex.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+        {
+            throw std::runtime_error("Invalid device data in CSV");
+        }
+        std::vector<unsigned char> blob(hex.length() / 2);
+        for (size_t i = 0; i < blob.size(); i++)
+        {
+            blob[i] = static_cast<unsigned char>(std::stoi(hex.substr(i * 2, 2), nullptr, 16));
+        }
+        blobs.push_back(std::move(blob));
+    }
+    return blobs;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        return usage();
+    }
+
+    std::string inPath = argv[1];
+    std::filesystem::path outDir = argv[2];
+    std::string format = "png";
+    QrCode::Ecc ecc = QrCode::ECC_L;
+    int scale = 10;
+    int border = 4;
+    unsigned threads = 0;
+
+    try
+    {
+        for (int i = 3; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                return usage();
+            }
+            std::string value = argv[++i];
+            if (arg == "--format")
+                format = value;
+            else if (arg == "--ecc" && value.length() == 1 && std::string("LMQH").find(value[0]) != std::string::npos)
+                ecc = static_cast<QrCode::Ecc>(std::string("LMQH").find(value[0]));
+            else if (arg == "--scale")
+                scale = std::stoi(value);
+            else if (arg == "--border")
+                border = std::stoi(value);
+            else if (arg == "--threads")
+                threads = static_cast<unsigned>(std::stoul(value));
+            else
+                return usage();
+        }
+        if ((format != "png" && format != "pbm") || scale < 1 || border < 0)
+        {
+            return usage();
+        }
+
+        std::ifstream in(inPath, std::ios::binary);
+        if (!in)
+        {
+            throw std::runtime_error("Failed to open input: " + inPath);
+        }
+        char magic[4] = {};
+        in.read(magic, 4);
+        in.clear();
+        in.seekg(0);
+        std::vector<std::vector<unsigned char>> blobs =
+            std::memcmp(magic, "MTDP", 4) == 0 ? readBinary(in) : readCSV(in);
+
+        std::filesystem::create_directories(outDir);
+
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, blobs.size())));
+
+        // 작업 큐 대신 원자적 인덱스로 디바이스를 나눠 가짐
+        auto start = std::chrono::steady_clock::now();
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::mutex errorMutex;
+        std::string error;
+        int maxVersion = 0;
+
+        auto worker = [&]() {
+            int localMax = 0;
+            for (size_t i = next++; i < blobs.size() && !failed; i = next++)
+            {
+                try
+                {
+                    QrCode qr = QrCode::encodeBytes(blobs[i].data(), blobs[i].size(), ecc);
+                    localMax = std::max(localMax, qr.version());
+
+                    std::ostringstream name;
+                    name << "device_" << std::setw(6) << std::setfill('0') << i << "." << format;
+                    std::ofstream file(outDir / name.str(), std::ios::binary);
+                    if (format == "png")
+                    {
+                        std::vector<unsigned char> png = qr.toPNG(scale, border);
+                        file.write(reinterpret_cast<const char *>(png.data()), png.size());
+                    }
+                    else
+                    {
+                        file << qr.toPBM(scale, border);
+                    }
+                    if (!file)
+                    {
+                        throw std::runtime_error("Failed to write " + (outDir / name.str()).string());
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!failed.exchange(true))
+                    {
+                        error = e.what();
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(errorMutex);
+            maxVersion = std::max(maxVersion, localMax);
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; t++)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : pool)
+        {
+            thread.join();
+        }
+        if (failed)
+        {
+            throw std::runtime_error(error);
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cerr << blobs.size() << " QR codes (version <= " << maxVersion << ") in " << elapsed.count()
+                  << " ms" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,789 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+// QR 코드 인코더 (ISO/IEC 18004, 바이트 모드 전용)
+// 디바이스 데이터(extractDeviceInfo 입력 형식)를 변환 없이 그대로 담는다.
+// 가장 작은 버전을 고른 뒤, 같은 버전에 들어가는 한 가장 높은 오류 정정 레벨로 올린다.
+class QrCode
+{
+public:
+    enum Ecc
+    {
+        ECC_L = 0, // 7%
+        ECC_M,     // 15%
+        ECC_Q,     // 25%
+        ECC_H,     // 30%
+    };
+
+    // mask = -1이면 패널티 점수가 가장 낮은 마스크 선택
+    static QrCode encodeBytes(const unsigned char *data, size_t len, Ecc minEcc = ECC_L,
+                              bool boostEcc = true, int mask = -1)
+    {
+        // 1. 버전 선택: 모드(4) + 길이(8/16) + 데이터
+        int version = 0;
+        for (int v = 1; v <= 40; v++)
+        {
+            if (dataBits(v, len) <= numDataCodewords(v, minEcc) * 8)
+            {
+                version = v;
+                break;
+            }
+        }
+        if (version == 0)
+        {
+            throw std::runtime_error("Data too long for QR code");
+        }
+
+        Ecc ecc = minEcc;
+        for (int e = minEcc + 1; boostEcc && e <= ECC_H; e++)
+        {
+            if (dataBits(version, len) <= numDataCodewords(version, static_cast<Ecc>(e)) * 8)
+            {
+                ecc = static_cast<Ecc>(e);
+            }
+        }
+
+        // 2. 데이터 비트열: 모드 0100 + 길이 + 데이터 + 종료 비트 + 패딩
+        size_t capacity = numDataCodewords(version, ecc) * 8;
+        BitBuffer bits;
+        bits.append(0x4, 4);
+        bits.append(static_cast<uint32_t>(len), version <= 9 ? 8 : 16);
+        for (size_t i = 0; i < len; i++)
+        {
+            bits.append(data[i], 8);
+        }
+        bits.append(0, static_cast<int>(std::min<size_t>(4, capacity - bits.size())));
+        bits.append(0, static_cast<int>((8 - bits.size() % 8) % 8));
+        for (uint8_t pad = 0xEC; bits.size() < capacity; pad ^= 0xEC ^ 0x11)
+        {
+            bits.append(pad, 8);
+        }
+
+        std::vector<uint8_t> codewords(bits.size() / 8, 0);
+        for (size_t i = 0; i < bits.size(); i++)
+        {
+            codewords[i >> 3] |= bits.bit(i) << (7 - (i & 7));
+        }
+
+        // 3. 모듈 배치
+        QrCode qr(version, ecc);
+        qr.drawFunctionPatterns();
+        qr.drawCodewords(qr.addEccAndInterleave(codewords));
+
+        if (mask < 0)
+        {
+            long minPenalty = -1;
+            for (int m = 0; m < 8; m++)
+            {
+                qr.applyMask(m);
+                qr.drawFormatBits(m);
+                long penalty = qr.penaltyScore();
+                if (minPenalty < 0 || penalty < minPenalty)
+                {
+                    mask = m;
+                    minPenalty = penalty;
+                }
+                qr.applyMask(m); // XOR이므로 다시 적용하면 원래대로
+            }
+        }
+        if (mask > 7)
+        {
+            throw std::runtime_error("Invalid QR mask");
+        }
+        qr.mask_ = mask;
+        qr.applyMask(mask);
+        qr.drawFormatBits(mask);
+        qr.isFunction_.clear();
+        return qr;
+    }
+
+    static QrCode encodeBytes(const std::vector<unsigned char> &data, Ecc minEcc = ECC_L)
+    {
+        return encodeBytes(data.data(), data.size(), minEcc);
+    }
+
+    int version() const { return version_; }
+    int size() const { return size_; }
+    Ecc ecc() const { return ecc_; }
+    int mask() const { return mask_; }
+
+    // true = 어두운 모듈
+    bool module(int x, int y) const
+    {
+        return x >= 0 && x < size_ && y >= 0 && y < size_ && modules_[y * size_ + x];
+    }
+
+    // PBM (P4, 1비트): 모듈 하나를 scale x scale 픽셀로, 둘레에 border 모듈 여백
+    std::string toPBM(int scale = 4, int border = 4) const
+    {
+        int width = (size_ + border * 2) * scale;
+        std::string out = "P4\n" + std::to_string(width) + " " + std::to_string(width) + "\n";
+        std::vector<uint8_t> row((width + 7) / 8);
+        for (int y = 0; y < width; y++)
+        {
+            packRow(row, y, scale, border, true);
+            out.append(row.begin(), row.end());
+        }
+        return out;
+    }
+
+    // PNG (1비트 그레이스케일)
+    // 같은 행이 scale번 반복되므로 Up 필터 + 고정 허프만 deflate(거리 1 반복)로 작게 압축한다.
+    std::vector<unsigned char> toPNG(int scale = 4, int border = 4) const
+    {
+        int width = (size_ + border * 2) * scale;
+        size_t stride = (width + 7) / 8;
+
+        std::vector<uint8_t> raw;
+        raw.reserve((stride + 1) * width);
+        std::vector<uint8_t> row(stride), prev(stride, 0);
+        for (int y = 0; y < width; y++)
+        {
+            packRow(row, y, scale, border, false);
+            raw.push_back(2); // Up 필터
+            for (size_t i = 0; i < stride; i++)
+            {
+                raw.push_back(static_cast<uint8_t>(row[i] - prev[i]));
+            }
+            prev.swap(row);
+        }
+
+        std::vector<unsigned char> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        std::vector<uint8_t> ihdr;
+        appendBE32(ihdr, static_cast<uint32_t>(width));
+        appendBE32(ihdr, static_cast<uint32_t>(width));
+        ihdr.insert(ihdr.end(), {1, 0, 0, 0, 0}); // bit depth 1, grayscale, deflate, 필터 0, 인터레이스 없음
+        appendChunk(png, "IHDR", ihdr);
+        appendChunk(png, "IDAT", zlibCompress(raw));
+        appendChunk(png, "IEND", {});
+        return png;
+    }
+
+private:
+    QrCode(int version, Ecc ecc)
+        : version_(version), size_(version * 4 + 17), ecc_(ecc), mask_(0),
+          modules_(size_ * size_, false), isFunction_(size_ * size_, false)
+    {
+    }
+
+    struct BitBuffer
+    {
+        std::vector<bool> bits;
+
+        void append(uint32_t value, int count)
+        {
+            for (int i = count - 1; i >= 0; i--)
+            {
+                bits.push_back((value >> i) & 1);
+            }
+        }
+        size_t size() const { return bits.size(); }
+        uint8_t bit(size_t i) const { return bits[i] ? 1 : 0; }
+    };
+
+    // ---- 표 (인덱스: [ecc][version]) ----
+    static int eccCodewordsPerBlock(Ecc ecc, int version)
+    {
+        static const int8_t table[4][41] = {
+            {-1, 7, 10, 15, 20, 26, 18, 20, 24, 30, 18, 20, 24, 26, 30, 22, 24, 28, 30, 28, 28, 28, 28, 30, 30, 26, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+            {-1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26, 30, 22, 22, 24, 24, 28, 28, 26, 26, 26, 26, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28},
+            {-1, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24, 28, 26, 24, 20, 30, 24, 28, 28, 26, 30, 28, 30, 30, 30, 30, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+            {-1, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28, 24, 28, 22, 24, 24, 30, 28, 28, 26, 28, 30, 24, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+        };
+        return table[ecc][version];
+    }
+
+    static int numEccBlocks(Ecc ecc, int version)
+    {
+        static const int8_t table[4][41] = {
+            {-1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4, 4, 4, 4, 4, 6, 6, 6, 6, 7, 8, 8, 9, 9, 10, 12, 12, 12, 13, 14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 24, 25},
+            {-1, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5, 5, 8, 9, 9, 10, 10, 11, 13, 14, 16, 17, 17, 18, 20, 21, 23, 25, 26, 28, 29, 31, 33, 35, 37, 38, 40, 43, 45, 47, 49},
+            {-1, 1, 1, 2, 2, 4, 4, 6, 6, 8, 8, 8, 10, 12, 16, 12, 17, 16, 18, 21, 20, 23, 23, 25, 27, 29, 34, 34, 35, 38, 40, 43, 45, 48, 51, 53, 56, 59, 62, 65, 68},
+            {-1, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81},
+        };
+        return table[ecc][version];
+    }
+
+    // 형식 정보의 ECC 비트 (L=01, M=00, Q=11, H=10)
+    static int formatBits(Ecc ecc)
+    {
+        static const int bits[4] = {1, 0, 3, 2};
+        return bits[ecc];
+    }
+
+    // 길이 필드(버전 1~9: 8비트, 10~40: 16비트)에 담기지 않으면 SIZE_MAX
+    static size_t dataBits(int version, size_t len)
+    {
+        int countBits = version <= 9 ? 8 : 16;
+        if (len >> countBits != 0)
+        {
+            return SIZE_MAX;
+        }
+        return 4 + countBits + len * 8;
+    }
+
+    // 기능 패턴을 제외한 데이터 모듈 수
+    static int numRawDataModules(int version)
+    {
+        int result = (16 * version + 128) * version + 64;
+        if (version >= 2)
+        {
+            int numAlign = version / 7 + 2;
+            result -= (25 * numAlign - 10) * numAlign - 55;
+            if (version >= 7)
+            {
+                result -= 36;
+            }
+        }
+        return result;
+    }
+
+    static size_t numDataCodewords(int version, Ecc ecc)
+    {
+        return numRawDataModules(version) / 8 - eccCodewordsPerBlock(ecc, version) * numEccBlocks(ecc, version);
+    }
+
+    // ---- 기능 패턴 ----
+    void setFunction(int x, int y, bool dark)
+    {
+        modules_[y * size_ + x] = dark;
+        isFunction_[y * size_ + x] = true;
+    }
+
+    void drawFunctionPatterns()
+    {
+        // 타이밍 패턴
+        for (int i = 0; i < size_; i++)
+        {
+            setFunction(6, i, i % 2 == 0);
+            setFunction(i, 6, i % 2 == 0);
+        }
+
+        // 파인더 패턴 (세 모서리, 구분자 포함)
+        drawFinder(3, 3);
+        drawFinder(size_ - 4, 3);
+        drawFinder(3, size_ - 4);
+
+        // 정렬 패턴 (파인더와 겹치는 세 모서리 제외)
+        std::vector<int> positions = alignmentPositions();
+        size_t n = positions.size();
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                if (!((i == 0 && j == 0) || (i == 0 && j == n - 1) || (i == n - 1 && j == 0)))
+                {
+                    drawAlignment(positions[i], positions[j]);
+                }
+            }
+        }
+
+        drawFormatBits(0); // 자리만 확보, 마스크 선택 후 다시 기록
+        drawVersion();
+    }
+
+    void drawFinder(int x, int y)
+    {
+        for (int dy = -4; dy <= 4; dy++)
+        {
+            for (int dx = -4; dx <= 4; dx++)
+            {
+                int dist = std::max(std::abs(dx), std::abs(dy));
+                int xx = x + dx, yy = y + dy;
+                if (xx >= 0 && xx < size_ && yy >= 0 && yy < size_)
+                {
+                    setFunction(xx, yy, dist != 2 && dist != 4);
+                }
+            }
+        }
+    }
+
+    void drawAlignment(int x, int y)
+    {
+        for (int dy = -2; dy <= 2; dy++)
+        {
+            for (int dx = -2; dx <= 2; dx++)
+            {
+                setFunction(x + dx, y + dy, std::max(std::abs(dx), std::abs(dy)) != 1);
+            }
+        }
+    }
+
+    std::vector<int> alignmentPositions() const
+    {
+        if (version_ == 1)
+        {
+            return {};
+        }
+        int numAlign = version_ / 7 + 2;
+        int step = (version_ * 8 + numAlign * 3 + 5) / (numAlign * 4 - 4) * 2;
+        std::vector<int> result;
+        for (int i = 0, pos = size_ - 7; i < numAlign - 1; i++, pos -= step)
+        {
+            result.insert(result.begin(), pos);
+        }
+        result.insert(result.begin(), 6);
+        return result;
+    }
+
+    // 형식 정보 15비트 (BCH(15,5) + 마스크 0x5412), 두 벌 기록
+    void drawFormatBits(int mask)
+    {
+        int data = formatBits(ecc_) << 3 | mask;
+        int rem = data;
+        for (int i = 0; i < 10; i++)
+        {
+            rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+        }
+        int bits = (data << 10 | rem) ^ 0x5412;
+
+        for (int i = 0; i <= 5; i++)
+        {
+            setFunction(8, i, (bits >> i) & 1);
+        }
+        setFunction(8, 7, (bits >> 6) & 1);
+        setFunction(8, 8, (bits >> 7) & 1);
+        setFunction(7, 8, (bits >> 8) & 1);
+        for (int i = 9; i < 15; i++)
+        {
+            setFunction(14 - i, 8, (bits >> i) & 1);
+        }
+
+        for (int i = 0; i < 8; i++)
+        {
+            setFunction(size_ - 1 - i, 8, (bits >> i) & 1);
+        }
+        for (int i = 8; i < 15; i++)
+        {
+            setFunction(8, size_ - 15 + i, (bits >> i) & 1);
+        }
+        setFunction(8, size_ - 8, true); // 항상 어두운 모듈
+    }
+
+    // 버전 정보 18비트 (버전 7 이상, BCH(18,6))
+    void drawVersion()
+    {
+        if (version_ < 7)
+        {
+            return;
+        }
+        int rem = version_;
+        for (int i = 0; i < 12; i++)
+        {
+            rem = (rem << 1) ^ ((rem >> 11) * 0x1F25);
+        }
+        long bits = static_cast<long>(version_) << 12 | rem;
+        for (int i = 0; i < 18; i++)
+        {
+            bool bit = (bits >> i) & 1;
+            int a = size_ - 11 + i % 3;
+            int b = i / 3;
+            setFunction(a, b, bit);
+            setFunction(b, a, bit);
+        }
+    }
+
+    // ---- 데이터 ----
+    // 블록별 Reed-Solomon ECC 추가 후 인터리빙
+    std::vector<uint8_t> addEccAndInterleave(const std::vector<uint8_t> &data) const
+    {
+        int numBlocks = numEccBlocks(ecc_, version_);
+        int blockEccLen = eccCodewordsPerBlock(ecc_, version_);
+        int rawCodewords = numRawDataModules(version_) / 8;
+        int numShortBlocks = numBlocks - rawCodewords % numBlocks;
+        int shortBlockLen = rawCodewords / numBlocks;
+
+        std::vector<uint8_t> divisor = reedSolomonDivisor(blockEccLen);
+        std::vector<std::vector<uint8_t>> blocks;
+        for (int i = 0, k = 0; i < numBlocks; i++)
+        {
+            int datLen = shortBlockLen - blockEccLen + (i < numShortBlocks ? 0 : 1);
+            std::vector<uint8_t> block(data.begin() + k, data.begin() + k + datLen);
+            k += datLen;
+            std::vector<uint8_t> ecc = reedSolomonRemainder(block, divisor);
+            if (i < numShortBlocks)
+            {
+                block.push_back(0); // 짧은 블록 자리 맞춤 (인터리빙 시 건너뜀)
+            }
+            block.insert(block.end(), ecc.begin(), ecc.end());
+            blocks.push_back(std::move(block));
+        }
+
+        std::vector<uint8_t> result;
+        result.reserve(rawCodewords);
+        for (size_t i = 0; i < blocks[0].size(); i++)
+        {
+            for (size_t j = 0; j < blocks.size(); j++)
+            {
+                if (i != static_cast<size_t>(shortBlockLen - blockEccLen) || j >= static_cast<size_t>(numShortBlocks))
+                {
+                    result.push_back(blocks[j][i]);
+                }
+            }
+        }
+        return result;
+    }
+
+    // 지그재그 배치 (오른쪽 아래부터 두 열씩, 세로 타이밍 열 건너뜀)
+    void drawCodewords(const std::vector<uint8_t> &data)
+    {
+        size_t i = 0;
+        for (int right = size_ - 1; right >= 1; right -= 2)
+        {
+            if (right == 6)
+            {
+                right = 5;
+            }
+            for (int vert = 0; vert < size_; vert++)
+            {
+                for (int j = 0; j < 2; j++)
+                {
+                    int x = right - j;
+                    bool upward = ((right + 1) & 2) == 0;
+                    int y = upward ? size_ - 1 - vert : vert;
+                    if (!isFunction_[y * size_ + x] && i < data.size() * 8)
+                    {
+                        modules_[y * size_ + x] = (data[i >> 3] >> (7 - (i & 7))) & 1;
+                        i++;
+                    }
+                }
+            }
+        }
+    }
+
+    void applyMask(int mask)
+    {
+        for (int y = 0; y < size_; y++)
+        {
+            for (int x = 0; x < size_; x++)
+            {
+                bool invert;
+                switch (mask)
+                {
+                case 0: invert = (x + y) % 2 == 0; break;
+                case 1: invert = y % 2 == 0; break;
+                case 2: invert = x % 3 == 0; break;
+                case 3: invert = (x + y) % 3 == 0; break;
+                case 4: invert = (x / 3 + y / 2) % 2 == 0; break;
+                case 5: invert = x * y % 2 + x * y % 3 == 0; break;
+                case 6: invert = (x * y % 2 + x * y % 3) % 2 == 0; break;
+                default: invert = ((x + y) % 2 + x * y % 3) % 2 == 0; break;
+                }
+                if (invert && !isFunction_[y * size_ + x])
+                {
+                    modules_[y * size_ + x] = !modules_[y * size_ + x];
+                }
+            }
+        }
+    }
+
+    // ---- 마스크 패널티 (N1=3, N2=3, N3=40, N4=10) ----
+    long penaltyScore() const
+    {
+        long result = 0;
+
+        // 같은 색 연속(5개 이상)과 1:1:3:1:1 파인더 유사 패턴 (행, 열)
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (int a = 0; a < size_; a++)
+            {
+                bool runColor = false;
+                int run = 0;
+                std::array<int, 7> history = {};
+                for (int b = 0; b < size_; b++)
+                {
+                    bool color = pass == 0 ? module(b, a) : module(a, b);
+                    if (color == runColor)
+                    {
+                        run++;
+                        if (run == 5)
+                            result += 3;
+                        else if (run > 5)
+                            result++;
+                    }
+                    else
+                    {
+                        addHistory(run, history);
+                        if (!runColor)
+                        {
+                            result += finderPatterns(history) * 40;
+                        }
+                        runColor = color;
+                        run = 1;
+                    }
+                }
+                if (runColor)
+                {
+                    addHistory(run, history);
+                    run = 0;
+                }
+                addHistory(run + size_, history); // 오른쪽 여백
+                result += finderPatterns(history) * 40;
+            }
+        }
+
+        // 2x2 같은 색 블록
+        for (int y = 0; y < size_ - 1; y++)
+        {
+            for (int x = 0; x < size_ - 1; x++)
+            {
+                bool color = module(x, y);
+                if (color == module(x + 1, y) && color == module(x, y + 1) && color == module(x + 1, y + 1))
+                {
+                    result += 3;
+                }
+            }
+        }
+
+        // 어두운 모듈 비율이 50%에서 5% 벗어날 때마다
+        long dark = std::count(modules_.begin(), modules_.end(), true);
+        long total = static_cast<long>(size_) * size_;
+        long k = (std::labs(dark * 20 - total * 10) + total - 1) / total - 1;
+        result += k * 10;
+        return result;
+    }
+
+    void addHistory(int run, std::array<int, 7> &history) const
+    {
+        if (history[0] == 0)
+        {
+            run += size_; // 왼쪽 여백
+        }
+        std::copy_backward(history.begin(), history.end() - 1, history.end());
+        history[0] = run;
+    }
+
+    static int finderPatterns(const std::array<int, 7> &h)
+    {
+        int n = h[1];
+        bool core = n > 0 && h[2] == n && h[3] == n * 3 && h[4] == n && h[5] == n;
+        return (core && h[0] >= n * 4 && h[6] >= n ? 1 : 0) + (core && h[6] >= n * 4 && h[0] >= n ? 1 : 0);
+    }
+
+    // ---- Reed-Solomon (GF(2^8), 다항식 0x11D) ----
+    static uint8_t gfMultiply(uint8_t x, uint8_t y)
+    {
+        int z = 0;
+        for (int i = 7; i >= 0; i--)
+        {
+            z = (z << 1) ^ ((z >> 7) * 0x11D);
+            z ^= ((y >> i) & 1) * x;
+        }
+        return static_cast<uint8_t>(z);
+    }
+
+    static std::vector<uint8_t> reedSolomonDivisor(int degree)
+    {
+        std::vector<uint8_t> result(degree, 0);
+        result[degree - 1] = 1;
+        uint8_t root = 1;
+        for (int i = 0; i < degree; i++)
+        {
+            for (int j = 0; j < degree; j++)
+            {
+                result[j] = gfMultiply(result[j], root);
+                if (j + 1 < degree)
+                {
+                    result[j] ^= result[j + 1];
+                }
+            }
+            root = gfMultiply(root, 0x02);
+        }
+        return result;
+    }
+
+    static std::vector<uint8_t> reedSolomonRemainder(const std::vector<uint8_t> &data,
+                                                     const std::vector<uint8_t> &divisor)
+    {
+        std::vector<uint8_t> result(divisor.size(), 0);
+        for (uint8_t b : data)
+        {
+            uint8_t factor = b ^ result[0];
+            result.erase(result.begin());
+            result.push_back(0);
+            for (size_t i = 0; i < result.size(); i++)
+            {
+                result[i] ^= gfMultiply(divisor[i], factor);
+            }
+        }
+        return result;
+    }
+
+    // ---- 이미지 출력 ----
+    // 픽셀 행 y를 1비트로 (darkIsOne: PBM은 1 = 검정, PNG 그레이스케일은 1 = 흰색)
+    void packRow(std::vector<uint8_t> &row, int y, int scale, int border, bool darkIsOne) const
+    {
+        std::fill(row.begin(), row.end(), darkIsOne ? 0x00 : 0xFF);
+        int my = y / scale - border;
+        int width = (size_ + border * 2) * scale;
+        for (int x = 0; x < width; x++)
+        {
+            if (module(x / scale - border, my))
+            {
+                row[x >> 3] ^= static_cast<uint8_t>(0x80 >> (x & 7));
+            }
+        }
+        if (!darkIsOne && width % 8 != 0)
+        {
+            row.back() &= static_cast<uint8_t>(0xFF << (8 - width % 8)); // 남는 비트는 0
+        }
+    }
+
+    static void appendBE32(std::vector<uint8_t> &out, uint32_t v)
+    {
+        out.insert(out.end(), {static_cast<uint8_t>(v >> 24), static_cast<uint8_t>(v >> 16),
+                               static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v)});
+    }
+
+    static uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0)
+    {
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++)
+                {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                t[n] = c;
+            }
+            return t;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < len; i++)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    static void appendChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data)
+    {
+        appendBE32(png, static_cast<uint32_t>(data.size()));
+        size_t start = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data.begin(), data.end());
+        appendBE32(png, crc32(png.data() + start, png.size() - start));
+    }
+
+    // LSB 우선 비트 출력 (deflate)
+    struct DeflateWriter
+    {
+        std::vector<uint8_t> out;
+        uint32_t acc = 0;
+        int count = 0;
+
+        void bits(uint32_t value, int n)
+        {
+            acc |= value << count;
+            count += n;
+            while (count >= 8)
+            {
+                out.push_back(static_cast<uint8_t>(acc));
+                acc >>= 8;
+                count -= 8;
+            }
+        }
+
+        // 허프만 코드는 MSB부터
+        void code(uint32_t value, int n)
+        {
+            uint32_t reversed = 0;
+            for (int i = 0; i < n; i++)
+            {
+                reversed = (reversed << 1) | ((value >> i) & 1);
+            }
+            bits(reversed, n);
+        }
+
+        void literal(int v)
+        {
+            if (v < 144)
+                code(0x30 + v, 8);
+            else if (v < 256)
+                code(0x190 + v - 144, 9);
+            else if (v < 280)
+                code(v - 256, 7);
+            else
+                code(0xC0 + v - 280, 8);
+        }
+
+        void flush()
+        {
+            if (count > 0)
+            {
+                out.push_back(static_cast<uint8_t>(acc));
+                acc = 0;
+                count = 0;
+            }
+        }
+    };
+
+    // zlib 스트림: 고정 허프만 블록 하나, 직전 바이트 반복만 거리 1 매치로 부호화
+    static std::vector<uint8_t> zlibCompress(const std::vector<uint8_t> &data)
+    {
+        static const int lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                           35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const int lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+        DeflateWriter w;
+        w.out = {0x78, 0x01};
+        w.bits(1, 1); // BFINAL
+        w.bits(1, 2); // BTYPE = 고정 허프만
+
+        size_t i = 0;
+        while (i < data.size())
+        {
+            size_t run = 0;
+            if (i > 0)
+            {
+                while (i + run < data.size() && run < 258 && data[i + run] == data[i - 1])
+                {
+                    run++;
+                }
+            }
+            if (run < 3)
+            {
+                w.literal(data[i++]);
+                continue;
+            }
+
+            int code = 28;
+            while (lengthBase[code] > static_cast<int>(run))
+            {
+                code--;
+            }
+            w.literal(257 + code);
+            w.bits(static_cast<uint32_t>(run - lengthBase[code]), lengthExtra[code]);
+            w.code(0, 5); // 거리 1
+            i += run;
+        }
+        w.literal(256); // 블록 끝
+        w.flush();
+
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : data)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        appendBE32(w.out, (b << 16) | a);
+        return w.out;
+    }
+
+    int version_;
+    int size_;
+    Ecc ecc_;
+    int mask_;
+    std::vector<bool> modules_;
+    std::vector<bool> isFunction_; // 인코딩 중에만 사용
+};
@@ -128,9 +128,6 @@ def main(function_list: List[str]):
     # Print device data for verification
     print(f"\nDevice Data (hex): {device_data}")
     
-    # Convert binary data to text for QR code
-    device_data_text = device_data.decode('latin-1', errors='ignore')
-    
     # Generate QR code
     qr = qrcode.QRCode(
         version=None,
@@ -139,7 +136,8 @@ def main(function_list: List[str]):
         border=4,
     )
     
-    qr.add_data(device_data_text)
+    # Pass raw bytes (byte mode); a str would be re-encoded as UTF-8
+    qr.add_data(device_data)
     qr.make(fit=True)
     
     # Save QR code image